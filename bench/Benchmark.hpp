@@ -0,0 +1,107 @@
+/**
+ * @file Benchmark.hpp
+ * @author TL044CN
+ * @brief Minimal Benchmark Harness for SocketSparrow
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "Endpoint.hpp"
+#include "Socket.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+
+namespace SocketSparrow::Bench {
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Outcome of one benchmark run
+     */
+    struct Result {
+        std::string name;
+        std::map<std::string, std::string> params;
+        std::map<std::string, double> metrics;
+    };
+
+    /**
+     * @brief Settings shared by all benchmarks
+     */
+    struct Config {
+        bool quick = false;     ///< run a fraction of the iterations, e.g. for CI smoke runs
+
+        /**
+         * @brief scale an iteration count down in quick mode
+         */
+        size_t scale(size_t iterations) const {
+            return quick ? std::max<size_t>(iterations / 16, 1) : iterations;
+        }
+    };
+
+    using Benchmark = std::function<void(const Config& config, std::vector<Result>& results)>;
+
+    /**
+     * @brief Seconds elapsed since start
+     */
+    inline double secondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    /**
+     * @brief Get the Endpoint a Socket was bound to (e.g. after binding port 0)
+     */
+    inline Endpoint localEndpoint(const Socket& socket) {
+        sockaddr_storage address;
+        socklen_t size = sizeof(address);
+        getsockname(socket.getNativeHandle(), reinterpret_cast<sockaddr*>(&address), &size);
+        return Endpoint(address, size);
+    }
+
+    /**
+     * @brief Add p50/p99/p999/mean (in microseconds) of nanosecond samples to a Result
+     */
+    inline void addPercentiles(Result& result, std::vector<int64_t> samples) {
+        if ( samples.empty() ) {
+            return;
+        }
+        std::sort(samples.begin(), samples.end());
+        auto percentile = [&samples](double p) {
+            size_t index = static_cast<size_t>(p * (samples.size() - 1));
+            return samples[index] / 1000.0;
+        };
+
+        double sum = 0;
+        for ( int64_t sample : samples ) {
+            sum += sample;
+        }
+        result.metrics["p50_us"] = percentile(0.50);
+        result.metrics["p99_us"] = percentile(0.99);
+        result.metrics["p999_us"] = percentile(0.999);
+        result.metrics["max_us"] = samples.back() / 1000.0;
+        result.metrics["mean_us"] = sum / samples.size() / 1000.0;
+    }
+
+    /**
+     * @brief Write all Results as a JSON document
+     */
+    void writeJson(std::ostream& out, const std::vector<Result>& results);
+
+    void benchTcp(const Config& config, std::vector<Result>& results);
+    void benchUdp(const Config& config, std::vector<Result>& results);
+    void benchEndpoint(const Config& config, std::vector<Result>& results);
+
+} // namespace SocketSparrow::Bench
@@ -0,0 +1,79 @@
+#include "Benchmark.hpp"
+
+#include <cstring>
+#include <string>
+
+#include <arpa/inet.h>
+
+using namespace SocketSparrow;
+using namespace SocketSparrow::Bench;
+
+namespace {
+
+/**
+ * @brief Keep the optimizer from discarding a value
+ */
+template<typename T>
+void keep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+template<typename Function>
+void measure(std::vector<Result>& results, const std::string& operation, size_t iterations, Function function) {
+    auto start = Clock::now();
+    for ( size_t i = 0; i < iterations; i++ ) {
+        function(i);
+    }
+    double seconds = secondsSince(start);
+
+    Result result;
+    result.name = "endpoint";
+    result.params["operation"] = operation;
+    result.params["iterations"] = std::to_string(iterations);
+    result.metrics["ns_per_op"] = seconds * 1e9 / iterations;
+    result.metrics["ops_per_second"] = iterations / seconds;
+    results.push_back(std::move(result));
+}
+
+} // namespace
+
+void SocketSparrow::Bench::benchEndpoint(const Config& config, std::vector<Result>& results) {
+    const size_t iterations = config.scale(1000000);
+    const std::string ipv4 = "192.168.1.20";
+    const std::string ipv6 = "fd00::1:20";
+
+    measure(results, "from_ipv4_string", iterations, [&](size_t i) {
+        Endpoint endpoint(ipv4, static_cast<uint16_t>(i));
+        keep(endpoint);
+    });
+    measure(results, "from_ipv6_string", iterations, [&](size_t i) {
+        Endpoint endpoint(ipv6, static_cast<uint16_t>(i), AddressFamily::IPv6);
+        keep(endpoint);
+    });
+    measure(results, "from_in_addr", iterations, [&](size_t i) {
+        Endpoint endpoint(htonl(0xc0a80114), static_cast<uint16_t>(i));
+        keep(endpoint);
+    });
+
+    sockaddr_storage storage;
+    socklen_t size = Endpoint(ipv6, 443, AddressFamily::IPv6).c_size();
+    std::memcpy(&storage, Endpoint(ipv6, 443, AddressFamily::IPv6).c_addr(), size);
+    measure(results, "from_sockaddr", iterations, [&](size_t) {
+        Endpoint endpoint(storage, size);
+        keep(endpoint);
+    });
+
+    Endpoint source(ipv6, 443, AddressFamily::IPv6);
+    measure(results, "copy", iterations, [&](size_t) {
+        Endpoint copy = source;
+        keep(copy);
+    });
+    measure(results, "to_string", iterations, [&](size_t) {
+        std::string text = source.toString();
+        keep(text);
+    });
+    measure(results, "hash", iterations, [&](size_t) {
+        size_t hash = source.hash();
+        keep(hash);
+    });
+}
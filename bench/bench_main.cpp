@@ -0,0 +1,110 @@
+#include "Benchmark.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+
+using namespace SocketSparrow::Bench;
+
+namespace {
+
+void writeString(std::ostream& out, const std::string& value) {
+    out << '"';
+    for ( char c : value ) {
+        switch ( c ) {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        default: out << c; break;
+        }
+    }
+    out << '"';
+}
+
+void usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--quick] [--filter <name>] [--output <file>]\n"
+              << "  --quick          run a fraction of the iterations\n"
+              << "  --filter <name>  only run benchmark groups containing <name> (tcp, udp, endpoint)\n"
+              << "  --output <file>  write the JSON results to <file> instead of stdout\n";
+}
+
+} // namespace
+
+void SocketSparrow::Bench::writeJson(std::ostream& out, const std::vector<Result>& results) {
+    out << std::setprecision(10);
+    out << "{\n  \"benchmarks\": [";
+    for ( size_t i = 0; i < results.size(); i++ ) {
+        const Result& result = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+        writeString(out, result.name);
+
+        out << ", \"params\": {";
+        bool first = true;
+        for ( const auto& [key, value] : result.params ) {
+            out << (first ? "" : ", ");
+            writeString(out, key);
+            out << ": ";
+            writeString(out, value);
+            first = false;
+        }
+
+        out << "}, \"metrics\": {";
+        first = true;
+        for ( const auto& [key, value] : result.metrics ) {
+            out << (first ? "" : ", ");
+            writeString(out, key);
+            out << ": " << value;
+            first = false;
+        }
+        out << "}}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+int main(int argc, char** argv) {
+    Config config;
+    std::string filter;
+    std::string output;
+
+    for ( int i = 1; i < argc; i++ ) {
+        if ( std::strcmp(argv[i], "--quick") == 0 ) {
+            config.quick = true;
+        } else if ( std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc ) {
+            filter = argv[++i];
+        } else if ( std::strcmp(argv[i], "--output") == 0 && i + 1 < argc ) {
+            output = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    const std::pair<const char*, Benchmark> groups[] = {
+        { "tcp", benchTcp },
+        { "udp", benchUdp },
+        { "endpoint", benchEndpoint },
+    };
+
+    std::vector<Result> results;
+    for ( const auto& [name, benchmark] : groups ) {
+        if ( !filter.empty() && std::string(name).find(filter) == std::string::npos ) {
+            continue;
+        }
+        std::cerr << "running " << name << " benchmarks\n";
+        benchmark(config, results);
+    }
+
+    if ( output.empty() ) {
+        writeJson(std::cout, results);
+    } else {
+        std::ofstream file(output);
+        if ( !file ) {
+            std::cerr << "cannot open " << output << "\n";
+            return 1;
+        }
+        writeJson(file, results);
+    }
+    return 0;
+}
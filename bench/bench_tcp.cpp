@@ -0,0 +1,180 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+using namespace SocketSparrow;
+using namespace SocketSparrow::Bench;
+
+namespace {
+
+/**
+ * @brief A connected pair of TCP Sockets over loopback
+ */
+struct Connection {
+    std::shared_ptr<Socket> client;
+    std::shared_ptr<Socket> server;
+};
+
+Connection connectLoopback(bool noDelay) {
+    Socket listener(AddressFamily::IPv4, SocketType::TCP);
+    listener.bind(Endpoint("127.0.0.1", 0));
+    listener.listen(1);
+
+    auto client = std::make_shared<Socket>(AddressFamily::IPv4, SocketType::TCP);
+    client->connect(localEndpoint(listener));
+    std::shared_ptr<Socket> server = listener.accept();
+
+    if ( noDelay ) {
+        int opt = 1;
+        setsockopt(client->getNativeHandle(), IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+        setsockopt(server->getNativeHandle(), IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+    }
+    return { client, server };
+}
+
+/**
+ * @brief A connected pair of Unix Domain stream Sockets, the local IPC baseline
+ */
+Connection connectUnix() {
+    auto [client, server] = Socket::pair(SocketType::Stream);
+    return { std::make_shared<Socket>(std::move(client)), std::make_shared<Socket>(std::move(server)) };
+}
+
+void benchThroughput(const Config& config, std::vector<Result>& results, size_t bufferSize, bool unixDomain) {
+    Connection connection = unixDomain ? connectUnix() : connectLoopback(false);
+    // small buffers are bounded by the number of calls rather than the byte count
+    const size_t totalBytes = std::min(bufferSize * config.scale(500000), config.scale(size_t(1) << 30));
+
+    std::thread receiver([&connection, bufferSize, totalBytes] {
+        std::vector<std::byte> buffer(bufferSize);
+        size_t received = 0;
+        while ( received < totalBytes ) {
+            ssize_t count = connection.server->recv(buffer);
+            if ( count <= 0 ) {
+                break;
+            }
+            received += count;
+        }
+    });
+
+    std::vector<std::byte> buffer(bufferSize, std::byte{ 0x5a });
+    auto start = Clock::now();
+    size_t sent = 0;
+    while ( sent < totalBytes ) {
+        size_t chunk = std::min(bufferSize, totalBytes - sent);
+        sent += connection.client->send(std::span<const std::byte>(buffer.data(), chunk));
+    }
+    receiver.join();
+    double seconds = secondsSince(start);
+
+    Result result;
+    result.name = unixDomain ? "unix_throughput" : "tcp_throughput";
+    result.params["buffer_size"] = std::to_string(bufferSize);
+    result.metrics["bytes"] = static_cast<double>(sent);
+    result.metrics["seconds"] = seconds;
+    result.metrics["mib_per_second"] = sent / seconds / (1024.0 * 1024.0);
+    result.metrics["calls_per_second"] = (sent / bufferSize) / seconds;
+    results.push_back(std::move(result));
+}
+
+void benchPingPong(const Config& config, std::vector<Result>& results) {
+    constexpr size_t messageSize = 64;
+    Connection connection = connectLoopback(true);
+    const size_t iterations = config.scale(100000);
+
+    std::thread echo([&connection, iterations] {
+        std::vector<std::byte> buffer(messageSize);
+        for ( size_t i = 0; i < iterations; i++ ) {
+            size_t received = 0;
+            while ( received < messageSize ) {
+                ssize_t count = connection.server->recv(std::span(buffer).subspan(received));
+                if ( count <= 0 ) {
+                    return;
+                }
+                received += count;
+            }
+            connection.server->send(std::span<const std::byte>(buffer));
+        }
+    });
+
+    std::vector<std::byte> buffer(messageSize, std::byte{ 0x5a });
+    std::vector<int64_t> samples;
+    samples.reserve(iterations);
+    auto start = Clock::now();
+    for ( size_t i = 0; i < iterations; i++ ) {
+        auto sent = Clock::now();
+        connection.client->send(std::span<const std::byte>(buffer));
+        size_t received = 0;
+        while ( received < messageSize ) {
+            ssize_t count = connection.client->recv(std::span(buffer).subspan(received));
+            if ( count <= 0 ) {
+                break;
+            }
+            received += count;
+        }
+        samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - sent).count());
+    }
+    double seconds = secondsSince(start);
+    echo.join();
+
+    Result result;
+    result.name = "tcp_ping_pong";
+    result.params["message_size"] = std::to_string(messageSize);
+    result.params["iterations"] = std::to_string(iterations);
+    result.metrics["round_trips_per_second"] = iterations / seconds;
+    addPercentiles(result, std::move(samples));
+    results.push_back(std::move(result));
+}
+
+void benchAccept(const Config& config, std::vector<Result>& results) {
+    Socket listener(AddressFamily::IPv4, SocketType::TCP);
+    listener.enableAddressReuse(true);
+    listener.bind(Endpoint("127.0.0.1", 0));
+    listener.listen(128);
+    Endpoint endpoint = localEndpoint(listener);
+    const size_t connections = config.scale(2000);
+
+    std::thread connector([&endpoint, connections] {
+        for ( size_t i = 0; i < connections; i++ ) {
+            Socket client(AddressFamily::IPv4, SocketType::TCP);
+            client.connect(endpoint);
+        }
+    });
+
+    std::vector<int64_t> samples;
+    samples.reserve(connections);
+    auto start = Clock::now();
+    for ( size_t i = 0; i < connections; i++ ) {
+        auto before = Clock::now();
+        std::shared_ptr<Socket> accepted = listener.accept();
+        samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - before).count());
+    }
+    double seconds = secondsSince(start);
+    connector.join();
+
+    Result result;
+    result.name = "tcp_accept";
+    result.params["connections"] = std::to_string(connections);
+    result.metrics["accepts_per_second"] = connections / seconds;
+    addPercentiles(result, std::move(samples));
+    results.push_back(std::move(result));
+}
+
+} // namespace
+
+void SocketSparrow::Bench::benchTcp(const Config& config, std::vector<Result>& results) {
+    for ( size_t bufferSize : { 64, 1024, 16 * 1024, 64 * 1024 } ) {
+        benchThroughput(config, results, bufferSize, false);
+        benchThroughput(config, results, bufferSize, true);
+    }
+    benchPingPong(config, results);
+    benchAccept(config, results);
+}
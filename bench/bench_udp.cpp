@@ -0,0 +1,195 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <span>
+#include <string>
+#include <thread>
+
+#include <poll.h>
+
+using namespace SocketSparrow;
+using namespace SocketSparrow::Bench;
+
+namespace {
+
+// kernel overhead charged to the receive buffer per datagram on top of its payload, roughly
+constexpr size_t DatagramOverhead = 1024;
+
+/**
+ * @brief   Enlarge the receive buffer (up to net.core.rmem_max) and get the sender's credit
+ * @details The sender may only be this many datagrams ahead of the receiver. That keeps the
+ *          queue within half the buffer, so the rates are measured without drops.
+ */
+size_t prepareReceiver(const Socket& receiver, size_t datagramSize) {
+    int requested = 8 * 1024 * 1024;
+    setsockopt(receiver.getNativeHandle(), SOL_SOCKET, SO_RCVBUF, &requested, sizeof(requested));
+
+    int granted = 0;
+    socklen_t size = sizeof(granted);
+    getsockopt(receiver.getNativeHandle(), SOL_SOCKET, SO_RCVBUF, &granted, &size);
+    return std::max<size_t>(static_cast<size_t>(granted) / 2 / (datagramSize + DatagramOverhead), 1);
+}
+
+/**
+ * @brief   Wait until the receiver took enough datagrams for the next send to fit the credit
+ * @note    A datagram lost anyway never arrives, so the wait ends after 100ms without progress
+ *
+ * @param sent the datagrams sent including the next send
+ */
+void waitForCredit(const std::atomic<size_t>& received, size_t sent, size_t credit) {
+    if ( sent <= credit ) {
+        return;
+    }
+    size_t seen = received.load(std::memory_order_relaxed);
+    auto progress = Clock::now();
+    while ( seen < sent - credit ) {
+        std::this_thread::yield();
+        size_t current = received.load(std::memory_order_relaxed);
+        if ( current != seen ) {
+            seen = current;
+            progress = Clock::now();
+        } else if ( Clock::now() - progress > std::chrono::milliseconds(100) ) {
+            return;
+        }
+    }
+}
+
+void benchPacketRate(const Config& config, std::vector<Result>& results, size_t packetSize) {
+    Socket receiver(AddressFamily::IPv4, SocketType::UDP);
+    receiver.bind(Endpoint("127.0.0.1", 0));
+    Endpoint endpoint = localEndpoint(receiver);
+    const size_t credit = prepareReceiver(receiver, packetSize);
+
+    Socket sender(AddressFamily::IPv4, SocketType::UDP);
+    const size_t packets = config.scale(1000000);
+
+    std::atomic<bool> sending = true;
+    std::atomic<size_t> received = 0;
+    double receiveSeconds = 0;
+    std::thread receiving([&] {
+        UDPPacket packet(packetSize);
+        pollfd descriptor = { receiver.getNativeHandle(), POLLIN, 0 };
+        Clock::time_point start;
+        Clock::time_point last;
+        // keep draining until the sender is done and the socket stayed empty for a while
+        while ( received < packets ) {
+            if ( ::poll(&descriptor, 1, 100) <= 0 ) {
+                if ( !sending ) {
+                    break;
+                }
+                continue;
+            }
+            receiver.recv_from(packet);
+            last = Clock::now();
+            if ( received++ == 0 ) {
+                start = last;
+            }
+        }
+        if ( received > 1 ) {
+            receiveSeconds = std::chrono::duration<double>(last - start).count();
+        }
+    });
+
+    std::vector<std::byte> payload(packetSize, std::byte{ 0x5a });
+    auto start = Clock::now();
+    for ( size_t i = 0; i < packets; i++ ) {
+        waitForCredit(received, i + 1, credit);
+        sender.send_to(std::span<const std::byte>(payload), endpoint);
+    }
+    double sendSeconds = secondsSince(start);
+    sending = false;
+    receiving.join();
+
+    Result result;
+    result.name = "udp_packet_rate";
+    result.params["packet_size"] = std::to_string(packetSize);
+    result.params["packets"] = std::to_string(packets);
+    result.metrics["sent_pps"] = packets / sendSeconds;
+    result.metrics["received_pps"] = receiveSeconds > 0 ? received / receiveSeconds : 0;
+    result.metrics["loss_ratio"] = 1.0 - static_cast<double>(received) / packets;
+    results.push_back(std::move(result));
+}
+
+// datagrams of segmentSize, sent 44 per syscall with GSO and received coalesced with GRO when offload is set
+void benchSegmentation(const Config& config, std::vector<Result>& results, bool offload) {
+    constexpr uint16_t segmentSize = 1400;
+    constexpr size_t segmentsPerSend = 44;
+
+    Socket receiver(AddressFamily::IPv4, SocketType::UDP);
+    receiver.bind(Endpoint("127.0.0.1", 0));
+    if ( offload ) {
+        receiver.enableGro();
+    }
+    Endpoint endpoint = localEndpoint(receiver);
+    // a whole send has to fit the credit, or the sender would wait for datagrams it did not send yet
+    const size_t credit = std::max(prepareReceiver(receiver, segmentSize), segmentsPerSend);
+
+    Socket sender(AddressFamily::IPv4, SocketType::UDP);
+    const size_t sends = config.scale(50000);
+    const size_t datagrams = sends * segmentsPerSend;
+
+    std::atomic<bool> sending = true;
+    std::atomic<size_t> received = 0;
+    size_t receiveCalls = 0;
+    double receiveSeconds = 0;
+    std::thread receiving([&] {
+        UDPPacket packet(65536);
+        pollfd descriptor = { receiver.getNativeHandle(), POLLIN, 0 };
+        Clock::time_point start;
+        Clock::time_point last;
+        while ( received < datagrams ) {
+            if ( ::poll(&descriptor, 1, 100) <= 0 ) {
+                if ( !sending ) {
+                    break;
+                }
+                continue;
+            }
+            receiver.recv_from(packet);
+            last = Clock::now();
+            if ( receiveCalls++ == 0 ) {
+                start = last;
+            }
+            received += packet.segmentCount();
+        }
+        if ( receiveCalls > 1 ) {
+            receiveSeconds = std::chrono::duration<double>(last - start).count();
+        }
+    });
+
+    std::vector<std::byte> payload(segmentSize * segmentsPerSend, std::byte{ 0x5a });
+    auto start = Clock::now();
+    for ( size_t i = 0; i < sends; i++ ) {
+        waitForCredit(received, (i + 1) * segmentsPerSend, credit);
+        if ( offload ) {
+            sender.send_to(std::span<const std::byte>(payload), endpoint, segmentSize);
+            continue;
+        }
+        for ( size_t segment = 0; segment < segmentsPerSend; segment++ ) {
+            sender.send_to(std::span<const std::byte>(payload).subspan(segment * segmentSize, segmentSize), endpoint);
+        }
+    }
+    double sendSeconds = secondsSince(start);
+    sending = false;
+    receiving.join();
+
+    Result result;
+    result.name = offload ? "udp_gso_gro" : "udp_segmented_plain";
+    result.params["segment_size"] = std::to_string(segmentSize);
+    result.params["datagrams"] = std::to_string(datagrams);
+    result.metrics["sent_pps"] = datagrams / sendSeconds;
+    result.metrics["received_pps"] = receiveSeconds > 0 ? received / receiveSeconds : 0;
+    result.metrics["datagrams_per_recv"] = receiveCalls > 0 ? static_cast<double>(received) / receiveCalls : 0;
+    result.metrics["loss_ratio"] = 1.0 - static_cast<double>(received) / datagrams;
+    results.push_back(std::move(result));
+}
+
+} // namespace
+
+void SocketSparrow::Bench::benchUdp(const Config& config, std::vector<Result>& results) {
+    for ( size_t packetSize : { 64, 512, 1400 } ) {
+        benchPacketRate(config, results, packetSize);
+    }
+    benchSegmentation(config, results, false);
+    benchSegmentation(config, results, true);
+}
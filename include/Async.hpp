@@ -0,0 +1,189 @@
+/**
+ * @file Async.hpp
+ * @author TL044CN
+ * @brief Awaitable Socket Operations for SocketSparrow
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "Enums.hpp"
+#include "Endpoint.hpp"
+#include "UDPPacket.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#include <span>
+
+namespace SocketSparrow {
+
+    class Socket;
+    class Scheduler;
+
+    /**
+     * @brief   Base of all awaitable Socket operations
+     * @details The operation is attempted right away. If it would block, the awaiting
+     *          Coroutine is suspended and the Scheduler running on the current thread
+     *          retries the operation whenever the Socket becomes ready.
+     *          The operation object lives in the Coroutine frame, so awaiting it
+     *          does not allocate.
+     */
+    class AsyncOperation {
+    protected:
+        Socket& mSocket;
+        IOEvent mInterest;
+        std::coroutine_handle<> mHandle;
+        int mError = 0;
+
+        /**
+         * @brief   Try to complete the operation without blocking
+         *
+         * @return true if the operation finished (successfully or with an error)
+         */
+        virtual bool attempt() = 0;
+
+        friend class Scheduler;
+
+    public:
+        /**
+         * @brief Construct a new Async Operation
+         *
+         * @param socket the Socket to operate on
+         * @param interest the readiness Event the operation waits for
+         */
+        AsyncOperation(Socket& socket, IOEvent interest);
+
+        AsyncOperation(const AsyncOperation&) = delete;
+        AsyncOperation& operator=(const AsyncOperation&) = delete;
+
+        virtual ~AsyncOperation() = default;
+
+        /**
+         * @brief Get the Socket the operation works on
+         *
+         * @return Socket& the Socket
+         */
+        Socket& getSocket() const;
+
+        bool await_ready();
+
+        /**
+         * @brief   Suspend until the Socket is ready
+         * @throws SocketException if no Scheduler is running on this thread
+         */
+        void await_suspend(std::coroutine_handle<> handle);
+    };
+
+    /**
+     * @brief Awaitable accept of an incoming connection
+     */
+    class AsyncAccept : public AsyncOperation {
+    private:
+        int mConnection = -1;   // closed on destruction unless await_resume() took it
+        Endpoint mPeer;
+        bool attempt() override;
+
+    public:
+        explicit AsyncAccept(Socket& socket);
+
+        ~AsyncAccept() override;
+
+        /**
+         * @brief   Get the accepted connection
+         *
+         * @return Socket the accepted (non-blocking) connection
+         * @throws SocketException if accepting failed
+         */
+        Socket await_resume();
+    };
+
+    /**
+     * @brief Awaitable connect to an Endpoint
+     */
+    class AsyncConnect : public AsyncOperation {
+    private:
+        Endpoint mEndpoint;
+        bool mStarted = false;
+        bool attempt() override;
+
+    public:
+        AsyncConnect(Socket& socket, const Endpoint& endpoint);
+
+        /**
+         * @brief   Finish connecting
+         *
+         * @throws SocketException if connecting failed
+         */
+        void await_resume();
+    };
+
+    /**
+     * @brief Awaitable receive into a caller provided buffer
+     */
+    class AsyncRecv : public AsyncOperation {
+    private:
+        std::span<std::byte> mBuffer;
+        size_t mReceived = 0;
+        bool attempt() override;
+
+    public:
+        AsyncRecv(Socket& socket, std::span<std::byte> buffer);
+
+        /**
+         * @brief   Get the number of received bytes
+         *
+         * @return size_t number of received bytes, 0 if the connection was closed
+         * @throws RecvError if receiving failed
+         */
+        size_t await_resume();
+    };
+
+    /**
+     * @brief Awaitable send of a caller provided buffer
+     */
+    class AsyncSend : public AsyncOperation {
+    private:
+        std::span<const std::byte> mData;
+        size_t mSent = 0;
+        bool attempt() override;
+
+    public:
+        AsyncSend(Socket& socket, std::span<const std::byte> data);
+
+        /**
+         * @brief   Get the number of sent bytes
+         *
+         * @return size_t number of sent bytes, may be less than requested
+         * @throws SendError if sending failed
+         */
+        size_t await_resume();
+    };
+
+    /**
+     * @brief Awaitable receive of a UDP Packet
+     */
+    class AsyncRecvFrom : public AsyncOperation {
+    private:
+        UDPPacket& mPacket;
+        size_t mReceived = 0;
+        bool attempt() override;
+
+    public:
+        AsyncRecvFrom(Socket& socket, UDPPacket& packet);
+
+        /**
+         * @brief   Get the number of received bytes
+         * @note    the packet is filled like Socket::recv_from(UDPPacket&), including segmentSize
+         *
+         * @return size_t number of received bytes
+         * @throws RecvError if receiving failed or the datagram did not fit the packet (EMSGSIZE)
+         */
+        size_t await_resume();
+    };
+
+} // namespace SocketSparrow
@@ -0,0 +1,218 @@
+/**
+ * @file AsyncResolver.hpp
+ * @author TL044CN
+ * @brief Non-blocking DNS Resolver for SocketSparrow
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "Endpoint.hpp"
+#include "Reactor.hpp"
+#include "Socket.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SocketSparrow {
+
+    /**
+     * @brief Outcome of a DNS lookup
+     */
+    enum class ResolveStatus {
+        Success,    ///< At least one address was found
+        NotFound,   ///< The name does not exist or has no address of the requested family
+        Timeout,    ///< The DNS server did not answer
+        Failed      ///< The DNS server answered with an error
+    };
+
+    /**
+     * @brief   Resolves hostnames by talking DNS over a UDP Socket
+     * @details Queries are sent to a single configurable DNS server without blocking.
+     *          Answers are dispatched by process(), either driven by a Reactor (attach())
+     *          or by poll(). Every A and AAAA record of an answer is returned and kept in a
+     *          sharded cache for its TTL. Names that do not exist are cached as well.
+     * @note    Only the cache lookup (cached()) is thread-safe. Everything else has to
+     *          be called from the thread driving the resolver.
+     *          Truncated answers are not retried over TCP, the records received so far are used.
+     */
+    class AsyncResolver {
+    public:
+        /**
+         * @brief Callback invoked once a lookup finished
+         */
+        using Callback = std::function<void(ResolveStatus status, const std::vector<Endpoint>& endpoints)>;
+
+        /**
+         * @brief Tuning of an AsyncResolver
+         */
+        struct Options {
+            std::chrono::milliseconds timeout = std::chrono::milliseconds(500); ///< time to wait for an answer
+            unsigned attempts = 3;                                          ///< queries sent before giving up
+            std::chrono::seconds negativeTtl = std::chrono::seconds(30);    ///< how long missing names are cached
+            std::chrono::seconds maxTtl = std::chrono::seconds(3600);       ///< upper bound for cached answers
+            size_t shards = 16;                                             ///< number of independently locked cache shards
+        };
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct CacheEntry {
+            std::vector<Endpoint> addresses;    // port 0, the port is applied on lookup
+            Clock::time_point expires;
+        };
+
+        struct Shard {
+            std::mutex mutex;
+            std::unordered_map<std::string, CacheEntry> entries;
+        };
+
+        struct Lookup {
+            uint16_t port;
+            Callback callback;
+            unsigned outstanding = 0;
+            std::vector<std::vector<Endpoint>> results;   // per record type, A before AAAA
+            std::optional<ResolveStatus> failure;
+        };
+
+        struct Query {
+            std::shared_ptr<Lookup> lookup;
+            size_t slot;
+            std::string key;
+            std::vector<uint8_t> message;
+            Clock::time_point deadline;
+            unsigned attemptsLeft;
+        };
+
+        Endpoint mServer;
+        Options mOptions;
+        Socket mSocket;
+        std::vector<Shard> mShards;
+        std::unordered_map<uint16_t, Query> mQueries;
+        std::mt19937 mRandom;   // query ids, unpredictable so answers cannot be guessed
+        Reactor* mReactor = nullptr;
+
+        Shard& shardFor(const std::string& key);
+        std::optional<std::vector<Endpoint>> cachedAddresses(const std::string& key);
+        void store(const std::string& key, std::vector<Endpoint> addresses, std::chrono::seconds ttl);
+
+        uint16_t freshId();
+        void send(uint16_t id, Query& query);
+        void handleResponse(const uint8_t* data, size_t size);
+        void finish(uint16_t id, ResolveStatus status, std::vector<Endpoint> addresses);
+        void complete(Lookup& lookup);
+
+    public:
+        /**
+         * @brief Construct a new Async Resolver
+         *
+         * @param server the DNS server to ask (usually port 53)
+         * @param options tuning of timeouts and caching
+         * @throws SocketException if creating the Socket fails
+         */
+        explicit AsyncResolver(const Endpoint& server, Options options);
+
+        /**
+         * @brief Construct a new Async Resolver with default Options
+         *
+         * @param server the DNS server to ask (usually port 53)
+         * @throws SocketException if creating the Socket fails
+         */
+        explicit AsyncResolver(const Endpoint& server);
+
+        AsyncResolver(const AsyncResolver&) = delete;
+        AsyncResolver& operator=(const AsyncResolver&) = delete;
+
+        /**
+         * @brief Detach from the Reactor, pending lookups are dropped without a Callback
+         */
+        ~AsyncResolver();
+
+        /**
+         * @brief   Resolve a hostname
+         * @details IP literals and cached names complete right away, before resolve() returns.
+         *          Everything else completes from process() or poll().
+         *
+         * @param hostname the name to resolve
+         * @param port the port of the returned Endpoints
+         * @param callback invoked exactly once with the result
+         * @param af IPv4 for A records, IPv6 for AAAA records, Unknown for both
+         * @throws InvalidAddressException if the hostname is not a valid DNS name
+         */
+        void resolve(const std::string& hostname, uint16_t port, Callback callback, AddressFamily af = AddressFamily::Unknown);
+
+        /**
+         * @brief   Look a hostname up in the cache only
+         * @note    Thread-safe
+         *
+         * @param hostname the name to look up
+         * @param port the port of the returned Endpoints
+         * @param af IPv4 for A records, IPv6 for AAAA records, Unknown for both
+         * @return std::optional<std::vector<Endpoint>> the cached Endpoints (empty if the name is
+         *         known not to exist) or std::nullopt if the name is not cached
+         */
+        std::optional<std::vector<Endpoint>> cached(const std::string& hostname, uint16_t port, AddressFamily af = AddressFamily::Unknown);
+
+        /**
+         * @brief Read all pending answers and complete their lookups
+         */
+        void process();
+
+        /**
+         * @brief Resend or fail queries whose answer is overdue
+         */
+        void processTimeouts();
+
+        /**
+         * @brief   Get the time until the next query times out
+         *
+         * @return int milliseconds until processTimeouts() has work, -1 if no query is pending
+         */
+        int nextTimeout() const;
+
+        /**
+         * @brief   Wait for answers and timeouts without a Reactor
+         *
+         * @param timeoutMs the maximum time to wait in milliseconds, -1 to wait for the next event
+         */
+        void poll(int timeoutMs = -1);
+
+        /**
+         * @brief   Let a Reactor call process() whenever answers arrive
+         * @note    processTimeouts() still has to be called, e.g. with nextTimeout() as poll timeout
+         *
+         * @param reactor the Reactor to register with
+         */
+        void attach(Reactor& reactor);
+
+        /**
+         * @brief Unregister from the Reactor passed to attach()
+         */
+        void detach();
+
+        /**
+         * @brief Get the number of queries waiting for an answer
+         *
+         * @return size_t the number of pending queries
+         */
+        size_t pending() const;
+
+        /**
+         * @brief Remove all cached names
+         */
+        void clearCache();
+    };
+
+} // namespace SocketSparrow
@@ -0,0 +1,453 @@
+/**
+ * @file BasicSocket.hpp
+ * @author TL044CN
+ * @brief Compile-Time Specialised Sockets for SocketSparrow
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "Endpoint.hpp"
+#include "Enums.hpp"
+#include "Exceptions.hpp"
+#include "IOResult.hpp"
+#include "Socket.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace SocketSparrow {
+
+    /**
+     * @brief   Socket with Address Family and protocol fixed at compile time
+     * @details Operations the protocol does not support (e.g. listen() on UDP) do not exist,
+     *          so misuse fails to compile instead of throwing. sockaddr sizes and option
+     *          levels are constants and every method is a thin inline wrapper around its
+     *          system call, without the runtime checks of Socket.
+     * @note    Use toSocket() where the runtime-polymorphic Socket is needed
+     *
+     * @tparam Family the Address Family, IPv4 or IPv6
+     * @tparam Type the protocol, TCP or UDP
+     */
+    template<AddressFamily Family, SocketType Type>
+    class BasicSocket {
+        static_assert(Family == AddressFamily::IPv4 || Family == AddressFamily::IPv6,
+            "BasicSocket supports IPv4 and IPv6");
+        static_assert(Type == SocketType::TCP || Type == SocketType::UDP,
+            "BasicSocket supports TCP and UDP");
+
+    public:
+        static constexpr AddressFamily addressFamily = Family;
+        static constexpr SocketType socketType = Type;
+        static constexpr bool isTcp = Type == SocketType::TCP;
+        static constexpr bool isUdp = Type == SocketType::UDP;
+
+        /**
+         * @brief The native sockaddr type of the Address Family
+         */
+        using Address = std::conditional_t<Family == AddressFamily::IPv4, sockaddr_in, sockaddr_in6>;
+
+        static constexpr socklen_t addressSize = sizeof(Address);
+
+    private:
+        int mNativeSocket = -1;
+
+        static constexpr int nativeFamily = static_cast<int>(Family);
+        static constexpr int nativeType = static_cast<int>(Type);
+
+        explicit BasicSocket(int fd) noexcept : mNativeSocket(fd) {}
+
+        static void checkFamily(const Endpoint& endpoint) {
+            if ( endpoint.getAddressFamily() != Family ) {
+                throw SocketException(EAFNOSUPPORT, "Endpoint does not match the Address Family of the Socket");
+            }
+        }
+
+        void setOption(int level, int name, int value) {
+            if ( setsockopt(mNativeSocket, level, name, &value, sizeof(value)) == -1 ) {
+                throw SocketException(errno, "Failed to set socket option");
+            }
+        }
+
+    public:
+        /**
+         * @brief Create a new socket
+         *
+         * @throws SocketException if creating the socket fails
+         */
+        BasicSocket() : mNativeSocket(::socket(nativeFamily, nativeType | SOCK_CLOEXEC, 0)) {
+            if ( mNativeSocket == -1 ) {
+                throw SocketException(errno, "Failed to create Socket");
+            }
+        }
+
+        /**
+         * @brief Take ownership of an existing descriptor of the matching family and type
+         *
+         * @param fd the descriptor, it is not checked
+         * @return BasicSocket the Socket owning fd
+         */
+        static BasicSocket adopt(int fd) noexcept {
+            return BasicSocket(fd);
+        }
+
+        BasicSocket(BasicSocket&& other) noexcept
+            : mNativeSocket(std::exchange(other.mNativeSocket, -1)) {}
+
+        BasicSocket& operator=(BasicSocket&& other) noexcept {
+            if ( this != &other ) {
+                reset();
+                mNativeSocket = std::exchange(other.mNativeSocket, -1);
+            }
+            return *this;
+        }
+
+        BasicSocket(const BasicSocket&) = delete;
+        BasicSocket& operator=(const BasicSocket&) = delete;
+
+        /**
+         * @brief Closes the descriptor, unless it was moved from or released
+         */
+        ~BasicSocket() {
+            reset();
+        }
+
+        /**
+         * @brief Close the descriptor if one is owned
+         */
+        void reset() noexcept {
+            if ( mNativeSocket != -1 ) {
+                ::close(mNativeSocket);
+                mNativeSocket = -1;
+            }
+        }
+
+        /**
+         * @brief   Give up ownership of the descriptor
+         *
+         * @return int the descriptor, the caller has to close it
+         */
+        int release() noexcept {
+            return std::exchange(mNativeSocket, -1);
+        }
+
+        /**
+         * @brief   Get the native file descriptor
+         * @note    The Socket keeps ownership of the descriptor
+         *
+         * @return int the native file descriptor, -1 if moved from or released
+         */
+        int getNativeHandle() const noexcept {
+            return mNativeSocket;
+        }
+
+        /**
+         * @brief   Convert into a runtime-polymorphic Socket
+         * @note    This Socket is left without a descriptor
+         *
+         * @return Socket the Socket owning the descriptor
+         * @throws SocketException if the descriptor cannot be adopted
+         */
+        Socket toSocket() && {
+            Socket socket = Socket::adopt(mNativeSocket);
+            mNativeSocket = -1;
+            return socket;
+        }
+
+        /**
+         * @brief bind the Socket to an Endpoint
+         *
+         * @param endpoint the local Endpoint
+         * @throws SocketException if the Endpoint has another Address Family or binding fails
+         */
+        void bind(const Endpoint& endpoint) {
+            checkFamily(endpoint);
+            if ( ::bind(mNativeSocket, endpoint.c_addr(), addressSize) == -1 ) {
+                throw SocketException(errno, "Failed to bind");
+            }
+        }
+
+        /**
+         * @brief   connect the Socket to a remote Endpoint
+         * @note    For UDP this sets the default destination and filters incoming datagrams
+         *
+         * @param endpoint the remote Endpoint
+         * @throws SocketException if the Endpoint has another Address Family or connecting fails
+         */
+        void connect(const Endpoint& endpoint) {
+            checkFamily(endpoint);
+            if ( ::connect(mNativeSocket, endpoint.c_addr(), addressSize) == -1 ) {
+                throw SocketException(errno, "Failed to connect");
+            }
+        }
+
+        /**
+         * @brief Listen for incoming connections
+         *
+         * @param backlog the length of the accept queue
+         * @throws SocketException if listening fails
+         */
+        void listen(int backlog = 5) requires isTcp {
+            if ( ::listen(mNativeSocket, backlog) == -1 ) {
+                throw SocketException(errno, "Failed to listen");
+            }
+        }
+
+        /**
+         * @brief   Accept an incoming connection
+         * @note    The connection is close-on-exec and inherits nothing else from the listener
+         *
+         * @return BasicSocket the connection
+         * @throws SocketException if accepting fails
+         */
+        BasicSocket accept() requires isTcp {
+            int fd = ::accept4(mNativeSocket, nullptr, nullptr, SOCK_CLOEXEC);
+            if ( fd == -1 ) {
+                throw SocketException(errno, "Failed to accept");
+            }
+            return BasicSocket(fd);
+        }
+
+        /**
+         * @brief   Accept an incoming connection and report its peer
+         *
+         * @param peer set to the remote Endpoint of the connection
+         * @return BasicSocket the connection
+         * @throws SocketException if accepting fails
+         */
+        BasicSocket accept(Endpoint& peer) requires isTcp {
+            sockaddr_storage address;
+            socklen_t size = sizeof(address);
+            int fd = ::accept4(mNativeSocket, reinterpret_cast<sockaddr*>(&address), &size, SOCK_CLOEXEC);
+            if ( fd == -1 ) {
+                throw SocketException(errno, "Failed to accept");
+            }
+            BasicSocket connection(fd);
+            peer = Endpoint(address, size);
+            return connection;
+        }
+
+        /**
+         * @brief   Accept an incoming connection without throwing on failure
+         * @note    The connection is non-blocking and close-on-exec
+         *
+         * @return IOResult<BasicSocket> the connection, or the error (e.g. EAGAIN if none is pending)
+         */
+        IOResult<BasicSocket> try_accept() noexcept requires isTcp {
+            int fd;
+            do {
+                fd = ::accept4(mNativeSocket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            } while ( fd == -1 && (errno == EINTR || errno == ECONNABORTED) );
+            if ( fd == -1 ) {
+                return IOResult<BasicSocket>::fromErrno(errno);
+            }
+            return BasicSocket(fd);
+        }
+
+        /**
+         * @brief Send data on a connected Socket
+         *
+         * @param data the data to send
+         * @return size_t the number of bytes sent
+         * @throws SendError if sending fails
+         */
+        size_t send(std::span<const std::byte> data) const {
+            ssize_t sent = ::send(mNativeSocket, data.data(), data.size(), MSG_NOSIGNAL);
+            if ( sent == -1 ) {
+                throw SendError(errno, "Failed to send");
+            }
+            return static_cast<size_t>(sent);
+        }
+
+        /**
+         * @brief Send data on a connected Socket
+         *
+         * @param data the data to send
+         * @return size_t the number of bytes sent
+         * @throws SendError if sending fails
+         */
+        size_t send(std::string_view data) const {
+            return send(std::as_bytes(std::span(data)));
+        }
+
+        /**
+         * @brief Send data on a connected Socket without throwing on failure
+         *
+         * @param data the data to send
+         * @return IOResult<size_t> the number of bytes sent, or the error
+         */
+        IOResult<size_t> try_send(std::span<const std::byte> data) const noexcept {
+            ssize_t sent;
+            do {
+                sent = ::send(mNativeSocket, data.data(), data.size(), MSG_NOSIGNAL);
+            } while ( sent == -1 && errno == EINTR );
+            if ( sent == -1 ) {
+                return IOResult<size_t>::fromErrno(errno);
+            }
+            return static_cast<size_t>(sent);
+        }
+
+        /**
+         * @brief Receive data on a connected Socket
+         *
+         * @param buffer the buffer to store the data
+         * @return size_t the number of bytes received, 0 if the peer closed the connection
+         * @throws RecvError if receiving fails
+         */
+        size_t recv(std::span<std::byte> buffer) const {
+            ssize_t received = ::recv(mNativeSocket, buffer.data(), buffer.size(), 0);
+            if ( received == -1 ) {
+                throw RecvError(errno, "Failed to receive");
+            }
+            return static_cast<size_t>(received);
+        }
+
+        /**
+         * @brief Receive data on a connected Socket without throwing on failure
+         *
+         * @param buffer the buffer to store the data
+         * @return IOResult<size_t> the number of bytes received (0 if the peer closed the connection), or the error
+         */
+        IOResult<size_t> try_recv(std::span<std::byte> buffer) const noexcept {
+            ssize_t received;
+            do {
+                received = ::recv(mNativeSocket, buffer.data(), buffer.size(), 0);
+            } while ( received == -1 && errno == EINTR );
+            if ( received == -1 ) {
+                return IOResult<size_t>::fromErrno(errno);
+            }
+            return static_cast<size_t>(received);
+        }
+
+        /**
+         * @brief   Send a datagram to an Endpoint
+         * @note    The Endpoint has to have the Address Family of the Socket, the kernel rejects others
+         *
+         * @param data the datagram
+         * @param endpoint the destination
+         * @return size_t the number of bytes sent
+         * @throws SendError if sending fails
+         */
+        size_t send_to(std::span<const std::byte> data, const Endpoint& endpoint) const requires isUdp {
+            ssize_t sent = ::sendto(mNativeSocket, data.data(), data.size(), 0, endpoint.c_addr(), addressSize);
+            if ( sent == -1 ) {
+                throw SendError(errno, "Failed to send");
+            }
+            return static_cast<size_t>(sent);
+        }
+
+        /**
+         * @brief Send a datagram to an Endpoint
+         *
+         * @param data the datagram
+         * @param endpoint the destination
+         * @return size_t the number of bytes sent
+         * @throws SendError if sending fails
+         */
+        size_t send_to(std::string_view data, const Endpoint& endpoint) const requires isUdp {
+            return send_to(std::as_bytes(std::span(data)), endpoint);
+        }
+
+        /**
+         * @brief Receive a datagram and its sender
+         *
+         * @param buffer the buffer to store the datagram
+         * @param sender set to the Endpoint the datagram came from
+         * @return size_t the size of the datagram
+         * @throws RecvError if receiving fails
+         */
+        size_t recv_from(std::span<std::byte> buffer, Endpoint& sender) const requires isUdp {
+            Address address;
+            socklen_t size = addressSize;
+            ssize_t received = ::recvfrom(mNativeSocket, buffer.data(), buffer.size(), 0, reinterpret_cast<sockaddr*>(&address), &size);
+            if ( received == -1 ) {
+                throw RecvError(errno, "Failed to receive");
+            }
+            sender = Endpoint(reinterpret_cast<sockaddr*>(&address), size);
+            return static_cast<size_t>(received);
+        }
+
+        /**
+         * @brief Configure the Socket for non-blocking mode (or disable it)
+         *
+         * @param enable true for non-blocking mode
+         * @throws SocketException if the mode cannot be changed
+         */
+        void enableNonBlocking(bool enable = true) {
+            int flags = fcntl(mNativeSocket, F_GETFL);
+            if ( flags == -1 || fcntl(mNativeSocket, F_SETFL, enable ? flags | O_NONBLOCK : flags & ~O_NONBLOCK) == -1 ) {
+                throw SocketException(errno, "Failed to set non-blocking mode");
+            }
+        }
+
+        /**
+         * @brief Enable or disable address reuse (SO_REUSEADDR)
+         *
+         * @param enable true to enable
+         * @throws SocketException if setting the option fails
+         */
+        void enableAddressReuse(bool enable = true) {
+            setOption(SOL_SOCKET, SO_REUSEADDR, enable);
+        }
+
+        /**
+         * @brief Enable or disable port reuse (SO_REUSEPORT)
+         *
+         * @param enable true to enable
+         * @throws SocketException if setting the option fails
+         */
+        void enablePortReuse(bool enable = true) {
+            setOption(SOL_SOCKET, SO_REUSEPORT, enable);
+        }
+
+        /**
+         * @brief Disable Nagle's algorithm (TCP_NODELAY), or enable it again
+         *
+         * @param enable true to send small segments immediately
+         * @throws SocketException if setting the option fails
+         */
+        void enableNoDelay(bool enable = true) requires isTcp {
+            setOption(IPPROTO_TCP, TCP_NODELAY, enable);
+        }
+
+        /**
+         * @brief Enable or disable broadcast (SO_BROADCAST)
+         *
+         * @param enable true to enable
+         * @throws SocketException if setting the option fails
+         */
+        void enableBroadcast(bool enable = true) requires (isUdp && Family == AddressFamily::IPv4) {
+            setOption(SOL_SOCKET, SO_BROADCAST, enable);
+        }
+
+        /**
+         * @brief Restrict an IPv6 Socket to IPv6 traffic (IPV6_V6ONLY)
+         *
+         * @param enable true to reject IPv4-mapped traffic
+         * @throws SocketException if setting the option fails
+         */
+        void enableV6Only(bool enable = true) requires (Family == AddressFamily::IPv6) {
+            setOption(IPPROTO_IPV6, IPV6_V6ONLY, enable);
+        }
+    };
+
+    using TcpV4Socket = BasicSocket<AddressFamily::IPv4, SocketType::TCP>;  ///< IPv4 TCP Socket
+    using TcpV6Socket = BasicSocket<AddressFamily::IPv6, SocketType::TCP>;  ///< IPv6 TCP Socket
+    using UdpV4Socket = BasicSocket<AddressFamily::IPv4, SocketType::UDP>;  ///< IPv4 UDP Socket
+    using UdpV6Socket = BasicSocket<AddressFamily::IPv6, SocketType::UDP>;  ///< IPv6 UDP Socket
+
+} // namespace SocketSparrow
@@ -0,0 +1,109 @@
+/**
+ * @file Buffer.hpp
+ * @author TL044CN
+ * @brief Buffer Views for vectored Socket I/O
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sys/uio.h>
+
+namespace SocketSparrow {
+
+    /**
+     * @brief   Non-owning view of read-only memory for vectored sends
+     * @details Wraps an iovec so a list of ConstBuffers can be handed to the kernel as is.
+     *          The viewed memory has to outlive the call it is passed to.
+     */
+    class ConstBuffer {
+    private:
+        iovec mIovec;
+
+    public:
+        /**
+         * @brief Construct a new Const Buffer object
+         *
+         * @param data start of the memory
+         * @param size number of bytes
+         */
+        ConstBuffer(const void* data, size_t size)
+            : mIovec{ const_cast<void*>(data), size } {}
+
+        ConstBuffer(std::span<const std::byte> data)
+            : ConstBuffer(data.data(), data.size()) {}
+
+        ConstBuffer(std::string_view data)
+            : ConstBuffer(data.data(), data.size()) {}
+
+        ConstBuffer(const char* data)
+            : ConstBuffer(data, std::strlen(data)) {}
+
+        ConstBuffer(const std::string& data)
+            : ConstBuffer(data.data(), data.size()) {}
+
+        ConstBuffer(const std::vector<char>& data)
+            : ConstBuffer(data.data(), data.size()) {}
+
+        const void* data() const { return mIovec.iov_base; }
+        size_t size() const { return mIovec.iov_len; }
+
+        /**
+         * @brief Get the underlying iovec
+         *
+         * @return const iovec& the iovec describing this Buffer
+         */
+        const iovec& native() const { return mIovec; }
+    };
+
+    /**
+     * @brief   Non-owning view of writable memory for vectored receives
+     * @details Wraps an iovec so a list of MutableBuffers can be handed to the kernel as is.
+     *          The viewed memory has to outlive the call it is passed to.
+     */
+    class MutableBuffer {
+    private:
+        iovec mIovec;
+
+    public:
+        /**
+         * @brief Construct a new Mutable Buffer object
+         *
+         * @param data start of the memory
+         * @param size number of bytes
+         */
+        MutableBuffer(void* data, size_t size)
+            : mIovec{ data, size } {}
+
+        MutableBuffer(std::span<std::byte> data)
+            : MutableBuffer(data.data(), data.size()) {}
+
+        MutableBuffer(std::string& data)
+            : MutableBuffer(data.data(), data.size()) {}
+
+        MutableBuffer(std::vector<char>& data)
+            : MutableBuffer(data.data(), data.size()) {}
+
+        void* data() const { return mIovec.iov_base; }
+        size_t size() const { return mIovec.iov_len; }
+
+        /**
+         * @brief Get the underlying iovec
+         *
+         * @return const iovec& the iovec describing this Buffer
+         */
+        const iovec& native() const { return mIovec; }
+    };
+
+} // namespace SocketSparrow
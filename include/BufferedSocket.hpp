@@ -0,0 +1,173 @@
+/**
+ * @file BufferedSocket.hpp
+ * @author TL044CN
+ * @brief Buffered Stream Reader and Writer for SocketSparrow
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "RingBuffer.hpp"
+#include "Socket.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace SocketSparrow {
+
+    /**
+     * @brief   Reads a stream Socket through a RingBuffer
+     * @details Every receive fills as much of the buffer as one recv call delivers, so many
+     *          small records cost one system call. The Socket has to outlive the reader.
+     * @note    On a non-blocking Socket the reading methods throw RecvError when they have to
+     *          wait for data. Already buffered data stays buffered in that case.
+     */
+    class BufferedSocketReader {
+    private:
+        Socket& mSocket;
+        RingBuffer mBuffer;
+
+    public:
+        /**
+         * @brief Construct a new Buffered Socket Reader
+         *
+         * @param socket the Socket to read from
+         * @param capacity the size of the buffer, the longest record peek() and readUntil() can return
+         * @throws SocketException if the buffer cannot be created
+         */
+        explicit BufferedSocketReader(Socket& socket, size_t capacity = 64 * 1024);
+
+        /**
+         * @brief Receive once into the free space of the buffer
+         *
+         * @return size_t the number of bytes received, 0 if the peer closed the connection or the buffer is full
+         * @throws RecvError if receiving fails
+         */
+        size_t fill();
+
+        /**
+         * @brief   Look at buffered data without consuming it, receiving until count bytes are buffered
+         *
+         * @param count the number of bytes wanted
+         * @return std::span<const std::byte> the buffered bytes, shorter than count only at end of stream
+         * @throws SocketException if count exceeds the buffer capacity
+         * @throws RecvError if receiving fails
+         */
+        std::span<const std::byte> peek(size_t count);
+
+        /**
+         * @brief   Read exactly buffer.size() bytes
+         * @details Requests up to capacity() are completed in the buffer before anything is consumed.
+         *          Larger ones take the buffered bytes and receive the rest directly into buffer.
+         *
+         * @param buffer the buffer to fill
+         * @return size_t the number of bytes read, shorter than buffer.size() at end of stream, or when
+         *         receiving into a buffer larger than capacity() fails after some bytes arrived
+         * @throws RecvError if receiving fails before any byte is read
+         */
+        size_t readExact(std::span<std::byte> buffer);
+
+        /**
+         * @brief   Read up to and including the next delimiter
+         * @note    The returned view points into the buffer and stays valid until the next call on this reader
+         *
+         * @param delimiter the delimiter ending the record, e.g. "\n" or "\r\n"
+         * @return std::optional<std::string_view> the record without the delimiter,
+         *         std::nullopt if the stream ended before the delimiter
+         * @throws SocketException if no delimiter is found within the buffer capacity
+         * @throws RecvError if receiving fails
+         */
+        std::optional<std::string_view> readUntil(std::string_view delimiter);
+
+        /**
+         * @brief Drop buffered bytes, e.g. after using them through peek()
+         *
+         * @param count the number of bytes to drop
+         * @throws SocketException if count exceeds buffered()
+         */
+        void consume(size_t count);
+
+        /**
+         * @brief Get the number of buffered bytes
+         *
+         * @return size_t the number of bytes that can be read without a system call
+         */
+        size_t buffered() const;
+
+        /**
+         * @brief Get the capacity of the buffer
+         *
+         * @return size_t the most bytes that can be buffered at once
+         */
+        size_t capacity() const;
+    };
+
+    /**
+     * @brief   Writes to a stream Socket through a RingBuffer
+     * @details Small writes are collected and sent with one system call by flush(), or when the
+     *          buffer runs full. Writes larger than the buffer bypass it. The Socket has to outlive the writer.
+     * @note    The destructor flushes, but swallows errors. Call flush() to see them.
+     */
+    class BufferedSocketWriter {
+    private:
+        Socket& mSocket;
+        RingBuffer mBuffer;
+
+    public:
+        /**
+         * @brief Construct a new Buffered Socket Writer
+         *
+         * @param socket the Socket to write to
+         * @param capacity the number of bytes collected before they are sent
+         * @throws SocketException if the buffer cannot be created
+         */
+        explicit BufferedSocketWriter(Socket& socket, size_t capacity = 64 * 1024);
+
+        BufferedSocketWriter(const BufferedSocketWriter&) = delete;
+        BufferedSocketWriter& operator=(const BufferedSocketWriter&) = delete;
+
+        /**
+         * @brief Flush what is left
+         */
+        ~BufferedSocketWriter();
+
+        /**
+         * @brief   Append data, sending the buffer first if it does not fit
+         *
+         * @param data the data to write
+         * @throws SendError if sending fails
+         */
+        void write(std::span<const std::byte> data);
+
+        /**
+         * @brief Append data, sending the buffer first if it does not fit
+         *
+         * @param data the data to write
+         * @return BufferedSocketWriter& this writer for chaining
+         * @throws SendError if sending fails
+         */
+        BufferedSocketWriter& operator<<(std::string_view data);
+
+        /**
+         * @brief   Send all buffered data
+         * @note    If sending fails the unsent bytes stay buffered
+         *
+         * @throws SendError if sending fails
+         */
+        void flush();
+
+        /**
+         * @brief Get the number of bytes waiting to be sent
+         *
+         * @return size_t the number of buffered bytes
+         */
+        size_t buffered() const;
+    };
+
+} // namespace SocketSparrow
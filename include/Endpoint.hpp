@@ -14,29 +14,69 @@
 
 #include <arpa/inet.h>
 #include <netdb.h>
+#include <sys/un.h>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
 
 namespace SocketSparrow {
 
 /**
- * @brief Abstraction for a Network Endpoint
+ * @brief   Abstraction for a Network Endpoint
+ * @details Endpoints are trivially copyable values. They can be compared,
+ *          ordered and hashed, so they work as keys of (hash) maps.
+ * @note    Holding Unix paths makes an Endpoint as large as a sockaddr_un (112 bytes),
+ *          an IPv6 address alone would need 28.
  */
 class Endpoint {
 private:
+    /**
+     * @brief A Unix address and its size, which fits the padding behind sun_path
+     */
+    struct UnixAddress {
+        sockaddr_un address;
+        uint8_t size;   // Unix addresses are not NUL terminated in the abstract namespace
+    };
+
+    // the Address Family is the one in the sockaddr, AF_UNSPEC for the unspecified Endpoint
     union Sockaddr {
         sockaddr        base;
         sockaddr_in     ipv4;
         sockaddr_in6    ipv6;
+        UnixAddress     local;
+
+        // only the IP part is zeroed, clearing the whole sockaddr_un would dominate every construction
+        Sockaddr() : ipv6{} {}
     } mSockaddr;
 
-    AddressFamily mAddressFamily;    
+    /**
+     * @brief Copy a checked IPv4, IPv6 or Unix address of the given size
+     */
+    void assign(const sockaddr* addr, socklen_t size);
+
+    /**
+     * @brief Get the name of a Unix Endpoint (the path, or the abstract name without the leading NUL)
+     */
+    std::string_view unixName() const;
 
 public:
+    /**
+     * @brief   Construct an unspecified Endpoint
+     * @note    This does not resolve anything and is cheap enough to be
+     *          used as a placeholder that is filled in later (e.g. by recv_from)
+     */
+    Endpoint();
+
     /**
      * @brief Construct a new Endpoint object
      * 
      * @param addr sockaddr to copy
      * @param size size of sockaddr
+     * @throws InvalidAddressException if the size does not match the Address Family
+     * @throws InvalidAddressFamilyException if the address is not an IPv4, IPv6 or Unix address
      */
     Endpoint(sockaddr* addr, socklen_t size);
 
@@ -46,7 +86,7 @@ public:
      * @param hostname the Hostname of the Endpoint
      * @param port the Port of the Endpoint
      */
-    explicit Endpoint(const std::string& hostname = "localhost", uint16_t port = 80, AddressFamily af = AddressFamily::IPv4);
+    explicit Endpoint(const std::string& hostname, uint16_t port = 80, AddressFamily af = AddressFamily::IPv4);
 
     /**
      * @brief Construct a new Endpoint object
@@ -61,8 +101,10 @@ public:
      * 
      * @param addr address to copy
      * @param size size of address
+     * @note  A size of 0 (the sender of a datagram from an unbound Unix Socket) gives the unspecified Endpoint
+     * @throws InvalidAddressException if the address is not an IPv4, IPv6 or Unix address
      */
-    explicit Endpoint(sockaddr_storage addr, socklen_t size);
+    explicit Endpoint(const sockaddr_storage& addr, socklen_t size);
 
     /**
      * @brief Construct a new Endpoint object
@@ -73,9 +115,24 @@ public:
     explicit Endpoint(AddressFamily, uint16_t port = 80);
 
     /**
-     * @brief Destroy the Endpoint
+     * @brief   Create a Unix Endpoint for a filesystem path
+     * @note    Binding creates the socket file, it is not removed when the Socket closes
+     * 
+     * @param path the path of the socket file
+     * @return Endpoint the Unix Endpoint
+     * @throws InvalidAddressException if the path is empty, contains a NUL byte or is too long
+     */
+    static Endpoint unixPath(std::string_view path);
+
+    /**
+     * @brief   Create a Unix Endpoint in the (Linux) abstract namespace
+     * @details Abstract addresses have no file, they disappear with the last Socket using them.
+     * 
+     * @param name the name, without the leading NUL byte
+     * @return Endpoint the Unix Endpoint
+     * @throws InvalidAddressException if the name is too long
      */
-    ~Endpoint();
+    static Endpoint unixAbstract(std::string_view name);
 
     /**
      * @brief Get the AddressFamily of the Endpoint
@@ -84,6 +141,13 @@ public:
      */
     AddressFamily getAddressFamily() const;
 
+    /**
+     * @brief Check if the Endpoint holds an address
+     * 
+     * @return true if the Endpoint is not the unspecified Endpoint
+     */
+    bool isSpecified() const;
+
     /**
      * @brief Get the Port of the Endpoint
      * 
@@ -91,6 +155,21 @@ public:
      */
     int getPort() const;
 
+    /**
+     * @brief Get the path (or abstract name) of a Unix Endpoint
+     * 
+     * @return std::string the path, the abstract name without the leading NUL,
+     *         or an empty string for unnamed and non-Unix Endpoints
+     */
+    std::string getPath() const;
+
+    /**
+     * @brief Check if the Endpoint is a Unix Endpoint in the abstract namespace
+     * 
+     * @return true if the Endpoint is an abstract Unix Endpoint
+     */
+    bool isAbstract() const;
+
     /**
      * @brief get the sockaddr* of the Endpoint
      * 
@@ -105,6 +184,43 @@ public:
      */
     socklen_t c_size() const;
 
+    /**
+     * @brief   Format the Endpoint as "address:port" ("[address]:port" for IPv6)
+     * @note    Unix Endpoints are formatted as their path, "@name" in the abstract namespace
+     *          or "unnamed". The unspecified Endpoint is formatted as "unspecified"
+     * 
+     * @return std::string the formatted Endpoint
+     */
+    std::string toString() const;
+
+    /**
+     * @brief   Get a hash of the address and port
+     * 
+     * @return size_t the hash
+     */
+    size_t hash() const noexcept;
+
+    /**
+     * @brief   Compare address family, address, port (and IPv6 scope) or Unix path
+     * @note    Fields the kernel ignores (like padding) do not take part
+     */
+    bool operator==(const Endpoint& other) const noexcept;
+
+    /**
+     * @brief   Order by address family, then address, then port (Unix: abstract, then name)
+     */
+    std::strong_ordering operator<=>(const Endpoint& other) const noexcept;
+
 };
 
-} // namespace SocketSparrow
\ No newline at end of file
+} // namespace SocketSparrow
+
+/**
+ * @brief std::hash specialization so Endpoints can be used in unordered containers
+ */
+template<>
+struct std::hash<SocketSparrow::Endpoint> {
+    size_t operator()(const SocketSparrow::Endpoint& endpoint) const noexcept {
+        return endpoint.hash();
+    }
+};
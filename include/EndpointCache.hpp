@@ -0,0 +1,79 @@
+/**
+ * @file EndpointCache.hpp
+ * @author TL044CN
+ * @brief Small Cache interning shared Endpoints for SocketSparrow
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "Endpoint.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace SocketSparrow {
+
+    /**
+     * @brief   Hands out one shared Endpoint per address
+     * @details Keeps the most recently used addresses so repeat senders map to the
+     *          same std::shared_ptr<Endpoint> instead of allocating a new one for
+     *          every Packet. When full, the least recently used entry is replaced.
+     * @note    Meant for a handful of peers, lookups scan all entries.
+     */
+    class EndpointCache {
+    private:
+        struct Entry {
+            std::shared_ptr<Endpoint> endpoint;
+            uint64_t lastUse;
+        };
+
+        size_t mCapacity;
+        uint64_t mClock = 0;
+        std::vector<Entry> mEntries;
+
+    public:
+        /**
+         * @brief Construct a new Endpoint Cache
+         *
+         * @param capacity the maximum number of cached Endpoints
+         * @throws SocketException if capacity is 0
+         */
+        explicit EndpointCache(size_t capacity);
+
+        /**
+         * @brief   Get the shared Endpoint for an address
+         *
+         * @param endpoint the address to look up
+         * @return std::shared_ptr<Endpoint> the cached Endpoint, created if it was not cached
+         * @throws InvalidAddressException if the Endpoint is unspecified
+         */
+        std::shared_ptr<Endpoint> intern(const Endpoint& endpoint);
+
+        /**
+         * @brief Get the number of cached Endpoints
+         *
+         * @return size_t the number of Endpoints
+         */
+        size_t size() const;
+
+        /**
+         * @brief Get the maximum number of cached Endpoints
+         *
+         * @return size_t the capacity
+         */
+        size_t capacity() const;
+
+        /**
+         * @brief Remove all Endpoints from the Cache
+         */
+        void clear();
+    };
+
+} // namespace SocketSparrow
@@ -11,6 +11,7 @@
 
 #pragma once
 #include <arpa/inet.h>
+#include <cstdint>
 
 namespace SocketSparrow {
 
@@ -20,7 +21,8 @@ namespace SocketSparrow {
     enum class AddressFamily {
         Unknown = AF_UNSPEC, ///< Unknown Address Family
         IPv4    = AF_INET,   ///< Internet Protocol Version 4
-        IPv6    = AF_INET6   ///< Internet Protocol Version 6
+        IPv6    = AF_INET6,  ///< Internet Protocol Version 6
+        Unix    = AF_UNIX    ///< Unix Domain Sockets (local IPC)
     };
 
     /**
@@ -29,6 +31,7 @@ namespace SocketSparrow {
     enum class SocketType {
         TCP         = SOCK_STREAM,///< TCP (Transmission Control Protocol)
         UDP         = SOCK_DGRAM, ///< UDP (User Datagram Protocol)
+        SeqPacket   = SOCK_SEQPACKET, ///< Connection oriented, message preserving (Unix Domain Sockets)
         Unknown     = SOCK_RAW,   ///< Unknown Protocol
         Stream      = TCP,        ///< TCP (Transmission Control Protocol)
         Datagram    = UDP         ///< UDP (User Datagram Protocol)
@@ -46,4 +49,57 @@ namespace SocketSparrow {
         Unknown      ///< Unknown State
     };
 
+    /**
+     * @brief How much a growing receive reads
+     * @see SocketSparrow::RecvOptions
+     */
+    enum class RecvMode {
+        Once,            ///< Wait for data once, then take whatever else is already queued
+        UntilWouldBlock, ///< Keep reading until the Socket would block or the peer closed
+        Exact            ///< Read exactly RecvOptions::exactSize bytes (MSG_WAITALL)
+    };
+
+    /**
+     * @brief I/O Readiness Events of a Network Socket
+     * @note  Events can be combined with operator|
+     */
+    enum class IOEvent : uint32_t {
+        None    = 0,      ///< No Event
+        Read    = 1 << 0, ///< Socket is readable (or has a pending connection)
+        Write   = 1 << 1, ///< Socket is writable
+        HangUp  = 1 << 2, ///< Remote Endpoint closed the connection
+        Error   = 1 << 3  ///< An error is pending on the Socket
+    };
+
+    constexpr IOEvent operator|(IOEvent lhs, IOEvent rhs) {
+        return static_cast<IOEvent>(static_cast<uint32_t>(lhs) | static_cast<uint32_t>(rhs));
+    }
+
+    constexpr IOEvent operator&(IOEvent lhs, IOEvent rhs) {
+        return static_cast<IOEvent>(static_cast<uint32_t>(lhs) & static_cast<uint32_t>(rhs));
+    }
+
+    constexpr IOEvent& operator|=(IOEvent& lhs, IOEvent rhs) {
+        return lhs = lhs | rhs;
+    }
+
+    /**
+     * @brief Check if a set of IOEvents contains any of the given flags
+     * 
+     * @param events the set of events
+     * @param flags the flags to look for
+     * @return true if at least one of the flags is set
+     */
+    constexpr bool hasEvent(IOEvent events, IOEvent flags) {
+        return (events & flags) != IOEvent::None;
+    }
+
+    /**
+     * @brief Trigger Mode of a Socket registered with a Reactor
+     */
+    enum class TriggerMode {
+        Level,  ///< Notify as long as the Socket is ready
+        Edge    ///< Notify only when the readiness changes
+    };
+
 } // namespace SocketSparrow
\ No newline at end of file
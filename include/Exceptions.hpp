@@ -136,6 +136,8 @@ public:
  *        This is the base class for all Socket Exceptions
  */
 class SocketException : public SocketSparrowException {
+protected:
+    int mErrorCode = 0;
 public:
     /**
      * @brief Construct a new Socket Exception object
@@ -157,6 +159,13 @@ public:
      */
     explicit SocketException(int error, const std::string& message = "Socket Exception");
 
+    /**
+     * @brief Get the error code the Exception was constructed with
+     *
+     * @return int the errno value, 0 if the error did not come from a system call
+     */
+    int getErrorCode() const noexcept;
+
 };
 
 /**
@@ -0,0 +1,132 @@
+/**
+ * @file Framer.hpp
+ * @author TL044CN
+ * @brief Message Framing for stream Sockets
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "BufferedSocket.hpp"
+#include "Socket.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+
+namespace SocketSparrow {
+
+    /**
+     * @brief Encoding of the length in front of every frame
+     */
+    enum class LengthPrefix {
+        U16,    ///< 2 byte unsigned integer
+        U32,    ///< 4 byte unsigned integer
+        Varint  ///< unsigned LEB128 (7 bits per byte, low bits first), ByteOrder does not apply
+    };
+
+    /**
+     * @brief Byte order of fixed size length prefixes
+     */
+    enum class ByteOrder {
+        BigEndian,      ///< most significant byte first (network byte order)
+        LittleEndian    ///< least significant byte first
+    };
+
+    /**
+     * @brief A complete frame found by Framer::decode()
+     */
+    struct Frame {
+        std::span<const std::byte> payload; ///< the message, a view into the decoded data
+        size_t size;                        ///< the bytes the frame takes up, including prefix or delimiter
+    };
+
+    /**
+     * @brief   Splits a byte stream into messages and writes messages as frames
+     * @details Frames are either length prefixed or ended by a delimiter. Decoding never copies,
+     *          payloads are views into the receive buffer. Encoding sends prefix, payload and
+     *          delimiter with one vectored send, without concatenating them.
+     * @note    A Framer keeps the delimiter search position between decode() calls,
+     *          so every stream needs its own Framer.
+     */
+    class Framer {
+    private:
+        LengthPrefix mPrefix = LengthPrefix::U32;
+        ByteOrder mByteOrder = ByteOrder::BigEndian;
+        std::string mDelimiter;
+        size_t mMaxFrameSize;
+        size_t mSearched = 0;   // bytes already searched for the delimiter
+
+        Framer(size_t maxFrameSize);
+
+        std::optional<Frame> decodePrefixed(std::span<const std::byte> data) const;
+        std::optional<Frame> decodeDelimited(std::span<const std::byte> data);
+
+    public:
+        /**
+         * @brief Create a Framer for length prefixed frames
+         *
+         * @param prefix the encoding of the length
+         * @param order the byte order of U16 and U32 prefixes
+         * @param maxFrameSize the largest accepted payload, capped at the largest length the prefix can express
+         * @return Framer the Framer
+         */
+        static Framer lengthPrefixed(LengthPrefix prefix, ByteOrder order = ByteOrder::BigEndian, size_t maxFrameSize = 16 * 1024 * 1024);
+
+        /**
+         * @brief Create a Framer for frames ended by a delimiter
+         *
+         * @param delimiter the bytes ending every frame, e.g. "\n" or "\r\n"
+         * @param maxFrameSize the largest accepted payload
+         * @return Framer the Framer
+         * @throws SocketException if the delimiter is empty
+         */
+        static Framer delimited(std::string delimiter, size_t maxFrameSize = 64 * 1024);
+
+        /**
+         * @brief   Find the first complete frame in data
+         * @details Call again with the same, grown, data while it returns std::nullopt.
+         *
+         * @param data the received bytes, starting at a frame boundary
+         * @return std::optional<Frame> the first frame, std::nullopt if it is not complete yet
+         * @throws SocketException if the frame exceeds the maximum frame size or the prefix is malformed
+         */
+        std::optional<Frame> decode(std::span<const std::byte> data);
+
+        /**
+         * @brief   Read the next frame through a BufferedSocketReader
+         * @note    The payload stays valid until the next call on the reader
+         *
+         * @param reader the reader of the stream, it has to hold a whole frame
+         * @return std::optional<std::span<const std::byte>> the payload, std::nullopt at end of stream
+         * @throws SocketException if the frame is invalid, does not fit into the reader
+         *         or the stream ends inside a frame
+         * @throws RecvError if receiving fails
+         */
+        std::optional<std::span<const std::byte>> readFrame(BufferedSocketReader& reader);
+
+        /**
+         * @brief   Send a payload as one frame with a single vectored send
+         *
+         * @param socket the Socket to send to
+         * @param payload the message, for delimiter framing it must not contain the delimiter
+         * @return ssize_t the number of bytes sent, including prefix or delimiter
+         * @throws SocketException if the payload exceeds the maximum frame size
+         * @throws SendError if sending fails
+         */
+        ssize_t writeFrame(const Socket& socket, std::span<const std::byte> payload) const;
+
+        /**
+         * @brief Get the largest accepted payload
+         *
+         * @return size_t the maximum frame size
+         */
+        size_t maxFrameSize() const;
+    };
+
+} // namespace SocketSparrow
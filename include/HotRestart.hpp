@@ -0,0 +1,131 @@
+/**
+ * @file HotRestart.hpp
+ * @author TL044CN
+ * @brief Listening Socket Hand-Over between Process Generations
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "Endpoint.hpp"
+#include "Socket.hpp"
+
+#include <functional>
+#include <initializer_list>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace SocketSparrow {
+
+    /**
+     * @brief A listening Socket received from the previous process
+     */
+    struct InheritedListener {
+        Socket socket;      ///< the listening Socket, sharing the accept queue with the previous process
+        Endpoint endpoint;  ///< the Endpoint the previous process had bound it to
+    };
+
+    /**
+     * @brief   Hands listening Sockets from a running process to its replacement
+     * @details The running process serves a Unix SeqPacket control Endpoint. On restart the
+     *          new process connects, receives every listening descriptor with SCM_RIGHTS and
+     *          starts accepting on them right away. The accept queues are shared, so no
+     *          connection is refused in between. Once it is ready, the new process asks the
+     *          old one to drain: stop accepting, finish its connections and exit.
+     *
+     *          Old process: listen() at startup, then handOver() when a successor connects.
+     *          New process: inherit(), start serving, drain(), then listen() for the next restart.
+     * @note    Abstract control Endpoints have no filesystem permissions, so both sides check
+     *          the peer's credentials: only processes running as the same effective user (or
+     *          as one of the allowed users) take part in a hand-over.
+     */
+    class HotRestart {
+    private:
+        Endpoint mControl;
+        std::vector<uid_t> mAllowedUids;
+        std::optional<Socket> mSocket;  // the control listener, or the connection to the previous process
+
+        /**
+         * @brief Check if the process on the other end of a control connection may take part in a hand-over
+         */
+        bool isTrusted(const Socket& connection) const;
+
+    public:
+        /**
+         * @brief Construct a new Hot Restart helper
+         *
+         * @param control the Unix Endpoint both process generations agree on
+         * @param allowedUids users trusted besides the effective user of this process
+         * @throws SocketException if control is not a Unix Endpoint
+         */
+        explicit HotRestart(const Endpoint& control, std::vector<uid_t> allowedUids = {});
+
+        /**
+         * @brief   Serve the control Endpoint, so a successor can find this process
+         * @note    A leftover socket file at a filesystem path is replaced, any other file is left alone
+         *
+         * @throws SocketException if binding or listening fails
+         */
+        void listen();
+
+        /**
+         * @brief   Get the control Socket, e.g. to wait for a successor with a Reactor
+         * @note    While listening, it becomes readable when a successor connects
+         *
+         * @return Socket& the control Socket
+         * @throws SocketException if neither listen() nor inherit() was called
+         */
+        Socket& controlSocket();
+
+        /**
+         * @brief   Accept the successor, pass it the listening descriptors and wait until it asks to drain
+         * @details Blocks until the successor connected and called drain() (or went away).
+         *          Afterwards this process should close its listeners and finish its connections.
+         *          Connections from untrusted users are closed without receiving anything,
+         *          and waiting continues.
+         *
+         * @param fds the listening descriptors to hand over, they stay open in this process
+         * @return true if the successor asked to drain, false if it disconnected before
+         * @throws SocketException if listen() was not called or a descriptor is not a bound Socket
+         * @throws SendError if sending fails
+         */
+        bool handOver(std::span<const int> fds);
+
+        /**
+         * @brief   Accept the successor, pass it the listening Sockets and wait until it asks to drain
+         *
+         * @param listeners the listening Sockets to hand over, they stay open in this process
+         * @return true if the successor asked to drain, false if it disconnected before
+         * @throws SocketException if listen() was not called
+         * @throws SendError if sending fails
+         */
+        bool handOver(std::initializer_list<std::reference_wrapper<const Socket>> listeners);
+
+        /**
+         * @brief   Connect to the running process and take over its listening Sockets
+         *
+         * @return std::vector<InheritedListener> the listeners, in the order they were handed over
+         * @throws SocketException if no process serves the control Endpoint, it runs as an untrusted
+         *         user or the hand-over is malformed
+         * @throws RecvError if receiving fails
+         */
+        std::vector<InheritedListener> inherit();
+
+        /**
+         * @brief   Tell the previous process to stop accepting and drain
+         * @note    Closes the connection to the previous process
+         *
+         * @throws SocketException if inherit() was not called
+         * @throws SendError if sending fails
+         */
+        void drain();
+    };
+
+} // namespace SocketSparrow
@@ -0,0 +1,150 @@
+/**
+ * @file IOResult.hpp
+ * @author TL044CN
+ * @brief Value-or-Error Result for the non-throwing SocketSparrow API
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "Exceptions.hpp"
+
+#include <cerrno>
+#include <optional>
+#include <system_error>
+#include <utility>
+
+namespace SocketSparrow {
+
+    /**
+     * @brief   Holds either the value of a successful operation or the error code of a failed one
+     * @details A small stand-in for std::expected, used by the try_ methods of Socket. Failures
+     *          like EAGAIN are part of the normal flow on non-blocking Sockets, so they are
+     *          returned instead of thrown.
+     *
+     * @tparam T the type of the value
+     */
+    template<typename T>
+    class IOResult {
+    private:
+        std::optional<T> mValue;
+        std::error_code mError;
+
+    public:
+        /**
+         * @brief Construct a successful IOResult
+         *
+         * @param value the value
+         */
+        IOResult(T value) : mValue(std::move(value)) {}
+
+        /**
+         * @brief Construct a failed IOResult
+         *
+         * @param error the error code
+         */
+        IOResult(std::error_code error) : mError(error) {}
+
+        /**
+         * @brief   Construct a failed IOResult from an errno value
+         *
+         * @param error the errno value
+         * @return IOResult the failed IOResult
+         */
+        static IOResult fromErrno(int error) {
+            return IOResult(std::error_code(error, std::system_category()));
+        }
+
+        /**
+         * @brief Check if the operation succeeded
+         *
+         * @return true if the IOResult holds a value
+         */
+        bool ok() const noexcept { return mValue.has_value(); }
+
+        /**
+         * @brief Check if the operation succeeded
+         *
+         * @return true if the IOResult holds a value
+         */
+        explicit operator bool() const noexcept { return ok(); }
+
+        /**
+         * @brief   Check if the operation failed because it would have blocked
+         * @note    Retry once the Socket is ready, e.g. from a Reactor callback
+         *
+         * @return true if the error is EAGAIN or EWOULDBLOCK
+         */
+        bool wouldBlock() const noexcept {
+            return mError.category() == std::system_category()
+                && (mError.value() == EAGAIN || mError.value() == EWOULDBLOCK);
+        }
+
+        /**
+         * @brief Get the error of a failed operation
+         *
+         * @return std::error_code the error, empty if the operation succeeded
+         */
+        std::error_code error() const noexcept { return mError; }
+
+        /**
+         * @brief   Get the value of a successful operation
+         *
+         * @return T& the value
+         * @throws SocketException with the error if the operation failed
+         */
+        T& value() & {
+            if ( !mValue ) {
+                throw SocketException(mError.value(), "IOResult holds an error");
+            }
+            return *mValue;
+        }
+
+        /**
+         * @brief   Get the value of a successful operation
+         *
+         * @return const T& the value
+         * @throws SocketException with the error if the operation failed
+         */
+        const T& value() const & {
+            if ( !mValue ) {
+                throw SocketException(mError.value(), "IOResult holds an error");
+            }
+            return *mValue;
+        }
+
+        /**
+         * @brief   Take the value of a successful operation
+         *
+         * @return T the value
+         * @throws SocketException with the error if the operation failed
+         */
+        T value() && {
+            if ( !mValue ) {
+                throw SocketException(mError.value(), "IOResult holds an error");
+            }
+            return std::move(*mValue);
+        }
+
+        /**
+         * @brief Get the value, or a fallback if the operation failed
+         *
+         * @param fallback the value returned on failure
+         * @return T the value or the fallback
+         */
+        T value_or(T fallback) const & { return mValue ? *mValue : std::move(fallback); }
+
+        /**
+         * @brief Access the value of a successful operation, unchecked
+         */
+        T& operator*() & noexcept { return *mValue; }
+        const T& operator*() const & noexcept { return *mValue; }
+        T* operator->() noexcept { return &*mValue; }
+        const T* operator->() const noexcept { return &*mValue; }
+    };
+
+} // namespace SocketSparrow
@@ -0,0 +1,366 @@
+/**
+ * @file IoUring.hpp
+ * @author TL044CN
+ * @brief io_uring I/O Backend for SocketSparrow
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "Endpoint.hpp"
+#include "Socket.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace SocketSparrow {
+
+    /**
+     * @brief Result of an operation submitted to an IoUring
+     */
+    struct IoCompletion {
+        uint64_t userData = 0;                  ///< the user data passed when preparing the operation
+        int32_t result = 0;                     ///< bytes transferred or accepted descriptor, -errno on failure
+        bool more = false;                      ///< true if a multishot operation stays armed
+        std::span<const std::byte> buffer;      ///< received data for operations using provided buffers
+        const sockaddr* source = nullptr;       ///< peer address of accept and recvFrom operations
+        socklen_t sourceSize = 0;               ///< size of the peer address
+    };
+
+    /**
+     * @brief   Batched Socket I/O on top of io_uring
+     * @details Operations are prepared as submission queue entries and handed to the
+     *          kernel with a single system call by submit() or complete().
+     *          If SocketSparrow is built without SOCKETSPARROW_IO_URING, if the kernel does
+     *          not provide io_uring or if it does not support an operation, the operation is
+     *          queued instead. Multishot accept (kernel 5.19) and multishot receive (6.0)
+     *          are probed on their own, as they are flags of older operations. complete()
+     *          polls the queued Sockets and runs each operation with the plain, non-blocking
+     *          system call once its Socket is ready, so the order of prepare*() calls does
+     *          not matter, just like on the ring. Multishot operations stay armed the same way.
+     * @note    Buffers passed to prepare*() have to stay valid until their completion
+     *          has been reported. An IoUring must only be used by one thread at a time.
+     * @warning Registered Sockets are looked up by native handle. Unregister a Socket before
+     *          closing it, or a new Socket that gets the same handle targets the old file.
+     */
+    class IoUring {
+    public:
+        /**
+         * @brief Handler invoked for every completion
+         * @note  IoCompletion::buffer and IoCompletion::source are only valid during the call
+         */
+        using CompletionHandler = std::function<void(const IoCompletion& completion)>;
+
+    private:
+        enum class OperationType {
+            Accept,
+            Connect,
+            Send,
+            Recv,
+            SendMsg,
+            RecvMsg,
+            SendFixed,
+            RecvFixed,
+            ProvideBuffers,
+            Cancel
+        };
+
+        struct Operation {
+            OperationType type = OperationType::Send;
+            uint64_t userData = 0;
+            int fd = -1;
+            std::byte* data = nullptr;
+            size_t size = 0;
+            unsigned bufferIndex = 0;
+            uint16_t bufferGroup = 0;
+            uint16_t bufferId = 0;
+            uint32_t target = 0;    // the operation a cancel aims at
+            bool multishot = false;
+            bool internal = false;
+            bool active = false;    // allocated and not released yet
+            bool started = false;   // a queued fallback connect was issued and waits for writability
+            msghdr message = {};
+            iovec vector = {};
+            sockaddr_storage address = {};
+            socklen_t addressSize = 0;
+        };
+
+        struct BufferGroup {
+            uint16_t id = 0;
+            std::vector<std::byte> memory;
+            size_t bufferSize = 0;
+            size_t count = 0;
+            std::vector<uint16_t> free;
+        };
+
+        struct FallbackResult {
+            uint32_t operation;
+            int32_t result;
+            uint32_t flags;
+        };
+
+        int mRing = -1;
+        unsigned mEntries = 0;
+        unsigned mToSubmit = 0;
+
+        void* mSqRing = nullptr;
+        size_t mSqRingSize = 0;
+        void* mCqRing = nullptr;
+        size_t mCqRingSize = 0;
+        io_uring_sqe* mSqes = nullptr;
+        size_t mSqesSize = 0;
+
+        unsigned* mSqHead = nullptr;
+        unsigned* mSqTail = nullptr;
+        unsigned mSqMask = 0;
+        unsigned* mCqHead = nullptr;
+        unsigned* mCqTail = nullptr;
+        unsigned mCqMask = 0;
+        io_uring_cqe* mCqes = nullptr;
+
+        std::vector<bool> mSupported;
+        bool mMultishotAccept = false;  // IORING_ACCEPT_MULTISHOT, kernel 5.19
+        bool mMultishotRecv = false;    // IORING_RECV_MULTISHOT, kernel 6.0
+        bool mBuffersRegistered = false;
+        std::vector<int> mFixedFiles;   // native handle -> registered file index
+        size_t mFixedFileSlots = 0;
+        std::vector<int> mFreeFixedFiles;
+
+        std::deque<Operation> mOperations;   // deque keeps msghdr addresses stable
+        std::vector<uint32_t> mFreeOperations;
+        std::vector<uint32_t> mFallbackPending;     // operations waiting for their Socket to become ready
+        std::vector<pollfd> mFallbackPoll;
+        std::vector<FallbackResult> mFallbackResults;
+        std::vector<BufferGroup> mBufferGroups;
+        size_t mInFlight = 0;
+
+        void setupRing(unsigned entries);
+        bool probeMultishot(uint8_t opcode, uint16_t multishotFlag, uint8_t sqeFlags);
+        void teardownRing();
+
+        uint32_t allocateOperation(OperationType type, uint64_t userData, int fd);
+        void releaseOperation(uint32_t index);
+
+        bool ringSupports(OperationType type) const;
+        void enqueue(uint32_t index);
+        io_uring_sqe* nextSqe();
+        bool attemptFallback(uint32_t index);
+        void runFallbacks(bool block, bool withRing);
+        BufferGroup* findBufferGroup(uint16_t group);
+        void recycleBuffer(uint16_t group, uint16_t id);
+        void finish(uint32_t index, int32_t result, uint32_t flags, const CompletionHandler& handler);
+
+    public:
+        /**
+         * @brief Construct a new IoUring
+         *
+         * @param entries size of the submission queue
+         * @throws SocketException if the ring exists but mapping it fails
+         */
+        explicit IoUring(unsigned entries = 256);
+
+        IoUring(const IoUring&) = delete;
+        IoUring& operator=(const IoUring&) = delete;
+
+        /**
+         * @brief Destroy the IoUring. Operations still in flight are cancelled.
+         */
+        ~IoUring();
+
+        /**
+         * @brief   Check if io_uring is compiled in and provided by the running kernel
+         *
+         * @return true if an IoUring will use a ring
+         */
+        static bool isAvailable();
+
+        /**
+         * @brief   Check if this instance submits through a ring or uses the plain system calls
+         *
+         * @return true if a ring is used
+         */
+        bool usesRing() const;
+
+        /**
+         * @brief   Register buffers for use with prepareSendFixed() and prepareRecvFixed()
+         * @note    Replaces previously registered buffers
+         *
+         * @param buffers the memory regions to register
+         * @return true if the buffers were registered with the kernel, false if the plain path is used
+         */
+        bool registerBuffers(std::span<const iovec> buffers);
+
+        /**
+         * @brief   Register a Socket as fixed file, saving a descriptor lookup per operation
+         * @details Operations on a registered Socket use its fixed file index automatically.
+         * @warning The registration is keyed by the native handle and outlives the Socket: call
+         *          unregisterSocket() before the Socket is closed. Otherwise the ring keeps the old
+         *          file open, and operations on a later Socket reusing the handle go to that file.
+         *
+         * @param socket the Socket to register
+         * @return true if the Socket was registered with the kernel
+         */
+        bool registerSocket(const Socket& socket);
+
+        /**
+         * @brief   Remove a Socket from the fixed file table
+         * @note    Has to be called while the Socket is still open, see registerSocket()
+         *
+         * @param socket the registered Socket
+         */
+        void unregisterSocket(const Socket& socket);
+
+        /**
+         * @brief   Allocate a group of buffers the kernel picks from for multishot receives
+         *
+         * @param group the buffer group id
+         * @param count number of buffers in the group
+         * @param size size of every buffer
+         * @throws SocketException if the group already exists or the parameters are invalid
+         */
+        void provideBuffers(uint16_t group, size_t count, size_t size);
+
+        /**
+         * @brief   Prepare accepting a connection
+         * @note    the result is the native handle of the accepted connection, owned by the caller
+         *
+         * @param socket the listening Socket
+         * @param userData value reported with the completion
+         * @param multishot keep accepting until cancelled with prepareCancel() or an error occurs
+         *                  (no peer address is reported)
+         */
+        void prepareAccept(Socket& socket, uint64_t userData, bool multishot = false);
+
+        /**
+         * @brief   Prepare connecting a Socket
+         *
+         * @param socket the Socket to connect
+         * @param endpoint the Endpoint to connect to (copied)
+         * @param userData value reported with the completion
+         */
+        void prepareConnect(Socket& socket, const Endpoint& endpoint, uint64_t userData);
+
+        /**
+         * @brief   Prepare sending data on a connected Socket
+         *
+         * @param socket the Socket to send on
+         * @param data the data to send
+         * @param userData value reported with the completion
+         */
+        void prepareSend(Socket& socket, std::span<const std::byte> data, uint64_t userData);
+
+        /**
+         * @brief   Prepare receiving data from a connected Socket
+         *
+         * @param socket the Socket to receive from
+         * @param buffer the buffer to receive into
+         * @param userData value reported with the completion
+         */
+        void prepareRecv(Socket& socket, std::span<std::byte> buffer, uint64_t userData);
+
+        /**
+         * @brief   Prepare a multishot receive that picks buffers from a provided buffer group
+         * @details The receive stays armed until the peer closes the connection, an error occurs
+         *          or it is cancelled with prepareCancel().
+         * @note    The data is reported in IoCompletion::buffer and recycled after the handler returns
+         *
+         * @param socket the Socket to receive from
+         * @param group a buffer group set up with provideBuffers()
+         * @param userData value reported with every completion
+         * @throws SocketException if the buffer group does not exist
+         */
+        void prepareRecvMultishot(Socket& socket, uint16_t group, uint64_t userData);
+
+        /**
+         * @brief   Prepare sending a datagram
+         *
+         * @param socket the UDP Socket to send on
+         * @param data the data to send
+         * @param endpoint the destination (copied)
+         * @param userData value reported with the completion
+         */
+        void prepareSendTo(Socket& socket, std::span<const std::byte> data, const Endpoint& endpoint, uint64_t userData);
+
+        /**
+         * @brief   Prepare receiving a datagram together with its sender
+         *
+         * @param socket the UDP Socket to receive from
+         * @param buffer the buffer to receive into
+         * @param userData value reported with the completion
+         */
+        void prepareRecvFrom(Socket& socket, std::span<std::byte> buffer, uint64_t userData);
+
+        /**
+         * @brief   Prepare sending from a registered buffer
+         *
+         * @param socket the Socket to send on
+         * @param bufferIndex index of the registered buffer containing data
+         * @param data the data to send
+         * @param userData value reported with the completion
+         */
+        void prepareSendFixed(Socket& socket, unsigned bufferIndex, std::span<const std::byte> data, uint64_t userData);
+
+        /**
+         * @brief   Prepare receiving into a registered buffer
+         *
+         * @param socket the Socket to receive from
+         * @param bufferIndex index of the registered buffer containing buffer
+         * @param buffer the buffer to receive into
+         * @param userData value reported with the completion
+         */
+        void prepareRecvFixed(Socket& socket, unsigned bufferIndex, std::span<std::byte> buffer, uint64_t userData);
+
+        /**
+         * @brief   Prepare cancelling every operation in flight that was prepared with userData
+         * @details Each cancelled operation completes with -ECANCELED and more unset, unless it
+         *          completed before the cancellation reached it. The cancel itself reports nothing.
+         *          Multishot operations have to be cancelled before their Socket is closed, the
+         *          ring keeps its own reference to the file and would go on accepting or receiving.
+         *
+         * @param userData the user data of the operations to cancel
+         */
+        void prepareCancel(uint64_t userData);
+
+        /**
+         * @brief   Hand all prepared operations to the kernel with one system call
+         *
+         * @return unsigned the number of submitted operations
+         * @throws SocketException if submitting fails
+         */
+        unsigned submit();
+
+        /**
+         * @brief   Submit prepared operations and dispatch completions
+         * @note    The handler may prepare new operations but must not call complete()
+         *
+         * @param handler the handler to invoke for every completion
+         * @param waitFor the minimum number of completions to wait for
+         * @return size_t the number of dispatched completions
+         * @throws SocketException if waiting fails
+         */
+        size_t complete(const CompletionHandler& handler, unsigned waitFor = 0);
+
+        /**
+         * @brief   Get the number of operations that have not completed yet
+         *
+         * @return size_t number of operations in flight
+         */
+        size_t inFlight() const;
+    };
+
+} // namespace SocketSparrow
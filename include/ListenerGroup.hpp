@@ -0,0 +1,142 @@
+/**
+ * @file ListenerGroup.hpp
+ * @author TL044CN
+ * @brief Thread-per-core SO_REUSEPORT Listeners for SocketSparrow
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "Endpoint.hpp"
+#include "Reactor.hpp"
+#include "Socket.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace SocketSparrow {
+
+    /**
+     * @brief   Accepts TCP connections on one Endpoint with one listening Socket per worker thread
+     * @details Every worker owns a listening Socket bound with SO_REUSEPORT and a Reactor running
+     *          on its own thread. The kernel spreads incoming connections over the listeners,
+     *          so there is no shared accept queue and no lock between the workers.
+     *          Every wakeup drains the accept queue with Socket::acceptMany(). Accepted connections
+     *          are non-blocking and handed to the callback on the worker that accepted them,
+     *          where they can be added to that worker's Reactor.
+     *          Every running worker keeps a spare descriptor: when accepting fails because the
+     *          process or system is out of descriptors (EMFILE, ENFILE), the spare is closed to accept
+     *          the pending connection and close it right away, so the listener does not stay readable
+     *          and spin its worker. Other accept errors leave the connection queued for the next try.
+     */
+    class ListenerGroup {
+    public:
+        /**
+         * @brief   Callback invoked on a worker thread for every accepted connection
+         * @note    The connection is only valid during the call, move it to keep it
+         */
+        using AcceptCallback = std::function<void(Socket&& connection, Reactor& reactor, size_t worker)>;
+
+        /**
+         * @brief Configuration of a ListenerGroup
+         */
+        struct Options {
+            size_t workers = 0;         ///< number of listeners and threads, 0 for one per CPU
+            int backlog = 1024;         ///< accept queue length of every listener
+            bool pinWorkers = false;    ///< pin worker i to CPU i (modulo the CPU count), best effort
+            bool steerByCpu = false;    ///< attach a CBPF program sending connections to listener (CPU % workers)
+        };
+
+    private:
+        static constexpr size_t AcceptBatch = 64;   // connections taken per wakeup
+
+        struct Worker {
+            std::unique_ptr<Socket> listener;
+            std::unique_ptr<Reactor> reactor;
+            std::vector<AcceptedConnection> accepted;
+            int reserve = -1;   // spare descriptor while running, given up to shed a connection
+            std::thread thread;
+        };
+
+        Endpoint mEndpoint;
+        AcceptCallback mCallback;
+        Options mOptions;
+        std::vector<Worker> mWorkers;
+
+        void attachSteeringProgram();
+        void shedConnection(Worker& worker);
+        void runWorker(size_t index);
+
+    public:
+        /**
+         * @brief   Construct a new Listener Group and start listening
+         * @note    The worker threads are started by start()
+         *
+         * @param endpoint the Endpoint to listen on, port 0 picks one port for all listeners
+         * @param callback invoked for every accepted connection
+         * @param options number of workers, backlog, pinning and steering
+         * @throws SocketException if creating, binding or configuring a listener fails
+         */
+        ListenerGroup(const Endpoint& endpoint, AcceptCallback callback, Options options);
+
+        /**
+         * @brief   Construct a new Listener Group with default Options and start listening
+         *
+         * @param endpoint the Endpoint to listen on, port 0 picks one port for all listeners
+         * @param callback invoked for every accepted connection
+         * @throws SocketException if creating, binding or configuring a listener fails
+         */
+        ListenerGroup(const Endpoint& endpoint, AcceptCallback callback);
+
+        ListenerGroup(const ListenerGroup&) = delete;
+        ListenerGroup& operator=(const ListenerGroup&) = delete;
+
+        /**
+         * @brief Stop and join all workers
+         */
+        ~ListenerGroup();
+
+        /**
+         * @brief   Start one thread per worker running its Reactor
+         * @throws SocketException if the group is already running
+         */
+        void start();
+
+        /**
+         * @brief   Stop all Reactors and join the worker threads
+         * @note    Connections still in the accept queues stay there until start() is called again
+         */
+        void stop();
+
+        /**
+         * @brief Get the number of workers
+         *
+         * @return size_t the number of listeners and threads
+         */
+        size_t size() const;
+
+        /**
+         * @brief   Get the Endpoint the listeners are bound to
+         *
+         * @return const Endpoint& the Endpoint, with the chosen port if port 0 was requested
+         */
+        const Endpoint& endpoint() const;
+
+        /**
+         * @brief   Get the Reactor of a worker, e.g. to register more Sockets before start()
+         *
+         * @param worker the index of the worker
+         * @return Reactor& the worker's Reactor
+         * @throws SocketException if the index is out of range
+         */
+        Reactor& reactor(size_t worker);
+    };
+
+} // namespace SocketSparrow
@@ -0,0 +1,130 @@
+/**
+ * @file MulticastPublisher.hpp
+ * @author TL044CN
+ * @brief Batching Multicast Sender for SocketSparrow
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "Endpoint.hpp"
+#include "PacketBatch.hpp"
+#include "Socket.hpp"
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace SocketSparrow {
+
+    /**
+     * @brief   Publishes datagrams to one or more multicast groups
+     * @details Every published payload is sent once per group, however many subscribers
+     *          joined it, instead of once per subscriber. Datagrams are queued in a
+     *          PacketBatch and leave with a single sendmmsg() when the batch is full or
+     *          flush() is called, so a burst of updates costs one system call.
+     */
+    class MulticastPublisher {
+    public:
+        /**
+         * @brief Configuration of a MulticastPublisher
+         */
+        struct Options {
+            int ttl = 1;                    ///< multicast TTL / hop limit, 1 stays on the local network
+            bool loop = true;               ///< deliver to subscribers on this host as well
+            unsigned interfaceIndex = 0;    ///< interface to send out of (see if_nametoindex), 0 follows the routes
+            size_t batchSize = 32;          ///< datagrams queued before they are sent
+            size_t packetSize = 1472;       ///< largest payload, the default fits an Ethernet frame
+        };
+
+    private:
+        Socket mSocket;
+        std::vector<Endpoint> mGroups;
+        PacketBatch mBatch;
+
+    public:
+        /**
+         * @brief   Construct a new Multicast Publisher
+         *
+         * @param groups the groups (address and port) every payload is sent to
+         * @param options TTL, loopback, interface and batching
+         * @throws SocketException if groups is empty, mixes Address Families, does not fit
+         *         a batch or configuring the Socket fails
+         */
+        MulticastPublisher(std::vector<Endpoint> groups, Options options);
+
+        /**
+         * @brief   Construct a new Multicast Publisher for a single group with default Options
+         *
+         * @param group the group (address and port) every payload is sent to
+         * @throws SocketException if configuring the Socket fails
+         */
+        explicit MulticastPublisher(const Endpoint& group);
+
+        MulticastPublisher(const MulticastPublisher&) = delete;
+        MulticastPublisher& operator=(const MulticastPublisher&) = delete;
+
+        /**
+         * @brief   Destroy the Multicast Publisher, sending what is still queued
+         * @note    Errors while sending are ignored, what could not be sent is lost
+         */
+        ~MulticastPublisher();
+
+        /**
+         * @brief   Queue a payload for every group, sending the batch first if it has no room left
+         *
+         * @param data the payload, copied into the batch
+         * @throws SocketException if the payload is larger than Options::packetSize
+         * @throws SendError if sending a full batch fails or leaves no room for the payload
+         */
+        void publish(std::span<const std::byte> data);
+
+        /**
+         * @brief   Queue a payload for every group, sending the batch first if it has no room left
+         *
+         * @param data the payload, copied into the batch
+         * @throws SocketException if the payload is larger than Options::packetSize
+         * @throws SendError if sending a full batch fails or leaves no room for the payload
+         */
+        void publish(std::string_view data);
+
+        /**
+         * @brief   Send all queued datagrams
+         * @details Datagrams that were not sent because a non-blocking Socket would block
+         *          or the send queue was full (ENOBUFS) stay queued for the next flush().
+         *          A datagram failing with any other error (e.g. an unroutable group) is
+         *          dropped, so it cannot hold back the datagrams queued behind it.
+         *
+         * @return size_t the number of datagrams sent
+         * @throws SendError if sending fails, after dropping the failed datagram unless it was ENOBUFS
+         */
+        size_t flush();
+
+        /**
+         * @brief Get the number of datagrams waiting for flush()
+         *
+         * @return size_t number of queued datagrams
+         */
+        size_t pending() const;
+
+        /**
+         * @brief Get the groups payloads are sent to
+         *
+         * @return const std::vector<Endpoint>& the groups
+         */
+        const std::vector<Endpoint>& groups() const;
+
+        /**
+         * @brief   Get the sending Socket, e.g. to bind it to a source address
+         *
+         * @return Socket& the UDP Socket
+         */
+        Socket& socket();
+    };
+
+} // namespace SocketSparrow
@@ -0,0 +1,197 @@
+/**
+ * @file PacketBatch.hpp
+ * @author TL044CN
+ * @brief Preallocated Batch of UDP Packets for SocketSparrow
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "Endpoint.hpp"
+#include "UDPPacket.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <sys/socket.h>
+
+namespace SocketSparrow {
+
+    class Socket;
+
+    /**
+     * @brief   Fixed number of preallocated UDP Packet slots
+     * @details All slots share one contiguous buffer together with the message headers
+     *          and source addresses the kernel needs, so a Batch can be received into or
+     *          sent from over and over again without allocating.
+     *          Used with Socket::recvBatch() and Socket::sendBatch() to move many
+     *          Packets with a single syscall.
+     */
+    class PacketBatch {
+    private:
+        size_t mCapacity;
+        size_t mPacketSize;
+        size_t mSize = 0;
+
+        std::vector<char> mStorage;
+        std::vector<iovec> mIovecs;
+        std::vector<sockaddr_storage> mAddresses;
+        mutable std::vector<mmsghdr> mMessages;   // msg_len is written by the kernel
+
+        friend class Socket;
+
+        /**
+         * @brief reset all slots so they can be received into
+         */
+        void prepareRecv();
+
+        /**
+         * @brief take over the lengths after count messages were received
+         */
+        void finishRecv(size_t count);
+
+    public:
+        /**
+         * @brief Construct a new Packet Batch
+         *
+         * @param capacity the number of Packet slots
+         * @param packetSize the size of every slot, larger datagrams are truncated
+         * @throws SocketException if capacity or packetSize is 0
+         */
+        explicit PacketBatch(size_t capacity = 32, size_t packetSize = MAX_UDP_PACKET_SIZE);
+
+        PacketBatch(const PacketBatch&) = delete;
+        PacketBatch& operator=(const PacketBatch&) = delete;
+
+        PacketBatch(PacketBatch&&) = default;
+        PacketBatch& operator=(PacketBatch&&) = default;
+
+        /**
+         * @brief Get the number of Packet slots
+         *
+         * @return size_t number of slots
+         */
+        size_t capacity() const;
+
+        /**
+         * @brief Get the size of a single Packet slot
+         *
+         * @return size_t size of a slot in bytes
+         */
+        size_t packetSize() const;
+
+        /**
+         * @brief Get the number of Packets in the Batch
+         *
+         * @return size_t number of Packets
+         */
+        size_t size() const;
+
+        /**
+         * @brief Check if the Batch contains no Packets
+         *
+         * @return true if the Batch is empty
+         */
+        bool empty() const;
+
+        /**
+         * @brief Check if every slot of the Batch is in use
+         *
+         * @return true if the Batch is full
+         */
+        bool full() const;
+
+        /**
+         * @brief Remove all Packets, the slots are kept
+         */
+        void clear();
+
+        /**
+         * @brief   Remove the first Packets, e.g. the ones a partial send got out
+         * @details The remaining Packets move to the front and keep their order.
+         *
+         * @param count the number of Packets to remove, at most size()
+         * @throws SocketException if count is larger than size()
+         */
+        void drop(size_t count);
+
+        /**
+         * @brief   Append a Packet to send to an Endpoint
+         *
+         * @param data the payload, copied into the next slot
+         * @param endpoint the destination of the Packet
+         * @throws SocketException if the Batch is full or the payload does not fit a slot
+         */
+        void push(std::span<const char> data, const Endpoint& endpoint);
+
+        /**
+         * @brief   Append a Packet to send on a connected Socket
+         *
+         * @param data the payload, copied into the next slot
+         * @throws SocketException if the Batch is full or the payload does not fit a slot
+         */
+        void push(std::span<const char> data);
+
+        /**
+         * @brief   Get the payload of a Packet
+         * @note    The span stays valid until the Batch is received into again
+         *
+         * @param index the index of the Packet
+         * @return std::span<const char> the payload
+         * @throws SocketException if the index is out of range
+         */
+        std::span<const char> data(size_t index) const;
+
+        /**
+         * @brief Check if a received Packet was larger than its slot
+         *
+         * @param index the index of the Packet
+         * @return true if the Packet was truncated
+         * @throws SocketException if the index is out of range
+         */
+        bool truncated(size_t index) const;
+
+        /**
+         * @brief   Get the raw source (or destination) address of a Packet
+         *
+         * @param index the index of the Packet
+         * @return const sockaddr* the address or nullptr if the Packet has none
+         * @throws SocketException if the index is out of range
+         */
+        const sockaddr* source(size_t index) const;
+
+        /**
+         * @brief Get the size of the raw source address of a Packet
+         *
+         * @param index the index of the Packet
+         * @return socklen_t the size of the address
+         * @throws SocketException if the index is out of range
+         */
+        socklen_t sourceSize(size_t index) const;
+
+        /**
+         * @brief Get the source (or destination) Endpoint of a Packet
+         *
+         * @param index the index of the Packet
+         * @return Endpoint the Endpoint, unspecified if the Packet has none
+         * @throws SocketException if the index is out of range
+         */
+        Endpoint endpoint(size_t index) const;
+
+        /**
+         * @brief Copy a Packet out of the Batch
+         *
+         * @param index the index of the Packet
+         * @return UDPPacket the Packet
+         * @throws SocketException if the index is out of range
+         */
+        UDPPacket packet(size_t index) const;
+    };
+
+} // namespace SocketSparrow
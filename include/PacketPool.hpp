@@ -0,0 +1,226 @@
+/**
+ * @file PacketPool.hpp
+ * @author TL044CN
+ * @brief Pool of reusable UDP Packet Buffers for SocketSparrow
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "Endpoint.hpp"
+#include "UDPPacket.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include <sys/socket.h>
+
+namespace SocketSparrow {
+
+    class PacketPool;
+
+    /**
+     * @brief   Packet buffer borrowed from a PacketPool
+     * @details The buffer is handed back to its pool when the PooledPacket is destroyed
+     *          or reset(). PooledPackets can be moved freely between threads.
+     */
+    class PooledPacket {
+    private:
+        struct Slot {
+            char* data = nullptr;
+            size_t size = 0;
+            sockaddr_storage address;
+            socklen_t addressSize = 0;
+        };
+
+        PacketPool* mPool = nullptr;
+        Slot* mSlot = nullptr;
+
+        friend class PacketPool;
+        friend class Socket;
+
+        PooledPacket(PacketPool* pool, Slot* slot);
+
+    public:
+        /**
+         * @brief Construct an empty PooledPacket
+         */
+        PooledPacket() = default;
+
+        PooledPacket(const PooledPacket&) = delete;
+        PooledPacket& operator=(const PooledPacket&) = delete;
+
+        PooledPacket(PooledPacket&& other) noexcept;
+        PooledPacket& operator=(PooledPacket&& other) noexcept;
+
+        /**
+         * @brief Return the buffer to its pool
+         */
+        ~PooledPacket();
+
+        /**
+         * @brief Return the buffer to its pool now, leaving the PooledPacket empty
+         */
+        void reset();
+
+        /**
+         * @brief Check if the PooledPacket holds a buffer
+         *
+         * @return true if it holds a buffer
+         */
+        explicit operator bool() const;
+
+        /**
+         * @brief Get the payload
+         *
+         * @return std::span<const char> the first size() bytes of the buffer
+         */
+        std::span<const char> data() const;
+
+        /**
+         * @brief Get the whole buffer, e.g. to fill it before sending
+         *
+         * @return std::span<char> all capacity() bytes of the buffer
+         */
+        std::span<char> buffer();
+
+        /**
+         * @brief Get the size of the payload
+         *
+         * @return size_t the size in bytes
+         */
+        size_t size() const;
+
+        /**
+         * @brief Get the size of the buffer
+         *
+         * @return size_t the capacity in bytes
+         */
+        size_t capacity() const;
+
+        /**
+         * @brief Set the size of the payload
+         *
+         * @param size the new size
+         * @throws SocketException if the packet holds no buffer or the size exceeds the capacity
+         */
+        void resize(size_t size);
+
+        /**
+         * @brief   Get the raw address the Packet was received from
+         *
+         * @return const sockaddr* the address or nullptr if there is none
+         */
+        const sockaddr* source() const;
+
+        /**
+         * @brief Get the size of the raw source address
+         *
+         * @return socklen_t the size of the address
+         */
+        socklen_t sourceSize() const;
+
+        /**
+         * @brief Get the Endpoint the Packet was received from
+         *
+         * @return Endpoint the Endpoint, unspecified if there is none
+         */
+        Endpoint endpoint() const;
+    };
+
+    /**
+     * @brief   Preallocated slab of fixed size Packet buffers
+     * @details Buffers are kept on a shared free list and in small per thread caches.
+     *          Acquiring and releasing normally only touches the calling thread's cache,
+     *          the shared list is only locked to move half a cache worth of buffers at once.
+     *          When the shared list runs dry, buffers are taken from other threads' caches,
+     *          so buffers released on a long-lived thread are never stranded there.
+     * @note    The pool has to outlive all PooledPackets taken from it.
+     */
+    class PacketPool {
+    private:
+        struct Cache;
+        struct ThreadCaches;
+        static ThreadCaches& localCaches();
+
+        uint64_t mId;
+        size_t mPacketSize;
+        size_t mCacheSize;
+
+        std::vector<char> mStorage;
+        std::vector<PooledPacket::Slot> mSlots;
+
+        mutable std::mutex mMutex;      // taken before the mutex of any Cache
+        std::vector<PooledPacket::Slot*> mFree;
+        std::vector<Cache*> mCaches;    // the caches of all threads that used the pool
+
+        friend class PooledPacket;
+
+        Cache& localCache();
+        void release(PooledPacket::Slot* slot);
+        void releaseShared(std::vector<PooledPacket::Slot*>& slots, size_t count);
+        void steal(std::vector<PooledPacket::Slot*>& slots, const Cache& thief);
+        void unregister(Cache* cache);
+
+    public:
+        /**
+         * @brief Construct a new Packet Pool
+         *
+         * @param count the number of buffers
+         * @param packetSize the size of every buffer
+         * @param cacheSize the number of buffers each thread may keep for itself, 0 to disable caching
+         * @throws SocketException if count or packetSize is 0
+         */
+        explicit PacketPool(size_t count, size_t packetSize = MAX_UDP_PACKET_SIZE, size_t cacheSize = 32);
+
+        PacketPool(const PacketPool&) = delete;
+        PacketPool& operator=(const PacketPool&) = delete;
+
+        ~PacketPool();
+
+        /**
+         * @brief Borrow a buffer from the pool
+         *
+         * @return PooledPacket the buffer
+         * @throws SocketException if every buffer is in use
+         */
+        PooledPacket acquire();
+
+        /**
+         * @brief Borrow a buffer from the pool if one is left
+         *
+         * @return PooledPacket the buffer or an empty PooledPacket
+         */
+        PooledPacket tryAcquire();
+
+        /**
+         * @brief Get the number of buffers in the pool
+         *
+         * @return size_t the number of buffers
+         */
+        size_t capacity() const;
+
+        /**
+         * @brief Get the size of every buffer
+         *
+         * @return size_t the size in bytes
+         */
+        size_t packetSize() const;
+
+        /**
+         * @brief   Get the number of buffers not in use, on the shared free list or in thread caches
+         *
+         * @return size_t the number of free buffers
+         */
+        size_t available() const;
+    };
+
+} // namespace SocketSparrow
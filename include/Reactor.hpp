@@ -0,0 +1,217 @@
+/**
+ * @file Reactor.hpp
+ * @author TL044CN
+ * @brief epoll based Event Loop for SocketSparrow
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "Enums.hpp"
+#include "Socket.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <sys/epoll.h>
+
+namespace SocketSparrow {
+
+    /**
+     * @brief   Event Loop that dispatches readiness Events of many Sockets
+     * @details Sockets are registered together with the Events they are interested in
+     *          and either a Callback or a Handler object. A single thread calling
+     *          run() (or poll()) then drives all registered Sockets.
+     * @note    add(), modify() and remove() have to be called from the thread that runs
+     *          the Reactor (e.g. from within a Callback) or while it is not running.
+     *          stop() and wakeup() can be called from any thread.
+     */
+    class Reactor {
+    public:
+        /**
+         * @brief Callback invoked with the Socket and the Events that occurred
+         */
+        using Callback = std::function<void(Socket& socket, IOEvent events)>;
+
+        /**
+         * @brief   Handler object alternative to a Callback
+         * @details Every method defaults to doing nothing, so only the interesting
+         *          Events have to be overridden.
+         */
+        class Handler {
+        public:
+            virtual ~Handler() = default;
+
+            /**
+             * @brief called when the Socket is readable (or has a pending connection)
+             *
+             * @param socket the ready Socket
+             */
+            virtual void onReadable(Socket& /*socket*/) {}
+
+            /**
+             * @brief called when the Socket is writable
+             *
+             * @param socket the ready Socket
+             */
+            virtual void onWritable(Socket& /*socket*/) {}
+
+            /**
+             * @brief called when the remote Endpoint closed the connection
+             *
+             * @param socket the affected Socket
+             */
+            virtual void onHangUp(Socket& /*socket*/) {}
+
+            /**
+             * @brief called when an error is pending on the Socket
+             *
+             * @param socket the affected Socket
+             */
+            virtual void onError(Socket& /*socket*/) {}
+        };
+
+    private:
+        /**
+         * @brief Bookkeeping for a registered Socket
+         */
+        struct Registration {
+            Socket* socket = nullptr;
+            IOEvent interest = IOEvent::None;
+            TriggerMode mode = TriggerMode::Level;
+            Callback callback;
+            Handler* handler = nullptr;
+            uint64_t generation = 0;
+        };
+
+        int mEpoll = -1;
+        int mWakeup = -1;
+        std::atomic<bool> mStopRequested = false;
+        std::atomic<bool> mRunning = false;
+        size_t mRegistered = 0;
+        uint64_t mGeneration = 0;
+
+        // indexed by native handle, so lookups during dispatch are a single index
+        std::vector<Registration> mRegistrations;
+        std::vector<epoll_event> mEvents;
+
+        void registerSocket(Socket& socket, IOEvent interest, TriggerMode mode, Callback callback, Handler* handler);
+        void dispatch(int fd, IOEvent events);
+
+    public:
+        /**
+         * @brief Construct a new Reactor
+         *
+         * @param maxEvents maximum number of Events handled per poll()
+         * @throws SocketException if creating the epoll instance fails
+         */
+        explicit Reactor(size_t maxEvents = 256);
+
+        Reactor(const Reactor&) = delete;
+        Reactor& operator=(const Reactor&) = delete;
+
+        /**
+         * @brief Destroy the Reactor. Registered Sockets are not closed.
+         */
+        ~Reactor();
+
+        /**
+         * @brief   Register a Socket and dispatch its Events to a Callback
+         * @note    The Socket has to outlive its registration
+         *
+         * @param socket the Socket to watch
+         * @param interest the Events to watch for (HangUp and Error are always reported)
+         * @param callback the Callback to invoke
+         * @param mode Level or Edge triggered notification
+         * @throws SocketException if the Socket is already registered or registering fails
+         */
+        void add(Socket& socket, IOEvent interest, Callback callback, TriggerMode mode = TriggerMode::Level);
+
+        /**
+         * @brief   Register a Socket and dispatch its Events to a Handler object
+         * @note    The Socket and the Handler have to outlive the registration
+         *
+         * @param socket the Socket to watch
+         * @param interest the Events to watch for (HangUp and Error are always reported)
+         * @param handler the Handler to invoke
+         * @param mode Level or Edge triggered notification
+         * @throws SocketException if the Socket is already registered or registering fails
+         */
+        void add(Socket& socket, IOEvent interest, Handler& handler, TriggerMode mode = TriggerMode::Level);
+
+        /**
+         * @brief   Change the Events a registered Socket is interested in
+         *
+         * @param socket the registered Socket
+         * @param interest the new set of Events
+         * @throws SocketException if the Socket is not registered or modifying fails
+         */
+        void modify(Socket& socket, IOEvent interest);
+
+        /**
+         * @brief   Unregister a Socket
+         * @note    Safe to call from within the Socket's own Callback
+         *
+         * @param socket the registered Socket
+         * @throws SocketException if the Socket is not registered
+         */
+        void remove(Socket& socket);
+
+        /**
+         * @brief   Check if a Socket is registered
+         *
+         * @param socket the Socket to check
+         * @return true if the Socket is registered
+         */
+        bool contains(const Socket& socket) const;
+
+        /**
+         * @brief   Get the number of registered Sockets
+         *
+         * @return size_t number of registered Sockets
+         */
+        size_t size() const;
+
+        /**
+         * @brief   Wait for Events once and dispatch them
+         *
+         * @param timeoutMs maximum time to wait in milliseconds, -1 waits forever
+         * @return size_t the number of Sockets an Event was dispatched to
+         * @throws SocketException if waiting fails
+         */
+        size_t poll(int timeoutMs = -1);
+
+        /**
+         * @brief   Dispatch Events until stop() is called
+         *
+         * @throws SocketException if waiting fails
+         */
+        void run();
+
+        /**
+         * @brief   Make run() return after the current iteration
+         * @note    Thread-safe. A stop requested before run() makes the next run() return immediately.
+         */
+        void stop();
+
+        /**
+         * @brief   Interrupt a blocking poll() without dispatching any Events
+         * @note    Thread-safe
+         */
+        void wakeup();
+
+        /**
+         * @brief   Check if run() is currently executing
+         *
+         * @return true if the Reactor is running
+         */
+        bool isRunning() const;
+    };
+
+} // namespace SocketSparrow
@@ -0,0 +1,114 @@
+/**
+ * @file RingBuffer.hpp
+ * @author TL044CN
+ * @brief Contiguous Byte Ring Buffer for SocketSparrow
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+namespace SocketSparrow {
+
+    /**
+     * @brief   Fixed-capacity byte FIFO whose readable and writable regions are always contiguous
+     * @details The memory is mapped twice back to back (memfd + mmap), so data wrapping around
+     *          the end shows up again right after it and no copy is needed to linearize it.
+     *          If the mirrored mapping is unavailable a plain buffer is used that moves its
+     *          content to the front when the free space at the end runs short.
+     */
+    class RingBuffer {
+    private:
+        std::byte* mData = nullptr;
+        size_t mCapacity;
+        size_t mHead = 0;
+        size_t mSize = 0;
+        bool mMirrored = false;
+
+    public:
+        /**
+         * @brief Construct a new Ring Buffer
+         *
+         * @param capacity the number of bytes the buffer holds, rounded up to a multiple of the page size
+         * @throws SocketException if capacity is 0 or no memory could be allocated
+         */
+        explicit RingBuffer(size_t capacity);
+
+        RingBuffer(const RingBuffer&) = delete;
+        RingBuffer& operator=(const RingBuffer&) = delete;
+
+        ~RingBuffer();
+
+        /**
+         * @brief Get the buffered bytes, oldest first
+         *
+         * @return std::span<const std::byte> all buffered bytes
+         */
+        std::span<const std::byte> readable() const;
+
+        /**
+         * @brief   Get the free space behind the buffered bytes
+         * @note    Without mirroring this may move the buffered bytes (and invalidate readable())
+         *          and can be shorter than space(), but always holds at least half of it
+         *
+         * @return std::span<std::byte> all free space
+         */
+        std::span<std::byte> writable();
+
+        /**
+         * @brief Drop bytes from the front after they were read from readable()
+         *
+         * @param count the number of bytes to drop
+         * @throws SocketException if count exceeds size()
+         */
+        void consume(size_t count);
+
+        /**
+         * @brief Append bytes after they were written into writable()
+         *
+         * @param count the number of bytes to append
+         * @throws SocketException if count exceeds the last writable() span
+         */
+        void commit(size_t count);
+
+        /**
+         * @brief Drop all buffered bytes
+         */
+        void clear();
+
+        /**
+         * @brief Get the number of buffered bytes
+         *
+         * @return size_t the number of buffered bytes
+         */
+        size_t size() const;
+
+        /**
+         * @brief Get the number of bytes that can still be appended
+         *
+         * @return size_t the free space
+         */
+        size_t space() const;
+
+        /**
+         * @brief Get the capacity of the buffer
+         *
+         * @return size_t the capacity (a multiple of the page size)
+         */
+        size_t capacity() const;
+
+        /**
+         * @brief Check if the buffer uses the mirrored mapping
+         *
+         * @return true if the memory is mapped twice, false for the compacting fallback
+         */
+        bool isMirrored() const;
+    };
+
+} // namespace SocketSparrow
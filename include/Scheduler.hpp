@@ -0,0 +1,126 @@
+/**
+ * @file Scheduler.hpp
+ * @author TL044CN
+ * @brief Coroutine Scheduler for SocketSparrow
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "Async.hpp"
+#include "Reactor.hpp"
+#include "Task.hpp"
+
+#include <atomic>
+#include <exception>
+#include <unordered_set>
+#include <vector>
+
+namespace SocketSparrow {
+
+    /**
+     * @brief   Runs Coroutines on top of a Reactor
+     * @details Coroutines awaiting a Socket operation are parked per Socket and resumed
+     *          when the Reactor reports the Socket ready. At most one Coroutine may wait
+     *          for reading and one for writing on the same Socket at a time.
+     * @note    A Scheduler is driven by a single thread.
+     */
+    class Scheduler : private Reactor::Handler {
+    private:
+        struct Waiters {
+            AsyncOperation* reader = nullptr;
+            AsyncOperation* writer = nullptr;
+        };
+
+        Reactor mReactor;
+        std::vector<Waiters> mWaiters;     // indexed by native handle
+        std::unordered_set<void*> mTasks;  // frame addresses of the spawned Tasks still running
+        size_t mActive = 0;
+        std::atomic<bool> mStopRequested = false;
+        std::exception_ptr mError;
+
+        void updateRegistration(Socket& socket);
+        void retry(Socket& socket, AsyncOperation* Waiters::* slot);
+
+        void onReadable(Socket& socket) override;
+        void onWritable(Socket& socket) override;
+        void onHangUp(Socket& socket) override;
+        void onError(Socket& socket) override;
+
+        struct Detached;
+        static Detached runDetached(Task<void> task, Scheduler* scheduler);
+
+        friend class AsyncOperation;
+
+        /**
+         * @brief Park a Coroutine until its operation can make progress
+         */
+        void wait(AsyncOperation& operation);
+
+    public:
+        /**
+         * @brief Construct a new Scheduler
+         *
+         * @throws SocketException if creating the Reactor fails
+         */
+        Scheduler();
+
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        /**
+         * @brief   Destroy the Scheduler
+         * @details Tasks that have not finished are destroyed without being resumed, their
+         *          Sockets are removed from the Reactor first.
+         */
+        ~Scheduler();
+
+        /**
+         * @brief   Get the Scheduler running on the calling thread
+         *
+         * @return Scheduler* the current Scheduler or nullptr
+         */
+        static Scheduler* current();
+
+        /**
+         * @brief   Start a Task. It runs until its first suspension right away.
+         *
+         * @param task the Task to run, the Scheduler takes ownership
+         */
+        void spawn(Task<void> task);
+
+        /**
+         * @brief   Resume Coroutines until all spawned Tasks finished or stop() is called
+         *
+         * @throws any exception that escaped a spawned Task
+         * @throws SocketException if waiting for Events fails
+         */
+        void run();
+
+        /**
+         * @brief   Make run() return
+         * @note    Thread-safe
+         */
+        void stop();
+
+        /**
+         * @brief   Get the number of spawned Tasks that have not finished yet
+         *
+         * @return size_t number of active Tasks
+         */
+        size_t active() const;
+
+        /**
+         * @brief   Get the Reactor driving this Scheduler
+         * @note    Sockets with pending operations must not be registered separately
+         *
+         * @return Reactor& the Reactor
+         */
+        Reactor& getReactor();
+    };
+
+} // namespace SocketSparrow
@@ -13,15 +13,104 @@
 
 #include "Enums.hpp"
 #include "Endpoint.hpp"
+#include "EndpointCache.hpp"
 #include "UDPPacket.hpp"
+#include "PacketBatch.hpp"
+#include "PacketPool.hpp"
+#include "Async.hpp"
+#include "Buffer.hpp"
+#include "IOResult.hpp"
 
 #include <coroutine>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
 #include <vector>
 #include <memory>
+#include <optional>
+#include <span>
 #include <sstream>
+#include <string_view>
+#include <utility>
+
+#include <sys/types.h>
 
 namespace SocketSparrow {
 
+    /**
+     * @brief   Growth policy of the resizing recv() overloads
+     * @details The buffer is grown geometrically, starting from its current capacity, so that
+     *          at least chunkSize bytes are free before every read. Its capacity is kept
+     *          across calls, only its size is set to the number of bytes received.
+     */
+    struct RecvOptions {
+        RecvMode mode = RecvMode::Once;             ///< when to stop reading
+        size_t chunkSize = 4096;                    ///< minimum free space offered to each read
+        size_t maxSize = SIZE_MAX;                  ///< the buffer never grows beyond this size
+        size_t exactSize = 0;                       ///< the number of bytes to read in RecvMode::Exact
+    };
+
+    /**
+     * @brief Result of a zero-copy send
+     * @see SocketSparrow::Socket::sendZeroCopy()
+     */
+    struct ZeroCopySend {
+        ssize_t sent;   ///< the number of bytes sent
+        uint32_t id;    ///< the id a ZeroCopyCompletion reports once the buffer may be reused
+    };
+
+    /**
+     * @brief Range of zero-copy sends whose buffers the kernel released
+     * @see SocketSparrow::Socket::readZeroCopyCompletions()
+     */
+    struct ZeroCopyCompletion {
+        uint32_t first;     ///< id of the first completed send
+        uint32_t last;      ///< id of the last completed send (inclusive)
+        bool copied;        ///< the kernel copied the data after all (e.g. over loopback)
+    };
+
+    /**
+     * @brief Credentials of the process on the other end of a Unix Domain Socket
+     * @see SocketSparrow::Socket::peerCredentials()
+     */
+    struct PeerCredentials {
+        pid_t pid;  ///< process id of the peer
+        uid_t uid;  ///< effective user id of the peer
+        gid_t gid;  ///< effective group id of the peer
+    };
+
+    /**
+     * @brief   Connection taken from the accept queue by Socket::acceptMany()
+     * @details Owns the accepted (non-blocking, close-on-exec) descriptor until it is handed
+     *          to a Socket or released. Unclaimed descriptors are closed on destruction or
+     *          when acceptMany() reuses the entry.
+     */
+    struct AcceptedConnection {
+        int fd = -1;            ///< the accepted descriptor, -1 if the entry is empty
+        Endpoint endpoint;      ///< the peer of the connection
+        SocketType type = SocketType::TCP;  ///< the type of the listening Socket (TCP or SeqPacket)
+
+        AcceptedConnection() = default;
+        AcceptedConnection(const AcceptedConnection&) = delete;
+        AcceptedConnection& operator=(const AcceptedConnection&) = delete;
+        AcceptedConnection(AcceptedConnection&& other) noexcept;
+        AcceptedConnection& operator=(AcceptedConnection&& other) noexcept;
+        ~AcceptedConnection();
+
+        /**
+         * @brief Give up ownership of the descriptor
+         *
+         * @return int the descriptor, the caller has to close it
+         */
+        int release();
+
+        /**
+         * @brief Close the descriptor if one is owned
+         */
+        void reset();
+    };
+
     /**
      * @brief Abstraction for a Network Socket
      */
@@ -55,11 +144,31 @@ namespace SocketSparrow {
         int mNativeSocket;
         SocketType mProtocol;
         AddressFamily mAddressFamily;
-        std::shared_ptr<Endpoint> mEndpoint;
+        std::optional<Endpoint> mEndpoint;
         SocketState mState = SocketState::Unknown;
+        bool mNonBlocking = false;
+        std::unique_ptr<EndpointCache> mSenderCache;
+        bool mZeroCopy = false;
+        uint32_t mZeroCopyNextId = 0;       // mirrors the kernel's per socket send counter
+        int mSplicePipe[2] = { -1, -1 };    // created by the first spliceTo()
+        size_t mSplicePending = 0;          // bytes spliceTo() left in the pipe
+
+        friend class AsyncAccept;
+        friend class AsyncConnect;
+        friend class AsyncRecvFrom;
 
     /// Private Constructors
 
+        /**
+         * @brief Construct a new Socket object
+         * 
+         * @param fd file descriptor of the socket
+         * @param endpoint the endpoint to use (contains address and port)
+         * @param protocol the protocol to use (TCP/UDP)
+         * @throws SocketException if the file descriptor is invalid
+         */
+        Socket(int fd, const Endpoint& endpoint, SocketType protocol);
+
         /**
          * @brief Construct a new Socket object
          * 
@@ -70,9 +179,59 @@ namespace SocketSparrow {
          */
         Socket(int fd, std::shared_ptr<Endpoint> endpoint, SocketType protocol);
 
+        /**
+         * @brief Construct a new Socket object owning an existing descriptor, without an Endpoint
+         * 
+         * @param fd file descriptor of the socket
+         * @param af the Address Family of the socket
+         * @param protocol the protocol of the socket
+         */
+        Socket(int fd, AddressFamily af, SocketType protocol);
+
+        /**
+         * @brief Close the descriptor and the splice pipe, leaving the Socket empty
+         */
+        void closeDescriptors();
+
+        /**
+         * @brief Check if the Socket connects, listens and accepts (TCP and SeqPacket)
+         */
+        bool isConnectionOriented() const;
+
+        /**
+         * @brief Get the option level for multicast options, after checking the Socket can use them
+         * @throws SocketException if the Socket is not an IPv4 or IPv6 UDP Socket
+         */
+        int multicastLevel() const;
+
+        /**
+         * @brief Join or leave a group, or a group for one source when source is given
+         * @throws SocketException if the group does not match the Socket or the kernel refuses
+         */
+        void changeMembership(int option, const Endpoint& group, const Endpoint* source, unsigned interfaceIndex);
+
+        /**
+         * @brief   Receive one datagram into a packet with recvmsg, shared by recv_from() and AsyncRecvFrom
+         * @details Fills the packet like recv_from(UDPPacket&): no zero-fill, GRO segment size, sender.
+         *
+         * @param packet the packet to receive into, its data is cleared on failure
+         * @param flags the recvmsg flags, e.g. MSG_DONTWAIT
+         * @return IOResult<size_t> the number of bytes received, or the error (EMSGSIZE if truncated)
+         */
+        IOResult<size_t> receiveFrom(UDPPacket& packet, int flags) const noexcept;
+
     public:
 
     /// Public Constructors and Destructors
+        /**
+         * @brief Construct a connected Socket from a connection returned by acceptMany()
+         * @note  The Socket is non-blocking, like the accepted descriptor
+         * 
+         * @param connection the accepted connection, it is left empty
+         * @throws SocketException if the connection is empty
+         */
+        explicit Socket(AcceptedConnection&& connection);
+
         /**
          * @brief Construct a new Socket object
          * 
@@ -82,6 +241,16 @@ namespace SocketSparrow {
          */
         Socket(AddressFamily af, SocketType protocol);
 
+        /**
+         * @brief Construct a new Socket object and immediately binds it to an Endpoint
+         * @note  This will create a TCP Socket
+         * 
+         * @param af Address Family of the Socket 
+         * @param endpoint the endpoint to connect to
+         * @throws SocketException if creating the Socket fails
+         */
+        Socket(AddressFamily af, const Endpoint& endpoint);
+
         /**
          * @brief Construct a new Socket object and immediately binds it to an Endpoint
          * @note  This will create a TCP Socket
@@ -93,11 +262,83 @@ namespace SocketSparrow {
         Socket(AddressFamily af, std::shared_ptr<Endpoint> endpoint);
 
         /**
-         * @brief Cleans up after the Socket is destroyed (e.g. closes the socket)
+         * @brief   Take over the descriptor and state of another Socket
+         * @note    A Socket registered with a Reactor or BufferedSocket must not be moved
+         * 
+         * @param other the Socket to move from, it is left Closed without a descriptor
+         */
+        Socket(Socket&& other) noexcept;
+
+        /**
+         * @brief   Close this Socket and take over the descriptor and state of another one
+         * 
+         * @param other the Socket to move from, it is left Closed without a descriptor
+         * @return Socket& this Socket
+         */
+        Socket& operator=(Socket&& other) noexcept;
+
+        Socket(const Socket&) = delete;
+        Socket& operator=(const Socket&) = delete;
+
+        /**
+         * @brief Cleans up after the Socket is destroyed (e.g. closes the socket, unless it was moved from or released)
          */
         ~Socket();
 
+        /**
+         * @brief   Create a Socket owning an existing descriptor (e.g. inherited or from another library)
+         * @details Address Family, protocol, state, Endpoint and blocking mode are read from the descriptor.
+         * 
+         * @param fd the socket descriptor, owned by the returned Socket
+         * @return Socket the Socket
+         * @throws SocketException if fd is not a TCP or UDP socket, the descriptor is not closed in that case
+         */
+        static Socket adopt(int fd);
+
+        /**
+         * @brief   Create a pair of connected Unix Domain Sockets (socketpair)
+         * @details Both ends are close-on-exec. Handy to connect threads, or a parent and a child process.
+         * 
+         * @param type TCP (stream), UDP (datagram) or SeqPacket
+         * @return std::pair<Socket, Socket> the two connected ends
+         * @throws SocketException if creating the pair fails
+         */
+        static std::pair<Socket, Socket> pair(SocketType type = SocketType::Stream);
+
     /// Public Methods
+        /**
+         * @brief   Get the native file descriptor of the Socket
+         * @note    The Socket keeps ownership of the descriptor
+         * 
+         * @return int the native file descriptor
+         */
+        int getNativeHandle() const;
+
+        /**
+         * @brief   Give up ownership of the native file descriptor
+         * @note    The Socket is left Closed without a descriptor, the caller has to close the returned one
+         * 
+         * @return int the native file descriptor, -1 if the Socket has none
+         */
+        int release();
+
+        /**
+         * @brief   Get the current State of the Socket
+         * 
+         * @return SocketState the State of the Socket
+         */
+        SocketState getState() const;
+
+        /**
+         * @brief   bind the Socket to an Endpoint.
+         *          This Socket can be client or server
+         * 
+         * @param endpoint the endpoint to connect to
+         * @throws SocketException if binding fails
+         * @throws SocketException if the Socket is not a TCP Socket
+         */
+        void bind(const Endpoint& endpoint);
+
         /**
          * @brief   bind the Socket to an Endpoint.
          *          This Socket can be client or server
@@ -118,6 +359,17 @@ namespace SocketSparrow {
          */
         void bindToPort(uint16_t port);
 
+        /**
+         * @brief  connect the Socket to the Endpoint
+         *         This Socket will be the client
+         * @note   This is only works for TCP Sockets
+         * 
+         * @param endpoint the endpoint to connect to
+         * @throws SocketException if the connection fails
+         * @throws SocketException if the Socket is not a TCP Socket
+         */
+        void connect(const Endpoint& endpoint);
+
         /**
          * @brief  connect the Socket to the Endpoint
          *         This Socket will be the client
@@ -150,6 +402,30 @@ namespace SocketSparrow {
          */
         std::shared_ptr<Socket> accept();
 
+        /**
+         * @brief   Accept all pending connections at once (accept4)
+         * @details Drains the accept queue into connections without allocating. The accepted
+         *          descriptors are non-blocking and close-on-exec from the start.
+         * @note    On a blocking Socket only the first accept may wait, further connections
+         *          are only taken while some are pending. Connections reset by the peer
+         *          before they were accepted are skipped.
+         * 
+         * @param connections the entries to fill, from the front
+         * @param maxCount the maximum number of connections to accept
+         * @return size_t the number of filled entries, 0 if none was pending on a non-blocking Socket
+         * @throws SocketException if the Socket is not a listening TCP Socket
+         *         or accepting fails before any connection was accepted
+         */
+        size_t acceptMany(std::span<AcceptedConnection> connections, size_t maxCount = SIZE_MAX);
+
+        /**
+         * @brief   Accept one pending connection without throwing on failure (accept4)
+         * @note    The accepted Socket is non-blocking and close-on-exec
+         * 
+         * @return IOResult<Socket> the connection, or the error (e.g. EAGAIN if none is pending)
+         */
+        IOResult<Socket> try_accept();
+
         /**
          * @brief   Configure the Socket for broadcast mode (or disable it)
          * @note    when disabling broadcast, the Address will be set to Any(0)
@@ -159,6 +435,91 @@ namespace SocketSparrow {
          */
         void enableBroadcast(bool enable = true);
 
+        /**
+         * @brief   Set the default GSO segment size, every larger send is split into datagrams of this size
+         * @note    send_to() with a segmentSize overrides it for a single call
+         * 
+         * @param segmentSize the payload size of every datagram, 0 disables segmentation
+         * @throws SocketException if the Socket is not UDP or the kernel lacks UDP_SEGMENT
+         */
+        void setSegmentSize(uint16_t segmentSize);
+
+        /**
+         * @brief   Let the kernel coalesce consecutive datagrams of one flow into a single receive (GRO)
+         * @details recv_from(UDPPacket&) then returns many datagrams at once, with their size in
+         *          UDPPacket::segmentSize. Receive buffers should hold 64 KiB.
+         * 
+         * @param enable true to receive coalesced datagrams, false for one datagram per receive
+         * @throws SocketException if the Socket is not UDP or the kernel lacks UDP_GRO
+         */
+        void enableGro(bool enable = true);
+
+        /**
+         * @brief   Join a multicast group, so datagrams sent to it are received
+         * @note    The Socket has to be bound to the group port (usually to Any) to receive them
+         * @note    Works for IPv4 and IPv6 groups alike (MCAST_JOIN_GROUP)
+         * 
+         * @param group the group address, the port is ignored
+         * @param interfaceIndex the interface to join on (see if_nametoindex), 0 lets the kernel choose
+         * @throws SocketException if the Socket is not UDP, the group is of another Address Family or joining fails
+         */
+        void joinGroup(const Endpoint& group, unsigned interfaceIndex = 0);
+
+        /**
+         * @brief   Leave a multicast group joined with joinGroup()
+         * 
+         * @param group the group address, the port is ignored
+         * @param interfaceIndex the interface the group was joined on
+         * @throws SocketException if the Socket is not UDP or leaving fails
+         */
+        void leaveGroup(const Endpoint& group, unsigned interfaceIndex = 0);
+
+        /**
+         * @brief   Join a multicast group, receiving only what one source sends to it (source-specific multicast)
+         * 
+         * @param group the group address, the port is ignored
+         * @param source the only sender to accept datagrams from, the port is ignored
+         * @param interfaceIndex the interface to join on, 0 lets the kernel choose
+         * @throws SocketException if the Socket is not UDP, an address is of another Address Family or joining fails
+         */
+        void joinSourceGroup(const Endpoint& group, const Endpoint& source, unsigned interfaceIndex = 0);
+
+        /**
+         * @brief   Leave a source-specific group joined with joinSourceGroup()
+         * 
+         * @param group the group address, the port is ignored
+         * @param source the source the group was joined for
+         * @param interfaceIndex the interface the group was joined on
+         * @throws SocketException if the Socket is not UDP or leaving fails
+         */
+        void leaveSourceGroup(const Endpoint& group, const Endpoint& source, unsigned interfaceIndex = 0);
+
+        /**
+         * @brief   Configure if multicast datagrams sent by this Socket are looped back to the local host
+         * @note    Enabled by default, receivers on the sending host need it
+         * 
+         * @param enable true to loop datagrams back, false to only send them out
+         * @throws SocketException if the Socket is not UDP or setting the option fails
+         */
+        void enableMulticastLoop(bool enable = true);
+
+        /**
+         * @brief   Set the TTL (IPv4) or hop limit (IPv6) of multicast datagrams sent by this Socket
+         * @note    The default of 1 keeps datagrams on the local network
+         * 
+         * @param ttl the number of hops, 0 to 255
+         * @throws SocketException if the Socket is not UDP or setting the option fails
+         */
+        void setMulticastTTL(int ttl);
+
+        /**
+         * @brief   Set the interface multicast datagrams are sent out of
+         * 
+         * @param interfaceIndex the interface (see if_nametoindex), 0 to follow the routing table
+         * @throws SocketException if the Socket is not UDP or setting the option fails
+         */
+        void setMulticastInterface(unsigned interfaceIndex);
+
         /**
          * @brief   Configure the Socket for Reuse (or disable it)
          * @note    This is useful when the Socket is closed and reopened
@@ -187,6 +548,75 @@ namespace SocketSparrow {
          */
         void enableNonBlocking(bool enable = true);
 
+        /**
+         * @brief   Check if the Socket is in non-blocking mode
+         * 
+         * @return true if the Socket is non-blocking
+         */
+        bool isNonBlocking() const;
+
+        /**
+         * @brief   Get the credentials of the peer process (SO_PEERCRED)
+         * @note    Only connected Unix Domain Sockets (and pair()) have peer credentials.
+         *          They are the credentials at connect() or pair() time.
+         * 
+         * @return PeerCredentials pid, uid and gid of the peer
+         * @throws SocketException if the Socket has no peer credentials
+         */
+        PeerCredentials peerCredentials() const;
+
+        /**
+         * @brief   Allow sends with sendZeroCopy() (SO_ZEROCOPY)
+         * @note    Zero-copy pays off for large sends (above ~16 KiB). Smaller ones are cheaper to copy.
+         * 
+         * @param enable true to enable zero-copy sends, false to disable
+         * @throws SocketException if the kernel does not support zero-copy for this Socket
+         */
+        void enableZeroCopy(bool enable = true);
+
+        /**
+         * @brief   Check if zero-copy sends are enabled
+         * 
+         * @return true if sendZeroCopy() can be used
+         */
+        bool isZeroCopy() const;
+
+        /**
+         * @brief   Sends data without copying it into kernel memory (MSG_ZEROCOPY)
+         * @details The kernel keeps referencing data after this returns. The buffer must not be
+         *          changed or freed until readZeroCopyCompletions() reported the returned id.
+         *          Like send(std::span<const std::byte>) this makes exactly one send call.
+         * 
+         * @param data the data to send
+         * @return ZeroCopySend the number of bytes sent and the id of this send
+         * @throws SocketException if zero-copy was not enabled with enableZeroCopy()
+         * @throws SendError if sending fails
+         */
+        ZeroCopySend sendZeroCopy(std::span<const std::byte> data);
+
+        /**
+         * @brief   Reads the completion notifications of zero-copy sends from the error queue
+         * @details Never blocks. Pending notifications make the Socket report an error event,
+         *          so a Reactor Handler can call this from onError().
+         * 
+         * @param callback invoked for every completed range of send ids
+         * @return size_t the number of ranges reported
+         * @throws RecvError if reading the error queue fails
+         */
+        size_t readZeroCopyCompletions(const std::function<void(const ZeroCopyCompletion&)>& callback) const;
+
+        /**
+         * @brief   Sends data to the internal Socket
+         *          This is used for TCP or UDP Sockets
+         * @note    for TCP this socket should be returned from accept()
+         * 
+         * @param data the data to send
+         * @return ssize_t the number of bytes sent
+         * @throws SendError if sending fails
+         * @see SocketSparrow::Socket::accept()
+         */
+        ssize_t send(std::span<const std::byte> data) const;
+
         /**
          * @brief   Sends data to the internal Socket
          *          This is used for TCP or UDP Sockets
@@ -197,7 +627,7 @@ namespace SocketSparrow {
          * @throws SendError if sending fails
          * @see SocketSparrow::Socket::accept()
          */
-        ssize_t send(std::vector<char> data) const;
+        ssize_t send(const std::vector<char>& data) const;
 
         /**
          * @brief   Sends data to the internal Socket
@@ -209,7 +639,47 @@ namespace SocketSparrow {
          * @throws SendError if sending fails
          * @see SocketSparrow::Socket::accept()
          */
-        ssize_t send(const std::string& data) const;
+        ssize_t send(std::string_view data) const;
+
+        /**
+         * @brief   Sends data to the internal Socket without throwing on failure
+         * @note    Meant for non-blocking Sockets, where EAGAIN is an expected outcome.
+         *          A closed peer is reported as EPIPE instead of raising SIGPIPE.
+         * 
+         * @param data the data to send
+         * @return IOResult<size_t> the number of bytes sent, or the error
+         */
+        IOResult<size_t> try_send(std::span<const std::byte> data) const noexcept;
+
+        /**
+         * @brief   Sends data to the internal Socket without throwing on failure
+         * @note    Meant for non-blocking Sockets, where EAGAIN is an expected outcome.
+         *          A closed peer is reported as EPIPE instead of raising SIGPIPE.
+         * 
+         * @param data the data to send
+         * @return IOResult<size_t> the number of bytes sent, or the error
+         */
+        IOResult<size_t> try_send(std::string_view data) const noexcept;
+
+        /**
+         * @brief   Receives data from the internal Socket into a caller provided buffer
+         *          This is used for TCP or UDP Sockets
+         * @note    This makes exactly one recv call and never allocates
+         * 
+         * @param buffer the buffer to store the data
+         * @return ssize_t the number of bytes received, 0 if the peer closed the connection
+         * @throws RecvError if receiving fails
+         */
+        ssize_t recv(std::span<std::byte> buffer) const;
+
+        /**
+         * @brief   Receives data into a caller provided buffer without throwing on failure
+         * @note    Meant for non-blocking Sockets, where EAGAIN is an expected outcome
+         * 
+         * @param buffer the buffer to store the data
+         * @return IOResult<size_t> the number of bytes received (0 if the peer closed the connection), or the error
+         */
+        IOResult<size_t> try_recv(std::span<std::byte> buffer) const noexcept;
 
         /**
          * @brief   Receives data from the internal Socket
@@ -217,7 +687,8 @@ namespace SocketSparrow {
          * @note    for TCP this socket should be returned from accept()
          * 
          * @param buffer the buffer to store the data. The buffer will be resized to fit the data
-         * @param autoresize true to automatically resize the buffer, false to use the current size
+         * @param autoresize true to grow the buffer with the default RecvOptions,
+         *                   false to make one read into the buffer's current size
          * @return ssize_t the number of bytes received
          * @throws RecvError if receiving fails
          * @see SocketSparrow::Socket::accept()
@@ -242,13 +713,143 @@ namespace SocketSparrow {
          *          This is used for TCP or UDP Sockets
          * @note    for TCP this socket should be returned from accept()
          * 
-         * @param buffer the buffer to store the data
+         * @param buffer the buffer to store the data, it grows with the default RecvOptions
          * @return ssize_t the number of bytes received
          * @throws RecvError if receiving fails
          * @see SocketSparrow::Socket::accept()
          */
         ssize_t recv(std::string& buffer) const;
 
+        /**
+         * @brief   Receives data from the internal Socket into a growing buffer
+         * @details Reads are retried on EINTR. Only the first read may block (except in
+         *          RecvMode::Exact), later ones take what is already queued.
+         * @note    A would-block after some data was received ends the receive,
+         *          in RecvMode::Exact a short count then means the Socket would block.
+         * 
+         * @param buffer the buffer to store the data, its size is set to the bytes received
+         * @param options chunk size, size limit and mode of the receive
+         * @return ssize_t the number of bytes received, 0 if the peer closed the connection
+         * @throws RecvError if the first read fails (including would-block)
+         */
+        ssize_t recv(std::vector<char>& buffer, const RecvOptions& options) const;
+
+        /**
+         * @brief   Receives data from the internal Socket into a growing buffer
+         * @see SocketSparrow::Socket::recv(std::vector<char>&, const RecvOptions&)
+         * 
+         * @param buffer the buffer to store the data, its size is set to the bytes received
+         * @param options chunk size, size limit and mode of the receive
+         * @return ssize_t the number of bytes received, 0 if the peer closed the connection
+         * @throws RecvError if the first read fails (including would-block)
+         */
+        ssize_t recv(std::string& buffer, const RecvOptions& options) const;
+
+        /**
+         * @brief   Sends several buffers with as few system calls as possible (gather write)
+         * @details Partial writes are continued and lists longer than IOV_MAX are split,
+         *          so on a blocking Socket all bytes are sent when this returns.
+         * @note    Once some bytes were sent, a failing call (e.g. a non-blocking Socket that
+         *          would block) ends the send early and the count so far is returned.
+         *          For UDP all buffers form one datagram.
+         * 
+         * @param buffers the buffers to send, in order
+         * @return ssize_t the number of bytes sent
+         * @throws SendError if sending fails before any byte was sent
+         *         or a UDP datagram is made of more than IOV_MAX buffers
+         */
+        ssize_t send(std::span<const iovec> buffers) const;
+
+        /**
+         * @brief   Sends several buffers with as few system calls as possible (gather write)
+         * @details e.g. socket.sendv({ header, payload })
+         * @see SocketSparrow::Socket::send(std::span<const iovec>)
+         * 
+         * @param buffers the buffers to send, in order
+         * @return ssize_t the number of bytes sent
+         * @throws SendError if sending fails before any byte was sent
+         */
+        ssize_t sendv(std::initializer_list<ConstBuffer> buffers) const;
+
+        /**
+         * @brief   Receives into several buffers with one system call (scatter read)
+         * @note    Like recv(std::span<std::byte>) this returns whatever one call delivers,
+         *          filling the buffers in order. Only the first IOV_MAX buffers are used.
+         * 
+         * @param buffers the buffers to fill, in order
+         * @return ssize_t the number of bytes received, 0 if the peer closed the connection
+         * @throws RecvError if receiving fails
+         */
+        ssize_t recvv(std::span<const iovec> buffers) const;
+
+        /**
+         * @brief   Receives into several buffers with one system call (scatter read)
+         * @details e.g. socket.recvv({ header, payload })
+         * @see SocketSparrow::Socket::recvv(std::span<const iovec>)
+         * 
+         * @param buffers the buffers to fill, in order
+         * @return ssize_t the number of bytes received, 0 if the peer closed the connection
+         * @throws RecvError if receiving fails
+         */
+        ssize_t recvv(std::initializer_list<MutableBuffer> buffers) const;
+
+        /**
+         * @brief   Sends part of a file without copying it through userspace (sendfile)
+         * @details Partial sends are continued until length bytes were sent or the file ended.
+         * @note    Once some bytes were sent, a failing call (e.g. a non-blocking Socket that
+         *          would block) ends the send early and the count so far is returned.
+         * 
+         * @param fd the file to read from, it has to support mmap-like access (e.g. a regular file)
+         * @param offset the position in the file to start at, the file offset is not changed
+         * @param length the number of bytes to send
+         * @return ssize_t the number of bytes sent
+         * @throws SendError if sending fails before any byte was sent
+         */
+        ssize_t sendFile(int fd, off_t offset, size_t length) const;
+
+        /**
+         * @brief   Moves received data to another Socket inside the kernel (splice)
+         * @details The data passes through a pipe owned by this Socket, created on first use.
+         *          Stops after length bytes, when this Socket reaches end of stream or when
+         *          either side would block. Bytes that were read but could not be written yet
+         *          stay in the pipe and are written first by the next call.
+         * 
+         * @param destination the Socket to write to
+         * @param length the maximum number of bytes to move
+         * @return ssize_t the number of bytes written to destination, 0 at end of stream
+         * @throws RecvError if reading fails before any byte was moved
+         * @throws SendError if writing fails before any byte was moved
+         * @throws SocketException if the pipe cannot be created
+         */
+        ssize_t spliceTo(Socket& destination, size_t length);
+
+        /**
+         * @brief   Pass file descriptors to the peer process (SCM_RIGHTS)
+         * @details The peer receives duplicates that refer to the same open files and sockets,
+         *          so e.g. a listening Socket keeps its accept queue in the other process.
+         * @note    Ancillary data needs at least one byte of payload, so empty data sends a single zero byte
+         * 
+         * @param fds the descriptors to pass, at most 253 (SCM_MAX_FD)
+         * @param data the payload travelling with the descriptors
+         * @return ssize_t the number of payload bytes sent
+         * @throws SocketException if this is not a Unix Domain Socket or there are too many descriptors
+         * @throws SendError if sending fails
+         */
+        ssize_t sendFds(std::span<const int> fds, std::span<const std::byte> data = {}) const;
+
+        /**
+         * @brief   Receive payload and file descriptors passed by sendFds() (SCM_RIGHTS)
+         * @note    Received descriptors are close-on-exec and owned by the caller
+         * 
+         * @param buffer the buffer for the payload, at least one byte
+         * @param fds the received descriptors are appended here
+         * @return ssize_t the number of payload bytes received, 0 if the peer closed the connection
+         * @throws SocketException if this is not a Unix Domain Socket, the buffer is empty
+         *         or descriptors were dropped because the control buffer was too small
+         * @throws RecvError if receiving fails
+         */
+        ssize_t recvFds(std::span<std::byte> buffer, std::vector<int>& fds) const;
+
         /**
          * @brief   Sends a UDP Packet to the internal Socket
          * @note    this only works with UDP Sockets
@@ -259,7 +860,7 @@ namespace SocketSparrow {
          * @throws SendError if sending fails
          * @see SocketSparrow::Socket::send()
          */
-        ssize_t send_to(std::vector<char> data, std::shared_ptr<Endpoint> endpoint);
+        ssize_t send_to(std::span<const std::byte> data, const Endpoint& endpoint);
 
         /**
          * @brief   Sends a UDP Packet to the internal Socket
@@ -271,18 +872,72 @@ namespace SocketSparrow {
          * @throws SendError if sending fails
          * @see SocketSparrow::Socket::send()
          */
-        ssize_t send_to(const std::string& data, std::shared_ptr<Endpoint> endpoint);
+        ssize_t send_to(std::span<const std::byte> data, std::shared_ptr<Endpoint> endpoint);
+
+        /**
+         * @brief   Sends a buffer as a train of equally sized UDP datagrams with a single syscall (GSO)
+         * @details The kernel splits data into datagrams of segmentSize bytes (the last one may be
+         *          shorter) as late as possible, on capable NICs only in hardware. One call covers
+         *          up to 64 segments and 64 KiB.
+         * @note    this only works with UDP Sockets
+         * 
+         * @param data the data to send
+         * @param endpoint the endpoint to send the datagrams to
+         * @param segmentSize the payload size of every datagram, 0 sends data as a single datagram
+         * @return ssize_t the number of bytes sent
+         * @throws SendError if sending fails (EINVAL for too many segments, EIO without checksum offload)
+         * @see SocketSparrow::Socket::setSegmentSize()
+         */
+        ssize_t send_to(std::span<const std::byte> data, const Endpoint& endpoint, uint16_t segmentSize);
 
         /**
          * @brief   Sends a UDP Packet to the internal Socket
          * @note    this only works with UDP Sockets
          * 
+         * @param data the data to send
+         * @param endpoint the endpoint to send the data to
+         * @return ssize_t the number of bytes sent
+         * @throws SendError if sending fails
+         * @see SocketSparrow::Socket::send()
+         */
+        ssize_t send_to(const std::vector<char>& data, std::shared_ptr<Endpoint> endpoint);
+
+        /**
+         * @brief   Sends a UDP Packet to the internal Socket
+         * @note    this only works with UDP Sockets
+         * 
+         * @param data the data to send
+         * @param endpoint the endpoint to send the data to
+         * @return ssize_t the number of bytes sent
+         * @throws SendError if sending fails
+         * @see SocketSparrow::Socket::send()
+         */
+        ssize_t send_to(std::string_view data, const Endpoint& endpoint);
+
+        /**
+         * @brief   Sends a UDP Packet to the internal Socket
+         * @note    this only works with UDP Sockets
+         * 
+         * @param data the data to send
+         * @param endpoint the endpoint to send the data to
+         * @return ssize_t the number of bytes sent
+         * @throws SendError if sending fails
+         * @see SocketSparrow::Socket::send()
+         */
+        ssize_t send_to(std::string_view data, std::shared_ptr<Endpoint> endpoint);
+
+        /**
+         * @brief   Sends a UDP Packet to the internal Socket
+         * @note    this only works with UDP Sockets
+         * @note    a packet with a segmentSize is sent as several datagrams (GSO)
+         * 
          * @param packet the packet to send
          * @return ssize_t the number of bytes sent
+         * @throws SocketException if the packet has no Endpoint
          * @throws SendError if sending fails
          * @see SocketSparrow::Socket::send()
          */
-        ssize_t send_to(UDPPacket packet);
+        ssize_t send_to(const UDPPacket& packet);
 
         /**
          * @brief   Receives a UDP Packet from the internal Socket
@@ -294,6 +949,158 @@ namespace SocketSparrow {
          */
         UDPPacket recv_from() const;
 
+        /**
+         * @brief   Receives a UDP Packet into an existing packet
+         * @details The packet data is resized to the received size, its capacity is reused
+         *          (a packet without capacity reserves MAX_UDP_PACKET_SIZE first) and
+         *          is not zero-filled. The sender is stored in packet.endpoint without allocating.
+         *          With enableGro(), packet.segmentSize reports datagrams coalesced by the kernel.
+         * @note    this only works with UDP Sockets
+         * 
+         * @param packet the packet to receive into
+         * @return ssize_t the number of bytes received
+         * @throws RecvError if receiving fails or the datagram did not fit the packet (EMSGSIZE)
+         * @see SocketSparrow::Socket::recv()
+         */
+        ssize_t recv_from(UDPPacket& packet) const;
+
+        /**
+         * @brief   Cache the senders of received Packets
+         * @details With the cache enabled, sender() returns the same shared Endpoint for
+         *          repeat senders instead of allocating one per Packet.
+         * 
+         * @param capacity the number of senders to remember, 0 disables the cache
+         */
+        void enableSenderCache(size_t capacity = 32);
+
+        /**
+         * @brief   Get a shared Endpoint for the sender of a received Packet
+         * @note    Allocates a new Endpoint every time unless the sender cache is enabled
+         * 
+         * @param packet the received packet
+         * @return std::shared_ptr<Endpoint> the sender
+         * @throws InvalidAddressException if the packet has no sender
+         * @see SocketSparrow::Socket::enableSenderCache()
+         */
+        std::shared_ptr<Endpoint> sender(const UDPPacket& packet);
+
+        /**
+         * @brief   Receives a UDP Packet into a buffer borrowed from a PacketPool
+         * @note    this only works with UDP Sockets. Does not allocate.
+         * 
+         * @param packet the packet to receive into, its size and source are updated
+         * @return ssize_t the number of bytes received
+         * @throws SocketException if the packet holds no buffer
+         * @throws RecvError if receiving fails or the datagram did not fit the packet (EMSGSIZE)
+         * @see SocketSparrow::PacketPool
+         */
+        ssize_t recv_from(PooledPacket& packet) const;
+
+        /**
+         * @brief   Receives up to batch.capacity() UDP Packets with a single syscall
+         * @details Blocks until at least one Packet arrived (unless the Socket is non-blocking),
+         *          then takes whatever else is already queued without waiting.
+         * @note    this only works with UDP Sockets
+         * 
+         * @param batch the batch to receive into, its previous content is replaced
+         * @return size_t the number of received Packets, 0 if a non-blocking Socket had none
+         * @throws RecvError if receiving fails
+         * @see SocketSparrow::PacketBatch
+         */
+        size_t recvBatch(PacketBatch& batch) const;
+
+        /**
+         * @brief   Sends all Packets of a batch with as few syscalls as possible
+         * @note    this only works with UDP Sockets
+         * 
+         * @param batch the batch to send
+         * @return size_t the number of sent Packets, less than batch.size() if a non-blocking
+         *         Socket would block or sending failed after some Packets were sent (the next
+         *         call reports the error)
+         * @throws SendError if sending fails before any Packet was sent
+         * @see SocketSparrow::PacketBatch
+         */
+        size_t sendBatch(const PacketBatch& batch) const;
+
+        /**
+         * @brief   Sends all Packets of a batch without throwing on failure
+         * @note    this only works with UDP Sockets, others report EINVAL
+         * 
+         * @param batch the batch to send
+         * @return IOResult<size_t> the number of sent Packets, or the error if sending failed
+         *         before any Packet was sent (e.g. EAGAIN if a non-blocking Socket would block)
+         * @see SocketSparrow::Socket::sendBatch()
+         */
+        IOResult<size_t> try_sendBatch(const PacketBatch& batch) const noexcept;
+
+    /// Coroutine Operations
+
+        /**
+         * @brief   Accept a connection without blocking the thread
+         * @note    Has to be awaited inside a Coroutine running on a Scheduler.
+         *          The Socket is switched to non-blocking mode.
+         * 
+         * @return AsyncAccept awaitable yielding the accepted connection
+         * @throws SocketException if the Socket is not a listening TCP Socket
+         * @see SocketSparrow::Scheduler
+         */
+        AsyncAccept asyncAccept();
+
+        /**
+         * @brief   Connect to an Endpoint without blocking the thread
+         * @note    Has to be awaited inside a Coroutine running on a Scheduler.
+         *          The Socket is switched to non-blocking mode.
+         * 
+         * @param endpoint the endpoint to connect to
+         * @return AsyncConnect awaitable that finishes once connected
+         * @throws SocketException if the Socket is not a TCP Socket
+         * @see SocketSparrow::Scheduler
+         */
+        AsyncConnect asyncConnect(const Endpoint& endpoint);
+
+        /**
+         * @brief   Connect to an Endpoint without blocking the thread
+         * @note    Has to be awaited inside a Coroutine running on a Scheduler.
+         *          The Socket is switched to non-blocking mode.
+         * 
+         * @param endpoint the endpoint to connect to
+         * @return AsyncConnect awaitable that finishes once connected
+         * @throws SocketException if the Socket is not a TCP Socket
+         * @see SocketSparrow::Scheduler
+         */
+        AsyncConnect asyncConnect(std::shared_ptr<Endpoint> endpoint);
+
+        /**
+         * @brief   Receive data without blocking the thread
+         * @note    Has to be awaited inside a Coroutine running on a Scheduler
+         * 
+         * @param buffer the buffer to receive into, has to outlive the operation
+         * @return AsyncRecv awaitable yielding the number of received bytes
+         * @see SocketSparrow::Scheduler
+         */
+        AsyncRecv asyncRecv(std::span<std::byte> buffer);
+
+        /**
+         * @brief   Send data without blocking the thread
+         * @note    Has to be awaited inside a Coroutine running on a Scheduler
+         * 
+         * @param data the data to send, has to outlive the operation
+         * @return AsyncSend awaitable yielding the number of sent bytes
+         * @see SocketSparrow::Scheduler
+         */
+        AsyncSend asyncSend(std::span<const std::byte> data);
+
+        /**
+         * @brief   Receive a UDP Packet without blocking the thread
+         * @note    Has to be awaited inside a Coroutine running on a Scheduler
+         * 
+         * @param packet the packet to receive into, its data capacity is reused
+         * @return AsyncRecvFrom awaitable yielding the number of received bytes
+         * @throws SocketException if the Socket is not a UDP Socket
+         * @see SocketSparrow::Scheduler
+         */
+        AsyncRecvFrom asyncRecvFrom(UDPPacket& packet);
+
     /// Operators
 
         /**
@@ -316,7 +1123,7 @@ namespace SocketSparrow {
          * @throws SendError if sending fails
          * @see SocketSparrow::Socket::send()
          */
-        ssize_t operator<<(const std::string& data) const;
+        ssize_t operator<<(std::string_view data) const;
 
         /**
          * @brief   Receives data from the internal Socket
@@ -9,10 +9,27 @@
  * 
  */
 #pragma once
+#include "AsyncResolver.hpp"
+#include "BasicSocket.hpp"
+#include "Buffer.hpp"
+#include "BufferedSocket.hpp"
 #include "Endpoint.hpp"
+#include "EndpointCache.hpp"
 #include "Enums.hpp"
 #include "Exceptions.hpp"
+#include "Framer.hpp"
+#include "HotRestart.hpp"
+#include "IOResult.hpp"
+#include "IoUring.hpp"
+#include "ListenerGroup.hpp"
+#include "MulticastPublisher.hpp"
+#include "PacketBatch.hpp"
+#include "PacketPool.hpp"
+#include "Reactor.hpp"
+#include "RingBuffer.hpp"
+#include "Scheduler.hpp"
 #include "Socket.hpp"
+#include "Task.hpp"
 #include "UDPPacket.hpp"
 #include "Util.hpp"
 
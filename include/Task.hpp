@@ -0,0 +1,183 @@
+/**
+ * @file Task.hpp
+ * @author TL044CN
+ * @brief Coroutine Task Type for SocketSparrow
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace SocketSparrow {
+
+    template<typename T = void>
+    class Task;
+
+    namespace Detail {
+
+        /**
+         * @brief Resumes the awaiting coroutine when a Task finishes
+         */
+        struct TaskFinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+
+            template<typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+                if ( handle.promise().continuation ) {
+                    return handle.promise().continuation;
+                }
+                return std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        /**
+         * @brief State shared by all Task promises
+         */
+        struct TaskPromiseBase {
+            std::coroutine_handle<> continuation;
+            std::exception_ptr exception;
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            TaskFinalAwaiter final_suspend() const noexcept { return {}; }
+            void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+            void rethrowIfFailed() const {
+                if ( exception ) {
+                    std::rethrow_exception(exception);
+                }
+            }
+        };
+
+        template<typename T>
+        struct TaskPromise : TaskPromiseBase {
+            std::optional<T> value;
+
+            Task<T> get_return_object() noexcept;
+
+            template<typename U>
+            void return_value(U&& result) { value.emplace(std::forward<U>(result)); }
+
+            T takeResult() {
+                rethrowIfFailed();
+                return std::move(*value);
+            }
+        };
+
+        template<>
+        struct TaskPromise<void> : TaskPromiseBase {
+            Task<void> get_return_object() noexcept;
+
+            void return_void() const noexcept {}
+
+            void takeResult() const { rethrowIfFailed(); }
+        };
+
+    } // namespace Detail
+
+    /**
+     * @brief   Lazily started Coroutine producing a value of type T
+     * @details A Task does not run until it is awaited (or spawned on a Scheduler).
+     *          Awaiting it resumes the awaiting Coroutine as soon as the Task finishes and
+     *          returns its result or rethrows its exception.
+     *
+     * @tparam T the result type
+     */
+    template<typename T>
+    class Task {
+    public:
+        using promise_type = Detail::TaskPromise<T>;
+        using Handle = std::coroutine_handle<promise_type>;
+
+    private:
+        Handle mHandle;
+
+    public:
+        /**
+         * @brief Construct an empty Task
+         */
+        Task() noexcept = default;
+
+        /**
+         * @brief Take ownership of a Coroutine handle
+         *
+         * @param handle the handle of the Coroutine
+         */
+        explicit Task(Handle handle) noexcept : mHandle(handle) {}
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        Task(Task&& other) noexcept : mHandle(std::exchange(other.mHandle, nullptr)) {}
+
+        Task& operator=(Task&& other) noexcept {
+            if ( this != &other ) {
+                if ( mHandle ) {
+                    mHandle.destroy();
+                }
+                mHandle = std::exchange(other.mHandle, nullptr);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destroy the Task and its Coroutine frame
+         */
+        ~Task() {
+            if ( mHandle ) {
+                mHandle.destroy();
+            }
+        }
+
+        /**
+         * @brief Check if the Task has finished
+         *
+         * @return true if the Task is empty or has finished
+         */
+        bool done() const noexcept {
+            return !mHandle || mHandle.done();
+        }
+
+        /**
+         * @brief Awaiter that starts the Task and returns its result
+         */
+        auto operator co_await() && noexcept {
+            struct Awaiter {
+                Handle handle;
+
+                bool await_ready() const noexcept { return !handle || handle.done(); }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                    handle.promise().continuation = awaiting;
+                    return handle;
+                }
+
+                T await_resume() { return handle.promise().takeResult(); }
+            };
+            return Awaiter{mHandle};
+        }
+    };
+
+    namespace Detail {
+
+        template<typename T>
+        Task<T> TaskPromise<T>::get_return_object() noexcept {
+            return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+        }
+
+        inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+            return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+        }
+
+    } // namespace Detail
+
+} // namespace SocketSparrow
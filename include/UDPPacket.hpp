@@ -12,9 +12,13 @@
 #pragma once
 
 #include "Endpoint.hpp"
+#include "Exceptions.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <span>
 
 namespace SocketSparrow {
 
@@ -25,11 +29,48 @@ namespace SocketSparrow {
      */
     struct UDPPacket {
         std::vector<char> data;
-        std::shared_ptr<Endpoint> endpoint;
+        Endpoint endpoint;  ///< sender of a received Packet or destination of a sent one
+        uint16_t segmentSize = 0;   ///< data holds datagrams of this size (the last may be shorter), 0 for a single datagram
 
-        UDPPacket(size_t size = MAX_UDP_PACKET_SIZE) : data(size), endpoint(nullptr) {}
-        UDPPacket(const std::vector<char>& _data, std::shared_ptr<Endpoint> _endpoint = nullptr)
+        UDPPacket(size_t size = MAX_UDP_PACKET_SIZE) : data(size) {}
+        UDPPacket(const std::vector<char>& _data, const Endpoint& _endpoint = Endpoint())
         : data(_data), endpoint(_endpoint) {}
+        UDPPacket(const std::vector<char>& _data, std::shared_ptr<Endpoint> _endpoint)
+        : data(_data), endpoint(_endpoint ? *_endpoint : Endpoint()) {}
+
+        /**
+         * @brief   Get the number of datagrams in the Packet
+         * @note    More than one when it was coalesced on receive (GRO) or is split on send (GSO)
+         *
+         * @return size_t number of datagrams
+         */
+        size_t segmentCount() const {
+            if ( data.empty() ) {
+                return 0;
+            }
+            if ( segmentSize == 0 ) {
+                return 1;
+            }
+            return (data.size() + segmentSize - 1) / segmentSize;
+        }
+
+        /**
+         * @brief   Get one datagram of the Packet
+         *
+         * @param index the index of the datagram, below segmentCount()
+         * @return std::span<const char> the payload of that datagram
+         * @throws SocketException if the index is out of range
+         */
+        std::span<const char> segment(size_t index) const {
+            if ( index >= segmentCount() ) {
+                throw SocketException("UDPPacket segment index out of range");
+            }
+            if ( segmentSize == 0 ) {
+                return data;
+            }
+            size_t offset = index * segmentSize;
+            return std::span<const char>(data).subspan(offset, std::min<size_t>(segmentSize, data.size() - offset));
+        }
     };
 
 } // namespace SocketSparrow
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include "Async.hpp"
+#include "Socket.hpp"
+#include "Scheduler.hpp"
+#include "Exceptions.hpp"
+
+#include <cerrno>
+#include <utility>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace SocketSparrow {
+
+namespace {
+
+bool wouldBlock(int error) {
+    return error == EAGAIN || error == EWOULDBLOCK;
+}
+
+} // namespace
+
+AsyncOperation::AsyncOperation(Socket& socket, IOEvent interest)
+    : mSocket(socket),
+    mInterest(interest) {}
+
+Socket& AsyncOperation::getSocket() const {
+    return mSocket;
+}
+
+bool AsyncOperation::await_ready() {
+    return attempt();
+}
+
+void AsyncOperation::await_suspend(std::coroutine_handle<> handle) {
+    Scheduler* scheduler = Scheduler::current();
+    if ( scheduler == nullptr ) {
+        throw SocketException("No Scheduler is running on this thread");
+    }
+    mHandle = handle;
+    scheduler->wait(*this);
+}
+
+
+AsyncAccept::AsyncAccept(Socket& socket)
+    : AsyncOperation(socket, IOEvent::Read) {}
+
+bool AsyncAccept::attempt() {
+    sockaddr_storage clientAddr;
+    socklen_t clientAddrSize;
+    int clientSocket;
+    do {
+        clientAddrSize = sizeof(clientAddr);
+        clientSocket = ::accept4(
+            mSocket.getNativeHandle(),
+            reinterpret_cast<sockaddr*>(&clientAddr),
+            &clientAddrSize,
+            SOCK_NONBLOCK | SOCK_CLOEXEC
+        );
+    } while ( clientSocket == -1 && errno == EINTR );
+
+    if ( clientSocket == -1 ) {
+        if ( wouldBlock(errno) ) {
+            return false;
+        }
+        mError = errno;
+        return true;
+    }
+
+    mConnection = clientSocket;
+    mPeer = Endpoint(clientAddr, clientAddrSize);
+    return true;
+}
+
+AsyncAccept::~AsyncAccept() {
+    if ( mConnection != -1 ) {
+        ::close(mConnection);
+    }
+}
+
+Socket AsyncAccept::await_resume() {
+    if ( mError != 0 ) {
+        throw SocketException(mError, "Failed to accept");
+    }
+    Socket connection(std::exchange(mConnection, -1), mPeer, mSocket.mProtocol);
+    connection.mState = SocketState::Connected;
+    connection.mNonBlocking = true;
+    return connection;
+}
+
+
+AsyncConnect::AsyncConnect(Socket& socket, const Endpoint& endpoint)
+    : AsyncOperation(socket, IOEvent::Write),
+    mEndpoint(endpoint) {}
+
+bool AsyncConnect::attempt() {
+    if ( !mStarted ) {
+        mStarted = true;
+        if ( ::connect(mSocket.getNativeHandle(), mEndpoint.c_addr(), mEndpoint.c_size()) == 0 ) {
+            mSocket.mState = SocketState::Connected;
+            return true;
+        }
+        if ( errno == EINPROGRESS || errno == EINTR ) {
+            return false;
+        }
+        mError = errno;
+        return true;
+    }
+
+    int error = 0;
+    socklen_t size = sizeof(error);
+    if ( getsockopt(mSocket.getNativeHandle(), SOL_SOCKET, SO_ERROR, &error, &size) == -1 ) {
+        error = errno;
+    }
+
+    mError = error;
+    if ( error == 0 ) {
+        mSocket.mState = SocketState::Connected;
+    }
+    return true;
+}
+
+void AsyncConnect::await_resume() {
+    if ( mError != 0 ) {
+        throw SocketException(mError, "Failed to connect");
+    }
+}
+
+
+AsyncRecv::AsyncRecv(Socket& socket, std::span<std::byte> buffer)
+    : AsyncOperation(socket, IOEvent::Read),
+    mBuffer(buffer) {}
+
+bool AsyncRecv::attempt() {
+    ssize_t received;
+    do {
+        received = ::recv(mSocket.getNativeHandle(), mBuffer.data(), mBuffer.size(), MSG_DONTWAIT);
+    } while ( received == -1 && errno == EINTR );
+
+    if ( received == -1 ) {
+        if ( wouldBlock(errno) ) {
+            return false;
+        }
+        mError = errno;
+        return true;
+    }
+
+    mReceived = static_cast<size_t>(received);
+    return true;
+}
+
+size_t AsyncRecv::await_resume() {
+    if ( mError != 0 ) {
+        throw RecvError(mError, "Failed to receive");
+    }
+    return mReceived;
+}
+
+
+AsyncSend::AsyncSend(Socket& socket, std::span<const std::byte> data)
+    : AsyncOperation(socket, IOEvent::Write),
+    mData(data) {}
+
+bool AsyncSend::attempt() {
+    ssize_t sent;
+    do {
+        sent = ::send(mSocket.getNativeHandle(), mData.data(), mData.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+    } while ( sent == -1 && errno == EINTR );
+
+    if ( sent == -1 ) {
+        if ( wouldBlock(errno) ) {
+            return false;
+        }
+        mError = errno;
+        return true;
+    }
+
+    mSent = static_cast<size_t>(sent);
+    return true;
+}
+
+size_t AsyncSend::await_resume() {
+    if ( mError != 0 ) {
+        throw SendError(mError, "Failed to send");
+    }
+    return mSent;
+}
+
+
+AsyncRecvFrom::AsyncRecvFrom(Socket& socket, UDPPacket& packet)
+    : AsyncOperation(socket, IOEvent::Read),
+    mPacket(packet) {}
+
+bool AsyncRecvFrom::attempt() {
+    // the same recvmsg path as Socket::recv_from(), only without blocking
+    IOResult<size_t> received = mSocket.receiveFrom(mPacket, MSG_DONTWAIT);
+    if ( !received ) {
+        if ( received.wouldBlock() ) {
+            return false;
+        }
+        mError = received.error().value();
+        return true;
+    }
+
+    mReceived = received.value();
+    return true;
+}
+
+size_t AsyncRecvFrom::await_resume() {
+    if ( mError == EMSGSIZE ) {
+        throw RecvError(EMSGSIZE, "Received datagram is larger than the packet");
+    }
+    if ( mError != 0 ) {
+        throw RecvError(mError, "Failed to receive");
+    }
+    return mReceived;
+}
+
+}   // namespace SocketSparrow
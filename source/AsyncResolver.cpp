@@ -0,0 +1,518 @@
+#include "AsyncResolver.hpp"
+#include "Exceptions.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <random>
+#include <tuple>
+
+#include <poll.h>
+#include <sys/socket.h>
+
+namespace SocketSparrow {
+
+namespace {
+
+constexpr uint16_t TYPE_A = 1;
+constexpr uint16_t TYPE_AAAA = 28;
+constexpr uint16_t CLASS_IN = 1;
+constexpr size_t HEADER_SIZE = 12;
+constexpr size_t MAX_MESSAGE_SIZE = 4096;
+
+constexpr uint16_t FLAG_RESPONSE = 0x8000;
+constexpr uint16_t FLAG_TRUNCATED = 0x0200;
+constexpr uint16_t FLAG_RECURSION = 0x0100;
+constexpr uint16_t RCODE_MASK = 0x000f;
+constexpr uint16_t RCODE_NAME_ERROR = 3;
+
+uint16_t readU16(const uint8_t* data) {
+    return static_cast<uint16_t>(data[0] << 8 | data[1]);
+}
+
+uint32_t readU32(const uint8_t* data) {
+    return static_cast<uint32_t>(readU16(data)) << 16 | readU16(data + 2);
+}
+
+void writeU16(std::vector<uint8_t>& message, uint16_t value) {
+    message.push_back(static_cast<uint8_t>(value >> 8));
+    message.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * @brief skip an (optionally compressed) name, returns 0 if it runs past the end
+ */
+size_t skipName(const uint8_t* data, size_t size, size_t offset) {
+    while ( offset < size ) {
+        uint8_t length = data[offset];
+        if ( length == 0 ) {
+            return offset + 1;
+        }
+        if ( (length & 0xc0) == 0xc0 ) {
+            return offset + 2 <= size ? offset + 2 : 0;
+        }
+        offset += length + 1;
+    }
+    return 0;
+}
+
+std::vector<uint8_t> buildQuery(const std::string& hostname, uint16_t type) {
+    std::vector<uint8_t> message;
+    message.reserve(HEADER_SIZE + hostname.size() + 6);
+    writeU16(message, 0);               // id, patched per attempt
+    writeU16(message, FLAG_RECURSION);
+    writeU16(message, 1);               // questions
+    writeU16(message, 0);
+    writeU16(message, 0);
+    writeU16(message, 0);
+
+    size_t start = 0;
+    while ( start < hostname.size() ) {
+        size_t end = hostname.find('.', start);
+        if ( end == std::string::npos ) {
+            end = hostname.size();
+        }
+        message.push_back(static_cast<uint8_t>(end - start));
+        for ( size_t i = start; i < end; i++ ) {
+            message.push_back(static_cast<uint8_t>(std::tolower(static_cast<unsigned char>(hostname[i]))));
+        }
+        start = end + 1;
+    }
+    message.push_back(0);
+    writeU16(message, type);
+    writeU16(message, CLASS_IN);
+    return message;
+}
+
+std::string normalize(const std::string& hostname) {
+    std::string name = hostname;
+    if ( !name.empty() && name.back() == '.' ) {
+        name.pop_back();
+    }
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    if ( name.empty() || name.size() > 253 ) {
+        throw InvalidAddressException(hostname, "Invalid hostname");
+    }
+
+    size_t label = 0;
+    for ( char c : name ) {
+        if ( c == '.' ) {
+            if ( label == 0 ) {
+                throw InvalidAddressException(hostname, "Invalid hostname");
+            }
+            label = 0;
+        } else if ( ++label > 63 ) {
+            throw InvalidAddressException(hostname, "Invalid hostname");
+        }
+    }
+    if ( label == 0 ) {
+        throw InvalidAddressException(hostname, "Invalid hostname");
+    }
+    return name;
+}
+
+std::string cacheKey(uint16_t type, const std::string& name) {
+    return (type == TYPE_A ? "A " : "AAAA ") + name;
+}
+
+Endpoint withPort(const Endpoint& address, uint16_t port) {
+    sockaddr_storage storage = {};
+    std::memcpy(&storage, address.c_addr(), address.c_size());
+    if ( storage.ss_family == AF_INET ) {
+        reinterpret_cast<sockaddr_in*>(&storage)->sin_port = htons(port);
+    } else {
+        reinterpret_cast<sockaddr_in6*>(&storage)->sin6_port = htons(port);
+    }
+    return Endpoint(storage, address.c_size());
+}
+
+std::optional<Endpoint> parseLiteral(const std::string& hostname, uint16_t port) {
+    sockaddr_storage storage = {};
+    auto ipv4 = reinterpret_cast<sockaddr_in*>(&storage);
+    if ( inet_pton(AF_INET, hostname.c_str(), &ipv4->sin_addr) == 1 ) {
+        ipv4->sin_family = AF_INET;
+        ipv4->sin_port = htons(port);
+        return Endpoint(storage, sizeof(sockaddr_in));
+    }
+
+    auto ipv6 = reinterpret_cast<sockaddr_in6*>(&storage);
+    if ( inet_pton(AF_INET6, hostname.c_str(), &ipv6->sin6_addr) == 1 ) {
+        ipv6->sin6_family = AF_INET6;
+        ipv6->sin6_port = htons(port);
+        return Endpoint(storage, sizeof(sockaddr_in6));
+    }
+    return std::nullopt;
+}
+
+std::vector<uint16_t> queryTypes(AddressFamily af) {
+    switch ( af ) {
+    case AddressFamily::IPv4: return { TYPE_A };
+    case AddressFamily::IPv6: return { TYPE_AAAA };
+    default: return { TYPE_A, TYPE_AAAA };
+    }
+}
+
+std::mt19937 seededRandom() {
+    std::random_device device;
+    std::seed_seq seed{ device(), device(), device(), device() };
+    return std::mt19937(seed);
+}
+
+} // namespace
+
+AsyncResolver::AsyncResolver(const Endpoint& server, Options options)
+    : mServer(server),
+    mOptions(options),
+    mSocket(server.getAddressFamily(), SocketType::UDP),
+    mShards(std::max<size_t>(options.shards, 1)),
+    mRandom(seededRandom()) {
+    mSocket.enableNonBlocking(true);
+    if ( mOptions.attempts == 0 ) {
+        mOptions.attempts = 1;
+    }
+}
+
+AsyncResolver::AsyncResolver(const Endpoint& server)
+    : AsyncResolver(server, Options()) {}
+
+AsyncResolver::~AsyncResolver() {
+    detach();
+}
+
+AsyncResolver::Shard& AsyncResolver::shardFor(const std::string& key) {
+    return mShards[std::hash<std::string>{}(key) % mShards.size()];
+}
+
+std::optional<std::vector<Endpoint>> AsyncResolver::cachedAddresses(const std::string& key) {
+    Shard& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
+
+    auto entry = shard.entries.find(key);
+    if ( entry == shard.entries.end() ) {
+        return std::nullopt;
+    }
+    if ( entry->second.expires <= Clock::now() ) {
+        shard.entries.erase(entry);
+        return std::nullopt;
+    }
+    return entry->second.addresses;
+}
+
+void AsyncResolver::store(const std::string& key, std::vector<Endpoint> addresses, std::chrono::seconds ttl) {
+    Shard& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
+    shard.entries[key] = CacheEntry{ std::move(addresses), Clock::now() + ttl };
+}
+
+void AsyncResolver::resolve(const std::string& hostname, uint16_t port, Callback callback, AddressFamily af) {
+    if ( auto literal = parseLiteral(hostname, port) ) {
+        callback(ResolveStatus::Success, { *literal });
+        return;
+    }
+
+    std::string name = normalize(hostname);
+    auto lookup = std::make_shared<Lookup>();
+    lookup->port = port;
+    lookup->callback = std::move(callback);
+
+    std::vector<uint16_t> types = queryTypes(af);
+    lookup->results.resize(types.size());
+
+    std::vector<std::tuple<size_t, uint16_t, std::string>> missing;
+    for ( size_t slot = 0; slot < types.size(); slot++ ) {
+        std::string key = cacheKey(types[slot], name);
+        if ( auto addresses = cachedAddresses(key) ) {
+            for ( const Endpoint& address : *addresses ) {
+                lookup->results[slot].push_back(withPort(address, port));
+            }
+        } else {
+            missing.emplace_back(slot, types[slot], std::move(key));
+        }
+    }
+
+    if ( missing.empty() ) {
+        complete(*lookup);
+        return;
+    }
+
+    lookup->outstanding = missing.size();
+    for ( auto& [slot, type, key] : missing ) {
+        uint16_t id = freshId();
+        Query& query = mQueries[id];
+        query.lookup = lookup;
+        query.slot = slot;
+        query.key = std::move(key);
+        query.message = buildQuery(name, type);
+        query.attemptsLeft = mOptions.attempts;
+        send(id, query);
+    }
+}
+
+std::optional<std::vector<Endpoint>> AsyncResolver::cached(const std::string& hostname, uint16_t port, AddressFamily af) {
+    std::string name = normalize(hostname);
+    std::vector<Endpoint> endpoints;
+    for ( uint16_t type : queryTypes(af) ) {
+        auto addresses = cachedAddresses(cacheKey(type, name));
+        if ( !addresses ) {
+            return std::nullopt;
+        }
+        for ( const Endpoint& address : *addresses ) {
+            endpoints.push_back(withPort(address, port));
+        }
+    }
+    return endpoints;
+}
+
+uint16_t AsyncResolver::freshId() {
+    std::uniform_int_distribution<uint16_t> distribution;
+    uint16_t id;
+    do {
+        id = distribution(mRandom);
+    } while ( mQueries.contains(id) );
+    return id;
+}
+
+void AsyncResolver::send(uint16_t id, Query& query) {
+    query.message[0] = static_cast<uint8_t>(id >> 8);
+    query.message[1] = static_cast<uint8_t>(id);
+    query.attemptsLeft--;
+    query.deadline = Clock::now() + mOptions.timeout;
+
+    try {
+        mSocket.send_to(std::as_bytes(std::span(query.message)), mServer);
+    } catch ( const SendError& ) {
+        // counts as a lost query, processTimeouts() retries it
+    }
+}
+
+void AsyncResolver::process() {
+    uint8_t buffer[MAX_MESSAGE_SIZE];
+    while ( true ) {
+        sockaddr_storage source;
+        socklen_t sourceSize = sizeof(source);
+        ssize_t received = ::recvfrom(
+            mSocket.getNativeHandle(),
+            buffer,
+            sizeof(buffer),
+            MSG_DONTWAIT,
+            reinterpret_cast<sockaddr*>(&source),
+            &sourceSize
+        );
+        if ( received == -1 ) {
+            if ( errno == EINTR ) {
+                continue;
+            }
+            return;
+        }
+
+        // only trust answers from the configured server
+        if ( Endpoint(source, sourceSize) != mServer ) {
+            continue;
+        }
+        handleResponse(buffer, static_cast<size_t>(received));
+    }
+}
+
+void AsyncResolver::handleResponse(const uint8_t* data, size_t size) {
+    if ( size < HEADER_SIZE ) {
+        return;
+    }
+
+    uint16_t id = readU16(data);
+    auto query = mQueries.find(id);
+    if ( query == mQueries.end() ) {
+        return;
+    }
+
+    // the question has to be echoed back unchanged
+    const std::vector<uint8_t>& sent = query->second.message;
+    size_t questionEnd = sent.size();
+    if ( size < questionEnd || std::memcmp(data + HEADER_SIZE, sent.data() + HEADER_SIZE, questionEnd - HEADER_SIZE) != 0 ) {
+        return;
+    }
+
+    uint16_t flags = readU16(data + 2);
+    if ( (flags & FLAG_RESPONSE) == 0 ) {
+        return;
+    }
+
+    uint16_t rcode = flags & RCODE_MASK;
+    if ( rcode == RCODE_NAME_ERROR ) {
+        finish(id, ResolveStatus::NotFound, {});
+        return;
+    }
+    if ( rcode != 0 ) {
+        finish(id, ResolveStatus::Failed, {});
+        return;
+    }
+
+    uint16_t type = readU16(sent.data() + questionEnd - 4);
+    uint16_t answers = readU16(data + 6);
+    std::vector<Endpoint> addresses;
+    uint32_t ttl = static_cast<uint32_t>(mOptions.maxTtl.count());
+
+    size_t offset = questionEnd;
+    for ( uint16_t i = 0; i < answers; i++ ) {
+        offset = skipName(data, size, offset);
+        if ( offset == 0 || offset + 10 > size ) {
+            break;
+        }
+
+        uint16_t recordType = readU16(data + offset);
+        uint16_t recordClass = readU16(data + offset + 2);
+        uint32_t recordTtl = readU32(data + offset + 4);
+        uint16_t length = readU16(data + offset + 8);
+        offset += 10;
+        if ( offset + length > size ) {
+            break;
+        }
+
+        if ( recordClass == CLASS_IN && recordType == type ) {
+            sockaddr_storage storage = {};
+            if ( type == TYPE_A && length == 4 ) {
+                auto ipv4 = reinterpret_cast<sockaddr_in*>(&storage);
+                ipv4->sin_family = AF_INET;
+                std::memcpy(&ipv4->sin_addr, data + offset, 4);
+                addresses.emplace_back(storage, sizeof(sockaddr_in));
+                ttl = std::min(ttl, recordTtl);
+            } else if ( type == TYPE_AAAA && length == 16 ) {
+                auto ipv6 = reinterpret_cast<sockaddr_in6*>(&storage);
+                ipv6->sin6_family = AF_INET6;
+                std::memcpy(&ipv6->sin6_addr, data + offset, 16);
+                addresses.emplace_back(storage, sizeof(sockaddr_in6));
+                ttl = std::min(ttl, recordTtl);
+            }
+        }
+        offset += length;
+    }
+
+    if ( addresses.empty() ) {
+        // a truncated answer without usable records is not a proof that the name has none
+        finish(id, (flags & FLAG_TRUNCATED) ? ResolveStatus::Failed : ResolveStatus::NotFound, {});
+        return;
+    }
+
+    store(query->second.key, addresses, std::chrono::seconds(ttl));
+    finish(id, ResolveStatus::Success, std::move(addresses));
+}
+
+void AsyncResolver::finish(uint16_t id, ResolveStatus status, std::vector<Endpoint> addresses) {
+    auto entry = mQueries.find(id);
+    Query query = std::move(entry->second);
+    mQueries.erase(entry);
+
+    if ( status == ResolveStatus::NotFound ) {
+        store(query.key, {}, mOptions.negativeTtl);
+    }
+
+    Lookup& lookup = *query.lookup;
+    for ( const Endpoint& address : addresses ) {
+        lookup.results[query.slot].push_back(withPort(address, lookup.port));
+    }
+    if ( status == ResolveStatus::Timeout || status == ResolveStatus::Failed ) {
+        lookup.failure = status;
+    }
+
+    if ( --lookup.outstanding == 0 ) {
+        complete(lookup);
+    }
+}
+
+void AsyncResolver::complete(Lookup& lookup) {
+    std::vector<Endpoint> endpoints;
+    for ( auto& result : lookup.results ) {
+        endpoints.insert(endpoints.end(), result.begin(), result.end());
+    }
+
+    if ( !endpoints.empty() ) {
+        lookup.callback(ResolveStatus::Success, endpoints);
+    } else {
+        lookup.callback(lookup.failure.value_or(ResolveStatus::NotFound), endpoints);
+    }
+}
+
+void AsyncResolver::processTimeouts() {
+    auto now = Clock::now();
+    std::vector<uint16_t> retries;
+    std::vector<uint16_t> expired;
+    for ( const auto& [id, query] : mQueries ) {
+        if ( query.deadline > now ) {
+            continue;
+        }
+        if ( query.attemptsLeft > 0 ) {
+            retries.push_back(id);
+        } else {
+            expired.push_back(id);
+        }
+    }
+
+    // every attempt gets a fresh id, a spoofed answer can't aim at the id seen on the wire before
+    for ( uint16_t id : retries ) {
+        uint16_t retryId = freshId();
+        auto node = mQueries.extract(id);
+        node.key() = retryId;
+        auto inserted = mQueries.insert(std::move(node));
+        send(retryId, inserted.position->second);
+    }
+
+    for ( uint16_t id : expired ) {
+        finish(id, ResolveStatus::Timeout, {});
+    }
+}
+
+int AsyncResolver::nextTimeout() const {
+    if ( mQueries.empty() ) {
+        return -1;
+    }
+
+    auto deadline = Clock::time_point::max();
+    for ( const auto& [id, query] : mQueries ) {
+        deadline = std::min(deadline, query.deadline);
+    }
+
+    auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now());
+    return static_cast<int>(std::max<int64_t>(remaining.count(), 0));
+}
+
+void AsyncResolver::poll(int timeoutMs) {
+    int timeout = nextTimeout();
+    if ( timeout < 0 || (timeoutMs >= 0 && timeoutMs < timeout) ) {
+        timeout = timeoutMs;
+    }
+
+    pollfd descriptor = { mSocket.getNativeHandle(), POLLIN, 0 };
+    if ( ::poll(&descriptor, 1, timeout) > 0 ) {
+        process();
+    }
+    processTimeouts();
+}
+
+void AsyncResolver::attach(Reactor& reactor) {
+    detach();
+    reactor.add(mSocket, IOEvent::Read, [this](Socket&, IOEvent) { process(); });
+    mReactor = &reactor;
+}
+
+void AsyncResolver::detach() {
+    if ( mReactor != nullptr ) {
+        if ( mReactor->contains(mSocket) ) {
+            mReactor->remove(mSocket);
+        }
+        mReactor = nullptr;
+    }
+}
+
+size_t AsyncResolver::pending() const {
+    return mQueries.size();
+}
+
+void AsyncResolver::clearCache() {
+    for ( Shard& shard : mShards ) {
+        std::lock_guard lock(shard.mutex);
+        shard.entries.clear();
+    }
+}
+
+}   // namespace SocketSparrow
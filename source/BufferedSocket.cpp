@@ -0,0 +1,150 @@
+#include "BufferedSocket.hpp"
+#include "Exceptions.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace SocketSparrow {
+
+BufferedSocketReader::BufferedSocketReader(Socket& socket, size_t capacity)
+    : mSocket(socket),
+    mBuffer(capacity) {}
+
+size_t BufferedSocketReader::fill() {
+    std::span<std::byte> space = mBuffer.writable();
+    if ( space.empty() ) {
+        return 0;
+    }
+    ssize_t received = mSocket.recv(space);
+    mBuffer.commit(received);
+    return received;
+}
+
+std::span<const std::byte> BufferedSocketReader::peek(size_t count) {
+    if ( count > mBuffer.capacity() ) {
+        throw SocketException("Cannot peek beyond the BufferedSocketReader capacity");
+    }
+    while ( mBuffer.size() < count ) {
+        if ( fill() == 0 ) {
+            break;
+        }
+    }
+    return mBuffer.readable().first(std::min(count, mBuffer.size()));
+}
+
+size_t BufferedSocketReader::readExact(std::span<std::byte> buffer) {
+    // nothing is consumed before the request is complete, a RecvError leaves the buffer as it was
+    if ( buffer.size() <= mBuffer.capacity() ) {
+        std::span<const std::byte> data = peek(buffer.size());
+        std::memcpy(buffer.data(), data.data(), data.size());
+        mBuffer.consume(data.size());
+        return data.size();
+    }
+
+    // a remainder that would not fit into the buffer is not worth copying through it
+    const size_t buffered = mBuffer.size();
+    std::memcpy(buffer.data(), mBuffer.readable().data(), buffered);
+    size_t total = buffered;
+    while ( total < buffer.size() ) {
+        ssize_t received = 0;
+        try {
+            received = mSocket.recv(buffer.subspan(total));
+        } catch ( const RecvError& ) {
+            if ( total == buffered ) {
+                throw;
+            }
+            // bytes received directly cannot go back into the buffer, hand them out instead
+            break;
+        }
+        if ( received == 0 ) {
+            break;
+        }
+        total += received;
+    }
+    mBuffer.consume(buffered);
+    return total;
+}
+
+std::optional<std::string_view> BufferedSocketReader::readUntil(std::string_view delimiter) {
+    size_t searchFrom = 0;
+    while ( true ) {
+        std::span<const std::byte> data = mBuffer.readable();
+        std::string_view text(reinterpret_cast<const char*>(data.data()), data.size());
+        size_t position = text.find(delimiter, searchFrom);
+        if ( position != std::string_view::npos ) {
+            mBuffer.consume(position + delimiter.size());
+            return text.substr(0, position);
+        }
+
+        if ( mBuffer.space() == 0 ) {
+            throw SocketException("No delimiter within the BufferedSocketReader capacity");
+        }
+        // a delimiter split across two receives starts in the last delimiter.size() - 1 bytes
+        searchFrom = text.size() >= delimiter.size() ? text.size() - delimiter.size() + 1 : 0;
+        if ( fill() == 0 ) {
+            return std::nullopt;
+        }
+    }
+}
+
+void BufferedSocketReader::consume(size_t count) {
+    mBuffer.consume(count);
+}
+
+size_t BufferedSocketReader::buffered() const {
+    return mBuffer.size();
+}
+
+size_t BufferedSocketReader::capacity() const {
+    return mBuffer.capacity();
+}
+
+BufferedSocketWriter::BufferedSocketWriter(Socket& socket, size_t capacity)
+    : mSocket(socket),
+    mBuffer(capacity) {}
+
+BufferedSocketWriter::~BufferedSocketWriter() {
+    try {
+        flush();
+    } catch ( const SocketSparrowException& ) {
+        // the peer is gone, nobody is left to report it to
+    }
+}
+
+void BufferedSocketWriter::write(std::span<const std::byte> data) {
+    if ( data.size() > mBuffer.space() ) {
+        flush();
+    }
+
+    if ( data.size() >= mBuffer.capacity() ) {
+        while ( !data.empty() ) {
+            data = data.subspan(mSocket.send(data));
+        }
+        return;
+    }
+
+    while ( !data.empty() ) {
+        std::span<std::byte> space = mBuffer.writable();
+        size_t count = std::min(space.size(), data.size());
+        std::memcpy(space.data(), data.data(), count);
+        mBuffer.commit(count);
+        data = data.subspan(count);
+    }
+}
+
+BufferedSocketWriter& BufferedSocketWriter::operator<<(std::string_view data) {
+    write(std::as_bytes(std::span(data)));
+    return *this;
+}
+
+void BufferedSocketWriter::flush() {
+    while ( mBuffer.size() > 0 ) {
+        mBuffer.consume(mSocket.send(mBuffer.readable()));
+    }
+}
+
+size_t BufferedSocketWriter::buffered() const {
+    return mBuffer.size();
+}
+
+}   // namespace SocketSparrow
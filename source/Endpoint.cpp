@@ -3,11 +3,22 @@
 #include "Exceptions.hpp"
 
 #include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <assert.h>
 
 
 namespace SocketSparrow {
 
+static_assert(std::is_trivially_copyable_v<Endpoint>, "Endpoint has to stay a cheap value type");
+// the sockaddr_un dominates, nothing else may grow the Endpoint (or a UDPPacket) beyond it
+static_assert(sizeof(Endpoint) == 112, "Endpoint has to stay a bare sockaddr_un");
+static_assert(sizeof(sockaddr_un) - offsetof(sockaddr_un, sun_path) <= UINT8_MAX, "Unix address size has to fit UnixAddress::size");
+
+Endpoint::Endpoint()
+    : mSockaddr{} {}
+
 Endpoint::Endpoint(sockaddr* addr, socklen_t size) {
     if( addr == nullptr ) {
         throw InvalidAddressException();
@@ -17,21 +28,21 @@ Endpoint::Endpoint(sockaddr* addr, socklen_t size) {
         throw InvalidAddressException();
     } else if(addr->sa_family == AF_INET6 && size != sizeof(sockaddr_in6)) {
         throw InvalidAddressException();
-    } else if(addr->sa_family != AF_INET && addr->sa_family != AF_INET6) {
+    } else if(addr->sa_family == AF_UNIX && (size < offsetof(sockaddr_un, sun_path) || size > sizeof(sockaddr_un))) {
+        throw InvalidAddressException();
+    } else if(addr->sa_family != AF_INET && addr->sa_family != AF_INET6 && addr->sa_family != AF_UNIX) {
         throw InvalidAddressFamilyException();
     }
 
-    memcpy(&mSockaddr.base, addr, size);
-    mAddressFamily = Util::getAddressFamily(mSockaddr.base.sa_family);
+    assign(addr, size);
 }
 
-Endpoint::Endpoint(const std::string& hostname, uint16_t port, AddressFamily af)
-    : mAddressFamily(af) {
+Endpoint::Endpoint(const std::string& hostname, uint16_t port, AddressFamily af) {
 
     struct addrinfo hints = {};
-    hints.ai_family = Util::getNativeAddressFamily(mAddressFamily);
+    hints.ai_family = Util::getNativeAddressFamily(af);
 
-    switch ( mAddressFamily ) {
+    switch ( af ) {
     case AddressFamily::IPv4:
     {
 
@@ -66,8 +77,7 @@ Endpoint::Endpoint(const std::string& hostname, uint16_t port, AddressFamily af)
 }
 
 Endpoint::Endpoint(in_addr_t ip, uint16_t port) {
-    mAddressFamily = AddressFamily::IPv4;
-    mSockaddr.ipv4.sin_family = Util::getNativeAddressFamily(mAddressFamily);
+    mSockaddr.ipv4.sin_family = Util::getNativeAddressFamily(AddressFamily::IPv4);
     mSockaddr.ipv4.sin_port = htons(port);
     mSockaddr.ipv4.sin_addr.s_addr = ip;
 
@@ -76,57 +86,258 @@ Endpoint::Endpoint(in_addr_t ip, uint16_t port) {
     }
 }
 
-Endpoint::Endpoint(AddressFamily af, uint16_t port)
-    : mAddressFamily(af) {
-    switch ( mAddressFamily ) {
+Endpoint::Endpoint(AddressFamily af, uint16_t port) {
+    switch ( af ) {
     case AddressFamily::IPv4:
-        mSockaddr.ipv4.sin_family = Util::getNativeAddressFamily(mAddressFamily);
+        mSockaddr.ipv4.sin_family = Util::getNativeAddressFamily(af);
         mSockaddr.ipv4.sin_port = htons(port);
         mSockaddr.ipv4.sin_addr.s_addr = htonl(INADDR_ANY);
         break;
     case AddressFamily::IPv6:
-        mSockaddr.ipv6.sin6_family = Util::getNativeAddressFamily(mAddressFamily);
+        mSockaddr.ipv6.sin6_family = Util::getNativeAddressFamily(af);
         mSockaddr.ipv6.sin6_port = htons(port);
         mSockaddr.ipv6.sin6_addr = in6addr_any;
         break;
     default:
-        throw InvalidAddressFamilyException(mAddressFamily, "Invalid Address Family");
+        throw InvalidAddressFamilyException(af, "Invalid Address Family");
     }
 
 }
 
-Endpoint::Endpoint(sockaddr_storage addr, socklen_t size) {
-    memcpy(&mSockaddr.base, &addr, size);
-    mAddressFamily = Util::getAddressFamily(mSockaddr.base.sa_family);
+Endpoint::Endpoint(const sockaddr_storage& addr, socklen_t size)
+    : mSockaddr{} {
+    if ( size == 0 ) {
+        return;     // unbound Unix datagram senders have no address
+    }
+    if ( size > sizeof(sockaddr_un) ) {
+        throw InvalidAddressException();
+    }
 
-    if ( mAddressFamily == AddressFamily::Unknown ) {
+    const AddressFamily family = Util::getAddressFamily(addr.ss_family);
+    if ( family == AddressFamily::Unknown ) {
+        throw InvalidAddressException();
+    }
+    if ( (family == AddressFamily::IPv4 && size < sizeof(sockaddr_in))
+        || (family == AddressFamily::IPv6 && size < sizeof(sockaddr_in6))
+        || (family == AddressFamily::Unix && size < offsetof(sockaddr_un, sun_path)) ) {
         throw InvalidAddressException();
     }
+
+    assign(reinterpret_cast<const sockaddr*>(&addr), size);
+}
+
+void Endpoint::assign(const sockaddr* addr, socklen_t size) {
+    // fixed sizes for IP addresses, a variable one is copied like a whole sockaddr_un
+    switch ( addr->sa_family ) {
+    case AF_INET:
+        memcpy(&mSockaddr.ipv4, addr, sizeof(sockaddr_in));
+        break;
+    case AF_INET6:
+        memcpy(&mSockaddr.ipv6, addr, sizeof(sockaddr_in6));
+        break;
+    default:
+        memcpy(&mSockaddr.local.address, addr, size);
+        mSockaddr.local.size = static_cast<uint8_t>(size);
+        break;
+    }
 }
 
-Endpoint::~Endpoint() {
+Endpoint Endpoint::unixPath(std::string_view path) {
+    Endpoint endpoint;
+    if ( path.empty() || path.size() >= sizeof(endpoint.mSockaddr.local.address.sun_path) || path.find('\0') != std::string_view::npos ) {
+        throw InvalidAddressException(std::string(path), "Invalid Unix socket path");
+    }
 
+    endpoint.mSockaddr.local.address.sun_family = AF_UNIX;
+    memcpy(endpoint.mSockaddr.local.address.sun_path, path.data(), path.size());
+    endpoint.mSockaddr.local.address.sun_path[path.size()] = '\0';
+    endpoint.mSockaddr.local.size = static_cast<uint8_t>(offsetof(sockaddr_un, sun_path) + path.size() + 1);
+    return endpoint;
+}
+
+Endpoint Endpoint::unixAbstract(std::string_view name) {
+    Endpoint endpoint;
+    if ( name.size() >= sizeof(endpoint.mSockaddr.local.address.sun_path) ) {
+        throw InvalidAddressException(std::string(name), "Abstract Unix socket name is too long");
+    }
+
+    // the leading NUL selects the abstract namespace, the name itself is not NUL terminated
+    endpoint.mSockaddr.local.address.sun_family = AF_UNIX;
+    endpoint.mSockaddr.local.address.sun_path[0] = '\0';
+    memcpy(endpoint.mSockaddr.local.address.sun_path + 1, name.data(), name.size());
+    endpoint.mSockaddr.local.size = static_cast<uint8_t>(offsetof(sockaddr_un, sun_path) + 1 + name.size());
+    return endpoint;
 }
 
 
 AddressFamily Endpoint::getAddressFamily() const {
-    return mAddressFamily;
+    // every constructor checks the family, so it is one of the enumerators
+    return static_cast<AddressFamily>(mSockaddr.base.sa_family);
+}
+
+bool Endpoint::isSpecified() const {
+    return getAddressFamily() != AddressFamily::Unknown;
 }
 
 int Endpoint::getPort() const {
+    if ( getAddressFamily() == AddressFamily::Unix ) {
+        return 0;
+    }
     return ntohs(mSockaddr.ipv4.sin_port);
 }
 
+std::string_view Endpoint::unixName() const {
+    const size_t length = mSockaddr.local.size - offsetof(sockaddr_un, sun_path);
+    const char* path = mSockaddr.local.address.sun_path;
+    if ( length == 0 ) {
+        return {};
+    }
+    if ( path[0] == '\0' ) {
+        return std::string_view(path + 1, length - 1);
+    }
+    return std::string_view(path, strnlen(path, length));
+}
+
+std::string Endpoint::getPath() const {
+    if ( getAddressFamily() != AddressFamily::Unix ) {
+        return {};
+    }
+    return std::string(unixName());
+}
+
+bool Endpoint::isAbstract() const {
+    return getAddressFamily() == AddressFamily::Unix
+        && mSockaddr.local.size > offsetof(sockaddr_un, sun_path)
+        && mSockaddr.local.address.sun_path[0] == '\0';
+}
+
 const sockaddr* Endpoint::c_addr() const {
     return &mSockaddr.base;
 }
 
 socklen_t Endpoint::c_size() const {
-    switch ( mAddressFamily ) {
+    switch ( getAddressFamily() ) {
         case AddressFamily::IPv4: return sizeof(sockaddr_in);
         case AddressFamily::IPv6: return sizeof(sockaddr_in6);
-        default: throw InvalidAddressFamilyException(mAddressFamily);
+        case AddressFamily::Unix: return mSockaddr.local.size;
+        default: throw InvalidAddressFamilyException(getAddressFamily());
+    }
+}
+
+std::string Endpoint::toString() const {
+    // "[" + INET6_ADDRSTRLEN + "]:" + 5 port digits
+    char buffer[INET6_ADDRSTRLEN + 8];
+    size_t length = 0;
+
+    if ( getAddressFamily() == AddressFamily::Unix ) {
+        if ( isAbstract() ) {
+            return "@" + std::string(unixName());
+        }
+        std::string_view name = unixName();
+        return name.empty() ? "unnamed" : std::string(name);
+    }
+
+    switch ( getAddressFamily() ) {
+    case AddressFamily::IPv4:
+        inet_ntop(AF_INET, &mSockaddr.ipv4.sin_addr, buffer, sizeof(buffer));
+        length = strlen(buffer);
+        break;
+    case AddressFamily::IPv6:
+        buffer[0] = '[';
+        inet_ntop(AF_INET6, &mSockaddr.ipv6.sin6_addr, buffer + 1, sizeof(buffer) - 1);
+        length = strlen(buffer);
+        buffer[length++] = ']';
+        break;
+    default:
+        return "unspecified";
+    }
+
+    buffer[length++] = ':';
+    char digits[5];
+    size_t count = 0;
+    unsigned port = getPort();
+    do {
+        digits[count++] = static_cast<char>('0' + port % 10);
+        port /= 10;
+    } while ( port != 0 );
+    while ( count > 0 ) {
+        buffer[length++] = digits[--count];
+    }
+
+    return std::string(buffer, length);
+}
+
+size_t Endpoint::hash() const noexcept {
+    // splitmix64 finalizer over the fields compared by operator==
+    auto mix = [](uint64_t value) {
+        value ^= value >> 30;
+        value *= 0xbf58476d1ce4e5b9ULL;
+        value ^= value >> 27;
+        value *= 0x94d049bb133111ebULL;
+        value ^= value >> 31;
+        return value;
+    };
+
+    uint64_t value = static_cast<uint64_t>(getAddressFamily()) << 16 | static_cast<uint64_t>(getPort());
+    switch ( getAddressFamily() ) {
+    case AddressFamily::IPv4:
+        value ^= static_cast<uint64_t>(mSockaddr.ipv4.sin_addr.s_addr) << 32;
+        break;
+    case AddressFamily::IPv6:
+    {
+        uint64_t high;
+        uint64_t low;
+        memcpy(&high, mSockaddr.ipv6.sin6_addr.s6_addr, sizeof(high));
+        memcpy(&low, mSockaddr.ipv6.sin6_addr.s6_addr + sizeof(high), sizeof(low));
+        value = mix(value ^ high) ^ low ^ (static_cast<uint64_t>(mSockaddr.ipv6.sin6_scope_id) << 32);
+    } break;
+    case AddressFamily::Unix:
+        value ^= std::hash<std::string_view>()(unixName()) ^ (isAbstract() ? 1 : 0);
+        break;
+    default:
+        return 0;
+    }
+    return mix(value);
+}
+
+bool Endpoint::operator==(const Endpoint& other) const noexcept {
+    return (*this <=> other) == 0;
+}
+
+std::strong_ordering Endpoint::operator<=>(const Endpoint& other) const noexcept {
+    if ( auto order = getAddressFamily() <=> other.getAddressFamily(); order != 0 ) {
+        return order;
+    }
+
+    int address = 0;
+    switch ( getAddressFamily() ) {
+    case AddressFamily::IPv4:
+        address = memcmp(&mSockaddr.ipv4.sin_addr, &other.mSockaddr.ipv4.sin_addr, sizeof(in_addr));
+        break;
+    case AddressFamily::IPv6:
+        address = memcmp(&mSockaddr.ipv6.sin6_addr, &other.mSockaddr.ipv6.sin6_addr, sizeof(in6_addr));
+        break;
+    case AddressFamily::Unix:
+        if ( auto order = isAbstract() <=> other.isAbstract(); order != 0 ) {
+            return order;
+        }
+        return unixName() <=> other.unixName();
+    default:
+        return std::strong_ordering::equal;
+    }
+
+    if ( address != 0 ) {
+        return address <=> 0;
+    }
+
+    if ( auto order = getPort() <=> other.getPort(); order != 0 ) {
+        return order;
+    }
+
+    if ( getAddressFamily() == AddressFamily::IPv6 ) {
+        return mSockaddr.ipv6.sin6_scope_id <=> other.mSockaddr.ipv6.sin6_scope_id;
     }
+    return std::strong_ordering::equal;
 }
 
-}   // namespace SocketSparrow
\ No newline at end of file
+}   // namespace SocketSparrow
@@ -0,0 +1,52 @@
+#include "EndpointCache.hpp"
+#include "Exceptions.hpp"
+
+namespace SocketSparrow {
+
+EndpointCache::EndpointCache(size_t capacity)
+    : mCapacity(capacity) {
+    if ( capacity == 0 ) {
+        throw SocketException("EndpointCache needs a capacity of at least one");
+    }
+    mEntries.reserve(capacity);
+}
+
+std::shared_ptr<Endpoint> EndpointCache::intern(const Endpoint& endpoint) {
+    if ( !endpoint.isSpecified() ) {
+        throw InvalidAddressException("Cannot cache an unspecified Endpoint");
+    }
+
+    mClock++;
+    Entry* oldest = nullptr;
+    for ( Entry& entry : mEntries ) {
+        if ( *entry.endpoint == endpoint ) {
+            entry.lastUse = mClock;
+            return entry.endpoint;
+        }
+        if ( oldest == nullptr || entry.lastUse < oldest->lastUse ) {
+            oldest = &entry;
+        }
+    }
+
+    auto shared = std::make_shared<Endpoint>(endpoint);
+    if ( mEntries.size() < mCapacity ) {
+        mEntries.push_back({ shared, mClock });
+    } else {
+        *oldest = { shared, mClock };
+    }
+    return shared;
+}
+
+size_t EndpointCache::size() const {
+    return mEntries.size();
+}
+
+size_t EndpointCache::capacity() const {
+    return mCapacity;
+}
+
+void EndpointCache::clear() {
+    mEntries.clear();
+}
+
+}   // namespace SocketSparrow
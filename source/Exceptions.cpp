@@ -36,7 +36,12 @@ InvalidAddressException::InvalidAddressException(const std::string& address, con
 SocketException::SocketException(): SocketSparrowException("Socket Exception") {}
 SocketException::SocketException(const std::string& message): SocketSparrowException(message) {}
 SocketException::SocketException(int error, const std::string& message)
-    : SocketSparrowException(message + ": [" + std::to_string(error) + "] " + strerror(error)) {}
+    : SocketSparrowException(message + ": [" + std::to_string(error) + "] " + strerror(error)),
+    mErrorCode(error) {}
+
+int SocketException::getErrorCode() const noexcept {
+    return mErrorCode;
+}
 
 SendError::SendError(): SocketException("Send Error") {}
 SendError::SendError(const std::string& message): SocketException(message) {}
@@ -0,0 +1,202 @@
+#include "Framer.hpp"
+#include "Exceptions.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include <sys/uio.h>
+
+namespace SocketSparrow {
+
+namespace {
+
+constexpr size_t MaxVarintSize = 10;    // 64 bit value in 7 bit groups
+
+uint64_t readFixed(const std::byte* data, size_t size, ByteOrder order) {
+    uint64_t value = 0;
+    for ( size_t i = 0; i < size; i++ ) {
+        size_t index = order == ByteOrder::BigEndian ? i : size - 1 - i;
+        value = (value << 8) | std::to_integer<uint8_t>(data[index]);
+    }
+    return value;
+}
+
+void writeFixed(std::byte* data, size_t size, uint64_t value, ByteOrder order) {
+    for ( size_t i = 0; i < size; i++ ) {
+        size_t index = order == ByteOrder::BigEndian ? size - 1 - i : i;
+        data[index] = static_cast<std::byte>(value >> (8 * i));
+    }
+}
+
+} // namespace
+
+Framer::Framer(size_t maxFrameSize)
+    : mMaxFrameSize(maxFrameSize) {}
+
+Framer Framer::lengthPrefixed(LengthPrefix prefix, ByteOrder order, size_t maxFrameSize) {
+    if ( prefix == LengthPrefix::U16 ) {
+        maxFrameSize = std::min<size_t>(maxFrameSize, std::numeric_limits<uint16_t>::max());
+    } else if ( prefix == LengthPrefix::U32 ) {
+        maxFrameSize = std::min<size_t>(maxFrameSize, std::numeric_limits<uint32_t>::max());
+    }
+
+    Framer framer(maxFrameSize);
+    framer.mPrefix = prefix;
+    framer.mByteOrder = order;
+    return framer;
+}
+
+Framer Framer::delimited(std::string delimiter, size_t maxFrameSize) {
+    if ( delimiter.empty() ) {
+        throw SocketException("Framer delimiter must not be empty");
+    }
+
+    Framer framer(maxFrameSize);
+    framer.mDelimiter = std::move(delimiter);
+    return framer;
+}
+
+std::optional<Frame> Framer::decode(std::span<const std::byte> data) {
+    return mDelimiter.empty() ? decodePrefixed(data) : decodeDelimited(data);
+}
+
+std::optional<Frame> Framer::decodePrefixed(std::span<const std::byte> data) const {
+    size_t headerSize = 0;
+    uint64_t length = 0;
+
+    switch ( mPrefix ) {
+    case LengthPrefix::U16:
+    case LengthPrefix::U32:
+        headerSize = mPrefix == LengthPrefix::U16 ? 2 : 4;
+        if ( data.size() < headerSize ) {
+            return std::nullopt;
+        }
+        length = readFixed(data.data(), headerSize, mByteOrder);
+        break;
+    case LengthPrefix::Varint:
+        while ( true ) {
+            if ( headerSize == data.size() ) {
+                return std::nullopt;
+            }
+            if ( headerSize == MaxVarintSize ) {
+                throw SocketException("Malformed varint length prefix");
+            }
+            uint8_t byte = std::to_integer<uint8_t>(data[headerSize]);
+            if ( headerSize == MaxVarintSize - 1 && (byte & 0xfe) != 0 ) {
+                // the last byte only holds bit 63, more would silently wrap to a small length
+                throw SocketException("Malformed varint length prefix");
+            }
+            length |= static_cast<uint64_t>(byte & 0x7f) << (7 * headerSize);
+            headerSize++;
+            if ( (byte & 0x80) == 0 ) {
+                break;
+            }
+        }
+        break;
+    }
+
+    if ( length > mMaxFrameSize ) {
+        throw SocketException("Frame exceeds the maximum frame size");
+    }
+    if ( data.size() - headerSize < length ) {
+        return std::nullopt;
+    }
+    return Frame{ data.subspan(headerSize, length), headerSize + length };
+}
+
+std::optional<Frame> Framer::decodeDelimited(std::span<const std::byte> data) {
+    const char* text = reinterpret_cast<const char*>(data.data());
+    const size_t delimiterSize = mDelimiter.size();
+
+    // memchr finds candidates for the first delimiter byte with the vectorised libc search
+    size_t position = mSearched;
+    while ( position + delimiterSize <= data.size() ) {
+        const void* candidate = std::memchr(text + position, mDelimiter[0], data.size() - delimiterSize + 1 - position);
+        if ( candidate == nullptr ) {
+            break;
+        }
+        position = static_cast<const char*>(candidate) - text;
+        if ( std::memcmp(text + position, mDelimiter.data(), delimiterSize) == 0 ) {
+            mSearched = 0;
+            if ( position > mMaxFrameSize ) {
+                throw SocketException("Frame exceeds the maximum frame size");
+            }
+            return Frame{ data.first(position), position + delimiterSize };
+        }
+        position++;
+    }
+
+    // a delimiter arriving later can start in the last delimiterSize - 1 bytes
+    mSearched = data.size() >= delimiterSize ? data.size() - delimiterSize + 1 : 0;
+    if ( mSearched > mMaxFrameSize ) {
+        mSearched = 0;
+        throw SocketException("Frame exceeds the maximum frame size");
+    }
+    return std::nullopt;
+}
+
+std::optional<std::span<const std::byte>> Framer::readFrame(BufferedSocketReader& reader) {
+    while ( true ) {
+        std::span<const std::byte> data = reader.peek(reader.buffered());
+        if ( std::optional<Frame> frame = decode(data) ) {
+            reader.consume(frame->size);
+            return frame->payload;
+        }
+
+        if ( reader.buffered() == reader.capacity() ) {
+            throw SocketException("Frame does not fit into the BufferedSocketReader");
+        }
+        if ( reader.fill() == 0 ) {
+            if ( reader.buffered() == 0 ) {
+                return std::nullopt;
+            }
+            throw SocketException("Stream ended inside a frame");
+        }
+    }
+}
+
+ssize_t Framer::writeFrame(const Socket& socket, std::span<const std::byte> payload) const {
+    if ( payload.size() > mMaxFrameSize ) {
+        throw SocketException("Frame exceeds the maximum frame size");
+    }
+
+    iovec iovecs[2];
+    std::byte header[MaxVarintSize];
+    if ( !mDelimiter.empty() ) {
+        iovecs[0] = { const_cast<std::byte*>(payload.data()), payload.size() };
+        iovecs[1] = { const_cast<char*>(mDelimiter.data()), mDelimiter.size() };
+        return socket.send(std::span<const iovec>(iovecs));
+    }
+
+    size_t headerSize = 0;
+    switch ( mPrefix ) {
+    case LengthPrefix::U16:
+        headerSize = 2;
+        writeFixed(header, headerSize, payload.size(), mByteOrder);
+        break;
+    case LengthPrefix::U32:
+        headerSize = 4;
+        writeFixed(header, headerSize, payload.size(), mByteOrder);
+        break;
+    case LengthPrefix::Varint:
+        uint64_t value = payload.size();
+        do {
+            uint8_t byte = value & 0x7f;
+            value >>= 7;
+            header[headerSize++] = static_cast<std::byte>(value != 0 ? byte | 0x80 : byte);
+        } while ( value != 0 );
+        break;
+    }
+
+    iovecs[0] = { header, headerSize };
+    iovecs[1] = { const_cast<std::byte*>(payload.data()), payload.size() };
+    return socket.send(std::span<const iovec>(iovecs));
+}
+
+size_t Framer::maxFrameSize() const {
+    return mMaxFrameSize;
+}
+
+}   // namespace SocketSparrow
@@ -0,0 +1,165 @@
+#include "HotRestart.hpp"
+#include "Exceptions.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SocketSparrow {
+
+namespace {
+
+// the successor's request to drain, the only message sent towards the old process
+constexpr std::byte DrainRequest{ 'D' };
+
+/**
+ * @brief accept the next connection on the control Socket, blocking like the rest of the hand-over
+ */
+Socket acceptConnection(Socket& control) {
+    IOResult<Socket> accepted = control.try_accept();
+    if ( !accepted ) {
+        throw SocketException(accepted.error().value(), "Failed to accept a successor");
+    }
+    Socket connection = std::move(accepted).value();
+    connection.enableNonBlocking(false);  // try_accept() hands out non-blocking Sockets
+    return connection;
+}
+
+/**
+ * @brief send without SIGPIPE, a successor dying mid hand-over must not kill the serving process
+ */
+void sendMessage(const Socket& connection, std::span<const std::byte> data) {
+    IOResult<size_t> sent = connection.try_send(data);
+    if ( !sent ) {
+        throw SendError(sent.error().value(), "Failed to send");
+    }
+}
+
+} // namespace
+
+HotRestart::HotRestart(const Endpoint& control, std::vector<uid_t> allowedUids)
+    : mControl(control),
+    mAllowedUids(std::move(allowedUids)) {
+    if ( mControl.getAddressFamily() != AddressFamily::Unix ) {
+        throw SocketException("HotRestart needs a Unix control Endpoint");
+    }
+}
+
+bool HotRestart::isTrusted(const Socket& connection) const {
+    uid_t uid = connection.peerCredentials().uid;
+    return uid == geteuid() || std::find(mAllowedUids.begin(), mAllowedUids.end(), uid) != mAllowedUids.end();
+}
+
+void HotRestart::listen() {
+    struct stat status;
+    if ( !mControl.isAbstract() && lstat(mControl.getPath().c_str(), &status) == 0 && S_ISSOCK(status.st_mode) ) {
+        // a socket file left behind by a crashed or already replaced process blocks bind,
+        // anything else at the path is not ours to remove and makes bind fail instead
+        unlink(mControl.getPath().c_str());
+    }
+
+    mSocket.reset();
+    mSocket.emplace(AddressFamily::Unix, SocketType::SeqPacket);
+    mSocket->bind(mControl);
+    mSocket->listen(1);
+}
+
+Socket& HotRestart::controlSocket() {
+    if ( !mSocket ) {
+        throw SocketException("HotRestart has no control Socket");
+    }
+    return *mSocket;
+}
+
+bool HotRestart::handOver(std::span<const int> fds) {
+    if ( !mSocket || mSocket->getState() != SocketState::Listening ) {
+        throw SocketException("HotRestart is not listening");
+    }
+
+    // any local process can connect to an abstract name, so the listeners only go to trusted users
+    std::optional<Socket> successor(acceptConnection(*mSocket));
+    while ( !isTrusted(*successor) ) {
+        successor.reset();  // close the rejected connection before waiting for the next one
+        successor.emplace(acceptConnection(*mSocket));
+    }
+
+    // the count first, then one message per listener carrying its descriptor and bound address
+    uint32_t count = static_cast<uint32_t>(fds.size());
+    sendMessage(*successor, std::as_bytes(std::span(&count, 1)));
+    for ( int fd : fds ) {
+        sockaddr_storage address;
+        socklen_t size = sizeof(address);
+        if ( getsockname(fd, reinterpret_cast<sockaddr*>(&address), &size) == -1 ) {
+            throw SocketException(errno, "Failed to get the address of a listener");
+        }
+        successor->sendFds(std::span(&fd, 1), std::as_bytes(std::span(reinterpret_cast<const std::byte*>(&address), size)));
+    }
+
+    std::byte reply{};
+    return successor->recv(std::span(&reply, 1)) == 1 && reply == DrainRequest;
+}
+
+bool HotRestart::handOver(std::initializer_list<std::reference_wrapper<const Socket>> listeners) {
+    std::vector<int> fds;
+    fds.reserve(listeners.size());
+    for ( const Socket& listener : listeners ) {
+        fds.push_back(listener.getNativeHandle());
+    }
+    return handOver(fds);
+}
+
+std::vector<InheritedListener> HotRestart::inherit() {
+    Socket connection(AddressFamily::Unix, SocketType::SeqPacket);
+    connection.connect(mControl);
+    if ( !isTrusted(connection) ) {
+        throw SocketException("HotRestart control Endpoint is served by an untrusted user");
+    }
+
+    uint32_t count = 0;
+    if ( connection.recv(std::as_writable_bytes(std::span(&count, 1))) != sizeof(count) ) {
+        throw SocketException("Malformed hot restart hand-over");
+    }
+
+    std::vector<InheritedListener> listeners;
+    listeners.reserve(count);
+    for ( uint32_t i = 0; i < count; i++ ) {
+        sockaddr_storage address;
+        std::vector<int> fds;
+        ssize_t size = connection.recvFds(std::as_writable_bytes(std::span(&address, 1)), fds);
+        if ( fds.size() != 1 ) {
+            for ( int fd : fds ) {
+                close(fd);
+            }
+            throw SocketException("Malformed hot restart hand-over");
+        }
+
+        try {
+            Endpoint endpoint(address, static_cast<socklen_t>(size));
+            listeners.push_back({ Socket::adopt(fds[0]), endpoint });
+        } catch ( ... ) {
+            close(fds[0]);
+            throw;
+        }
+    }
+
+    mSocket.reset();
+    mSocket.emplace(std::move(connection));
+    return listeners;
+}
+
+void HotRestart::drain() {
+    if ( !mSocket || mSocket->getState() != SocketState::Connected ) {
+        throw SocketException("HotRestart has not inherited from a previous process");
+    }
+
+    sendMessage(*mSocket, std::span(&DrainRequest, 1));
+    mSocket.reset();
+}
+
+}   // namespace SocketSparrow
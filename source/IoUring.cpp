@@ -0,0 +1,934 @@
+#include "IoUring.hpp"
+#include "Exceptions.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifdef SOCKETSPARROW_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace SocketSparrow {
+
+namespace {
+
+// completion flags, identical to IORING_CQE_F_BUFFER, IORING_CQE_F_MORE and IORING_CQE_BUFFER_SHIFT
+constexpr uint32_t CompletionHasBuffer = 1U << 0;
+constexpr uint32_t CompletionHasMore = 1U << 1;
+constexpr uint32_t CompletionBufferShift = 16;
+
+constexpr size_t FixedFileSlots = 256;
+
+// user data of the throw-away entries submitted while probing, never an operation index
+constexpr uint64_t ProbeUserData = UINT64_MAX;
+
+#ifdef SOCKETSPARROW_IO_URING
+static_assert(CompletionHasBuffer == IORING_CQE_F_BUFFER);
+static_assert(CompletionHasMore == IORING_CQE_F_MORE);
+static_assert(CompletionBufferShift == IORING_CQE_BUFFER_SHIFT);
+
+int ioUringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ioUringEnter(int ring, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, ring, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int ioUringRegister(int ring, unsigned opcode, const void* arg, unsigned count) {
+    return static_cast<int>(syscall(__NR_io_uring_register, ring, opcode, arg, count));
+}
+
+unsigned loadAcquire(const unsigned* value) {
+    return std::atomic_ref<const unsigned>(*value).load(std::memory_order_acquire);
+}
+
+void storeRelease(unsigned* value, unsigned newValue) {
+    std::atomic_ref<unsigned>(*value).store(newValue, std::memory_order_release);
+}
+#endif
+
+int32_t resultOf(ssize_t result) {
+    return result == -1 ? -errno : static_cast<int32_t>(result);
+}
+
+} // namespace
+
+IoUring::IoUring(unsigned entries) {
+    setupRing(entries > 0 ? entries : 1);
+}
+
+IoUring::~IoUring() {
+    teardownRing();
+}
+
+bool IoUring::isAvailable() {
+#ifdef SOCKETSPARROW_IO_URING
+    static const bool available = []() {
+        io_uring_params params = {};
+        int ring = ioUringSetup(2, &params);
+        if ( ring == -1 ) {
+            return false;
+        }
+        ::close(ring);
+        return true;
+    }();
+    return available;
+#else
+    return false;
+#endif
+}
+
+bool IoUring::usesRing() const {
+    return mRing != -1;
+}
+
+void IoUring::setupRing(unsigned entries) {
+#ifdef SOCKETSPARROW_IO_URING
+    io_uring_params params = {};
+    mRing = ioUringSetup(entries, &params);
+    if ( mRing == -1 ) {
+        // no io_uring on this kernel (or not permitted), use the plain system calls
+        return;
+    }
+
+    mEntries = params.sq_entries;
+    mSqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    mCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if ( params.features & IORING_FEAT_SINGLE_MMAP ) {
+        mSqRingSize = mCqRingSize = std::max(mSqRingSize, mCqRingSize);
+    }
+
+    mSqRing = mmap(nullptr, mSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRing, IORING_OFF_SQ_RING);
+    if ( mSqRing == MAP_FAILED ) {
+        mSqRing = nullptr;
+        int error = errno;
+        teardownRing();
+        throw SocketException(error, "Failed to map submission queue");
+    }
+
+    if ( params.features & IORING_FEAT_SINGLE_MMAP ) {
+        mCqRing = mSqRing;
+    } else {
+        mCqRing = mmap(nullptr, mCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRing, IORING_OFF_CQ_RING);
+        if ( mCqRing == MAP_FAILED ) {
+            mCqRing = nullptr;
+            int error = errno;
+            teardownRing();
+            throw SocketException(error, "Failed to map completion queue");
+        }
+    }
+
+    mSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, mSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRing, IORING_OFF_SQES);
+    if ( sqes == MAP_FAILED ) {
+        int error = errno;
+        teardownRing();
+        throw SocketException(error, "Failed to map submission queue entries");
+    }
+    mSqes = static_cast<io_uring_sqe*>(sqes);
+
+    char* sq = static_cast<char*>(mSqRing);
+    mSqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    mSqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    mSqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+
+    // entries are always submitted in order, so the index array is the identity
+    unsigned* array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    for ( unsigned i = 0; i < params.sq_entries; i++ ) {
+        array[i] = i;
+    }
+
+    char* cq = static_cast<char*>(mCqRing);
+    mCqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    mCqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    mCqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    mCqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    // find out which operations the kernel can do, the rest uses the plain system calls
+    std::vector<char> probeMemory(sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op), 0);
+    io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(probeMemory.data());
+    mSupported.assign(IORING_OP_LAST, false);
+    if ( ioUringRegister(mRing, IORING_REGISTER_PROBE, probe, 256) == 0 ) {
+        for ( unsigned i = 0; i < probe->ops_len && i < mSupported.size(); i++ ) {
+            mSupported[i] = (probe->ops[i].flags & IO_URING_OP_SUPPORTED) != 0;
+        }
+    }
+
+    // multishot accept and receive are flags of older opcodes, so the probe above can't tell
+    mMultishotAccept = probeMultishot(IORING_OP_ACCEPT, IORING_ACCEPT_MULTISHOT, 0);
+    mMultishotRecv = probeMultishot(IORING_OP_RECV, IORING_RECV_MULTISHOT, IOSQE_BUFFER_SELECT);
+#else
+    (void)entries;
+#endif
+}
+
+bool IoUring::probeMultishot(uint8_t opcode, uint16_t multishotFlag, uint8_t sqeFlags) {
+#ifdef SOCKETSPARROW_IO_URING
+    if ( opcode >= mSupported.size() || !mSupported[opcode] ) {
+        return false;
+    }
+
+    // aimed at the ring itself, which is no socket: a kernel that knows the flag fails the
+    // operation with ENOTSOCK, an older one already rejects the entry with EINVAL
+    io_uring_sqe* sqe = nextSqe();
+    std::memset(sqe, 0, sizeof(io_uring_sqe));
+    sqe->opcode = opcode;
+    sqe->fd = mRing;
+    sqe->flags = sqeFlags;
+    sqe->ioprio = multishotFlag;
+    sqe->user_data = ProbeUserData;
+    const unsigned tail = *mSqTail;
+    storeRelease(mSqTail, tail + 1);
+
+    int submitted;
+    do {
+        submitted = ioUringEnter(mRing, 1, 1, IORING_ENTER_GETEVENTS);
+    } while ( submitted == -1 && errno == EINTR && loadAcquire(mSqHead) == tail );
+    if ( submitted == -1 && loadAcquire(mSqHead) == tail ) {
+        storeRelease(mSqTail, tail);   // never reached the kernel, take the entry back
+        return false;
+    }
+
+    // the entry was consumed, wait for its completion if an interrupted enter did not
+    while ( loadAcquire(mCqTail) == *mCqHead ) {
+        if ( ioUringEnter(mRing, 0, 1, IORING_ENTER_GETEVENTS) == -1 && errno != EINTR ) {
+            return false;
+        }
+    }
+
+    int32_t result = -EINVAL;
+    unsigned head = *mCqHead;
+    const unsigned cqTail = loadAcquire(mCqTail);
+    while ( head != cqTail ) {
+        const io_uring_cqe& cqe = mCqes[head & mCqMask];
+        if ( cqe.user_data == ProbeUserData ) {
+            result = cqe.res;
+        }
+        head++;
+    }
+    storeRelease(mCqHead, head);
+    return result != -EINVAL;
+#else
+    (void)opcode;
+    (void)multishotFlag;
+    (void)sqeFlags;
+    return false;
+#endif
+}
+
+void IoUring::teardownRing() {
+#ifdef SOCKETSPARROW_IO_URING
+    if ( mSqes != nullptr ) {
+        munmap(mSqes, mSqesSize);
+        mSqes = nullptr;
+    }
+    if ( mCqRing != nullptr && mCqRing != mSqRing ) {
+        munmap(mCqRing, mCqRingSize);
+    }
+    mCqRing = nullptr;
+    if ( mSqRing != nullptr ) {
+        munmap(mSqRing, mSqRingSize);
+        mSqRing = nullptr;
+    }
+    if ( mRing != -1 ) {
+        ::close(mRing);
+        mRing = -1;
+    }
+#endif
+}
+
+bool IoUring::registerBuffers(std::span<const iovec> buffers) {
+#ifdef SOCKETSPARROW_IO_URING
+    if ( mRing == -1 ) {
+        return false;
+    }
+    ioUringRegister(mRing, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+    mBuffersRegistered = ioUringRegister(mRing, IORING_REGISTER_BUFFERS, buffers.data(), static_cast<unsigned>(buffers.size())) == 0;
+    return mBuffersRegistered;
+#else
+    (void)buffers;
+    return false;
+#endif
+}
+
+bool IoUring::registerSocket(const Socket& socket) {
+#ifdef SOCKETSPARROW_IO_URING
+    int fd = socket.getNativeHandle();
+    if ( mRing == -1 || fd < 0 ) {
+        return false;
+    }
+
+    if ( mFixedFileSlots == 0 ) {
+        std::vector<int> empty(FixedFileSlots, -1);
+        if ( ioUringRegister(mRing, IORING_REGISTER_FILES, empty.data(), FixedFileSlots) != 0 ) {
+            return false;
+        }
+        mFixedFileSlots = FixedFileSlots;
+        for ( int slot = FixedFileSlots - 1; slot >= 0; slot-- ) {
+            mFreeFixedFiles.push_back(slot);
+        }
+    }
+
+    if ( static_cast<size_t>(fd) < mFixedFiles.size() && mFixedFiles[fd] != -1 ) {
+        return true;
+    }
+
+    if ( mFreeFixedFiles.empty() ) {
+        return false;
+    }
+
+    int slot = mFreeFixedFiles.back();
+    io_uring_files_update update = {};
+    update.offset = static_cast<uint32_t>(slot);
+    update.fds = reinterpret_cast<uint64_t>(&fd);
+    if ( ioUringRegister(mRing, IORING_REGISTER_FILES_UPDATE, &update, 1) != 1 ) {
+        return false;
+    }
+
+    mFreeFixedFiles.pop_back();
+    if ( static_cast<size_t>(fd) >= mFixedFiles.size() ) {
+        mFixedFiles.resize(static_cast<size_t>(fd) + 1, -1);
+    }
+    mFixedFiles[fd] = slot;
+    return true;
+#else
+    (void)socket;
+    return false;
+#endif
+}
+
+void IoUring::unregisterSocket(const Socket& socket) {
+#ifdef SOCKETSPARROW_IO_URING
+    int fd = socket.getNativeHandle();
+    if ( fd < 0 || static_cast<size_t>(fd) >= mFixedFiles.size() || mFixedFiles[fd] == -1 ) {
+        return;
+    }
+
+    int empty = -1;
+    io_uring_files_update update = {};
+    update.offset = static_cast<uint32_t>(mFixedFiles[fd]);
+    update.fds = reinterpret_cast<uint64_t>(&empty);
+    ioUringRegister(mRing, IORING_REGISTER_FILES_UPDATE, &update, 1);
+
+    mFreeFixedFiles.push_back(mFixedFiles[fd]);
+    mFixedFiles[fd] = -1;
+#else
+    (void)socket;
+#endif
+}
+
+void IoUring::provideBuffers(uint16_t group, size_t count, size_t size) {
+    if ( count == 0 || size == 0 || count > UINT16_MAX ) {
+        throw SocketException("Invalid buffer group size");
+    }
+    for ( const auto& existing : mBufferGroups ) {
+        if ( existing.id == group ) {
+            throw SocketException("Buffer group already exists");
+        }
+    }
+
+    BufferGroup& bufferGroup = mBufferGroups.emplace_back();
+    bufferGroup.id = group;
+    bufferGroup.memory.resize(count * size);
+    bufferGroup.bufferSize = size;
+    bufferGroup.count = count;
+    for ( size_t id = count; id > 0; id-- ) {
+        bufferGroup.free.push_back(static_cast<uint16_t>(id - 1));
+    }
+
+    if ( ringSupports(OperationType::ProvideBuffers) ) {
+        uint32_t index = allocateOperation(OperationType::ProvideBuffers, 0, -1);
+        Operation& operation = mOperations[index];
+        operation.internal = true;
+        operation.data = bufferGroup.memory.data();
+        operation.size = size;
+        operation.bufferGroup = group;
+        operation.bufferId = 0;
+        operation.bufferIndex = static_cast<unsigned>(count);
+        bufferGroup.free.clear();
+        enqueue(index);
+    }
+}
+
+IoUring::BufferGroup* IoUring::findBufferGroup(uint16_t group) {
+    for ( auto& bufferGroup : mBufferGroups ) {
+        if ( bufferGroup.id == group ) {
+            return &bufferGroup;
+        }
+    }
+    return nullptr;
+}
+
+uint32_t IoUring::allocateOperation(OperationType type, uint64_t userData, int fd) {
+    uint32_t index;
+    if ( mFreeOperations.empty() ) {
+        index = static_cast<uint32_t>(mOperations.size());
+        mOperations.emplace_back();
+    } else {
+        index = mFreeOperations.back();
+        mFreeOperations.pop_back();
+        mOperations[index] = Operation();
+    }
+
+    Operation& operation = mOperations[index];
+    operation.type = type;
+    operation.userData = userData;
+    operation.fd = fd;
+    operation.active = true;
+    if ( type != OperationType::ProvideBuffers && type != OperationType::Cancel ) {
+        mInFlight++;
+    }
+    return index;
+}
+
+void IoUring::releaseOperation(uint32_t index) {
+    if ( !mOperations[index].internal ) {
+        mInFlight--;
+    }
+    mOperations[index].active = false;
+    mFreeOperations.push_back(index);
+}
+
+bool IoUring::ringSupports(OperationType type) const {
+#ifdef SOCKETSPARROW_IO_URING
+    if ( mRing == -1 ) {
+        return false;
+    }
+
+    auto supported = [&](unsigned opcode) {
+        return opcode < mSupported.size() && mSupported[opcode];
+    };
+
+    switch ( type ) {
+        case OperationType::Accept:         return supported(IORING_OP_ACCEPT);
+        case OperationType::Connect:        return supported(IORING_OP_CONNECT);
+        case OperationType::Send:           return supported(IORING_OP_SEND);
+        case OperationType::Recv:           return supported(IORING_OP_RECV);
+        case OperationType::SendMsg:        return supported(IORING_OP_SENDMSG);
+        case OperationType::RecvMsg:        return supported(IORING_OP_RECVMSG);
+        case OperationType::SendFixed:      return mBuffersRegistered && supported(IORING_OP_WRITE_FIXED);
+        case OperationType::RecvFixed:      return mBuffersRegistered && supported(IORING_OP_READ_FIXED);
+        // only multishot receives pick provided buffers, without them the group stays in user space
+        case OperationType::ProvideBuffers: return mMultishotRecv && supported(IORING_OP_PROVIDE_BUFFERS);
+        case OperationType::Cancel:         return supported(IORING_OP_ASYNC_CANCEL);
+    }
+#else
+    (void)type;
+#endif
+    return false;
+}
+
+void IoUring::enqueue(uint32_t index) {
+    Operation& operation = mOperations[index];
+    bool useRing = ringSupports(operation.type);
+    if ( operation.type == OperationType::Accept && operation.multishot ) {
+        useRing = useRing && mMultishotAccept;
+    }
+    if ( operation.type == OperationType::Recv && operation.multishot ) {
+        useRing = useRing && ringSupports(OperationType::ProvideBuffers);
+    }
+
+    if ( !useRing ) {
+        mFallbackPending.push_back(index);
+        return;
+    }
+
+#ifdef SOCKETSPARROW_IO_URING
+    io_uring_sqe* sqe = nextSqe();
+    std::memset(sqe, 0, sizeof(io_uring_sqe));
+    sqe->user_data = index;
+    sqe->fd = operation.fd;
+
+    if ( operation.fd >= 0
+        && static_cast<size_t>(operation.fd) < mFixedFiles.size()
+        && mFixedFiles[operation.fd] != -1 ) {
+        sqe->fd = mFixedFiles[operation.fd];
+        sqe->flags |= IOSQE_FIXED_FILE;
+    }
+
+    switch ( operation.type ) {
+    case OperationType::Accept:
+        sqe->opcode = IORING_OP_ACCEPT;
+        sqe->accept_flags = SOCK_CLOEXEC;
+        if ( operation.multishot ) {
+            sqe->ioprio |= IORING_ACCEPT_MULTISHOT;
+        } else {
+            operation.addressSize = sizeof(operation.address);
+            sqe->addr = reinterpret_cast<uint64_t>(&operation.address);
+            sqe->addr2 = reinterpret_cast<uint64_t>(&operation.addressSize);
+        }
+        break;
+    case OperationType::Connect:
+        sqe->opcode = IORING_OP_CONNECT;
+        sqe->addr = reinterpret_cast<uint64_t>(&operation.address);
+        sqe->off = operation.addressSize;
+        break;
+    case OperationType::Send:
+        sqe->opcode = IORING_OP_SEND;
+        sqe->addr = reinterpret_cast<uint64_t>(operation.data);
+        sqe->len = static_cast<uint32_t>(operation.size);
+        sqe->msg_flags = MSG_NOSIGNAL;
+        break;
+    case OperationType::Recv:
+        sqe->opcode = IORING_OP_RECV;
+        if ( operation.multishot ) {
+            sqe->flags |= IOSQE_BUFFER_SELECT;
+            sqe->buf_group = operation.bufferGroup;
+            sqe->ioprio |= IORING_RECV_MULTISHOT;
+        } else {
+            sqe->addr = reinterpret_cast<uint64_t>(operation.data);
+            sqe->len = static_cast<uint32_t>(operation.size);
+        }
+        break;
+    case OperationType::SendMsg:
+        sqe->opcode = IORING_OP_SENDMSG;
+        sqe->addr = reinterpret_cast<uint64_t>(&operation.message);
+        sqe->len = 1;
+        sqe->msg_flags = MSG_NOSIGNAL;
+        break;
+    case OperationType::RecvMsg:
+        sqe->opcode = IORING_OP_RECVMSG;
+        sqe->addr = reinterpret_cast<uint64_t>(&operation.message);
+        sqe->len = 1;
+        break;
+    case OperationType::SendFixed:
+    case OperationType::RecvFixed:
+        sqe->opcode = operation.type == OperationType::SendFixed ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+        sqe->addr = reinterpret_cast<uint64_t>(operation.data);
+        sqe->len = static_cast<uint32_t>(operation.size);
+        sqe->buf_index = static_cast<uint16_t>(operation.bufferIndex);
+        break;
+    case OperationType::ProvideBuffers:
+        sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+        sqe->fd = static_cast<int32_t>(operation.bufferIndex);
+        sqe->addr = reinterpret_cast<uint64_t>(operation.data);
+        sqe->len = static_cast<uint32_t>(operation.size);
+        sqe->off = operation.bufferId;
+        sqe->buf_group = operation.bufferGroup;
+        break;
+    case OperationType::Cancel:
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->addr = operation.target;
+        break;
+    }
+
+    storeRelease(mSqTail, *mSqTail + 1);
+    mToSubmit++;
+#endif
+}
+
+io_uring_sqe* IoUring::nextSqe() {
+#ifdef SOCKETSPARROW_IO_URING
+    if ( *mSqTail - loadAcquire(mSqHead) >= mEntries ) {
+        submit();
+        if ( *mSqTail - loadAcquire(mSqHead) >= mEntries ) {
+            throw SocketException("Submission queue is full");
+        }
+    }
+    return &mSqes[*mSqTail & mSqMask];
+#else
+    return nullptr;
+#endif
+}
+
+bool IoUring::attemptFallback(uint32_t index) {
+    Operation& operation = mOperations[index];
+    int32_t result = 0;
+    uint32_t flags = 0;
+
+    switch ( operation.type ) {
+    case OperationType::Accept:
+        operation.addressSize = sizeof(operation.address);
+        result = resultOf(::accept4(operation.fd, reinterpret_cast<sockaddr*>(&operation.address), &operation.addressSize, SOCK_CLOEXEC));
+        break;
+    case OperationType::Connect:
+        if ( !operation.started ) {
+            operation.started = true;
+            result = resultOf(::connect(operation.fd, reinterpret_cast<sockaddr*>(&operation.address), operation.addressSize));
+            if ( result == -EINPROGRESS ) {
+                return true;
+            }
+        } else {
+            int error = 0;
+            socklen_t size = sizeof(error);
+            result = getsockopt(operation.fd, SOL_SOCKET, SO_ERROR, &error, &size) == -1 ? -errno : -error;
+        }
+        break;
+    case OperationType::Send:
+    case OperationType::SendFixed:
+        result = resultOf(::send(operation.fd, operation.data, operation.size, MSG_NOSIGNAL | MSG_DONTWAIT));
+        break;
+    case OperationType::Recv:
+        if ( operation.multishot ) {
+            BufferGroup* group = findBufferGroup(operation.bufferGroup);
+            if ( group == nullptr || group->free.empty() ) {
+                result = -ENOBUFS;
+                break;
+            }
+            uint16_t id = group->free.back();
+            std::byte* buffer = group->memory.data() + id * group->bufferSize;
+            result = resultOf(::recv(operation.fd, buffer, group->bufferSize, MSG_DONTWAIT));
+            if ( result < 0 ) {
+                break;
+            }
+            group->free.pop_back();
+            flags = CompletionHasBuffer | (static_cast<uint32_t>(id) << CompletionBufferShift);
+        } else {
+            result = resultOf(::recv(operation.fd, operation.data, operation.size, MSG_DONTWAIT));
+        }
+        break;
+    case OperationType::RecvFixed:
+        result = resultOf(::recv(operation.fd, operation.data, operation.size, MSG_DONTWAIT));
+        break;
+    case OperationType::SendMsg:
+        result = resultOf(::sendmsg(operation.fd, &operation.message, MSG_NOSIGNAL | MSG_DONTWAIT));
+        break;
+    case OperationType::RecvMsg:
+        operation.message.msg_namelen = sizeof(operation.address);
+        result = resultOf(::recvmsg(operation.fd, &operation.message, MSG_DONTWAIT));
+        break;
+    case OperationType::ProvideBuffers:
+    case OperationType::Cancel:
+        break;
+    }
+
+    if ( result == -EAGAIN || result == -EWOULDBLOCK || result == -EINTR ) {
+        return true;    // not ready after all, the ring would keep waiting as well
+    }
+
+    // like on the ring, multishot operations stay armed until they fail (or a receive sees EOF)
+    bool more = operation.multishot && (operation.type == OperationType::Accept ? result >= 0 : result > 0);
+    if ( more ) {
+        flags |= CompletionHasMore;
+    }
+    mFallbackResults.push_back({index, result, flags});
+    return more;
+}
+
+void IoUring::runFallbacks(bool block, bool withRing) {
+    // a connect that was not issued yet needs no readiness, so don't block on the others then
+    int timeout = block ? -1 : 0;
+    mFallbackPoll.clear();
+    for ( uint32_t index : mFallbackPending ) {
+        const Operation& operation = mOperations[index];
+        short events = 0;
+        switch ( operation.type ) {
+        case OperationType::Connect:
+            events = POLLOUT;
+            if ( !operation.started ) {
+                timeout = 0;
+            }
+            break;
+        case OperationType::Send:
+        case OperationType::SendFixed:
+        case OperationType::SendMsg:
+            events = POLLOUT;
+            break;
+        default:
+            events = POLLIN;
+            break;
+        }
+        mFallbackPoll.push_back({ operation.fd, events, 0 });
+    }
+    if ( withRing ) {
+        // the ring descriptor becomes readable with completions, so neither side starves the other
+        mFallbackPoll.push_back({ mRing, POLLIN, 0 });
+    }
+
+    if ( ::poll(mFallbackPoll.data(), mFallbackPoll.size(), timeout) == -1 && errno != EINTR ) {
+        throw SocketException(errno, "Failed to wait for completions");
+    }
+
+    // attempting may complete the operation, keep the rest queued in order
+    size_t kept = 0;
+    const size_t pending = mFallbackPending.size();
+    for ( size_t i = 0; i < pending; i++ ) {
+        uint32_t index = mFallbackPending[i];
+        const Operation& operation = mOperations[index];
+        bool ready = mFallbackPoll[i].revents != 0 || (operation.type == OperationType::Connect && !operation.started);
+        if ( !ready || attemptFallback(index) ) {
+            mFallbackPending[kept++] = index;
+        }
+    }
+    mFallbackPending.resize(kept);
+}
+
+void IoUring::recycleBuffer(uint16_t group, uint16_t id) {
+    BufferGroup* bufferGroup = findBufferGroup(group);
+    if ( bufferGroup == nullptr ) {
+        return;
+    }
+
+    if ( !ringSupports(OperationType::ProvideBuffers) ) {
+        bufferGroup->free.push_back(id);
+        return;
+    }
+
+    uint32_t index = allocateOperation(OperationType::ProvideBuffers, 0, -1);
+    Operation& operation = mOperations[index];
+    operation.internal = true;
+    operation.data = bufferGroup->memory.data() + id * bufferGroup->bufferSize;
+    operation.size = bufferGroup->bufferSize;
+    operation.bufferGroup = group;
+    operation.bufferId = id;
+    operation.bufferIndex = 1;
+    enqueue(index);
+}
+
+void IoUring::finish(uint32_t index, int32_t result, uint32_t flags, const CompletionHandler& handler) {
+    Operation& operation = mOperations[index];
+
+    IoCompletion completion;
+    completion.userData = operation.userData;
+    completion.result = result;
+    completion.more = (flags & CompletionHasMore) != 0;
+
+    const bool hasBuffer = (flags & CompletionHasBuffer) != 0;
+    const uint16_t bufferId = static_cast<uint16_t>(flags >> CompletionBufferShift);
+    const uint16_t bufferGroup = operation.bufferGroup;
+    if ( hasBuffer ) {
+        BufferGroup* group = findBufferGroup(bufferGroup);
+        if ( group != nullptr ) {
+            size_t length = result > 0 ? static_cast<size_t>(result) : 0;
+            completion.buffer = std::span<const std::byte>(group->memory.data() + bufferId * group->bufferSize, length);
+        }
+    }
+
+    if ( result >= 0 && operation.type == OperationType::RecvMsg ) {
+        completion.source = reinterpret_cast<const sockaddr*>(&operation.address);
+        completion.sourceSize = operation.message.msg_namelen;
+    } else if ( result >= 0 && operation.type == OperationType::Accept && !operation.multishot ) {
+        completion.source = reinterpret_cast<const sockaddr*>(&operation.address);
+        completion.sourceSize = operation.addressSize;
+    }
+
+    const bool internal = operation.internal;
+    if ( !internal ) {
+        handler(completion);
+    }
+
+    if ( hasBuffer ) {
+        recycleBuffer(bufferGroup, bufferId);
+    }
+    if ( !completion.more ) {
+        releaseOperation(index);
+    }
+}
+
+void IoUring::prepareAccept(Socket& socket, uint64_t userData, bool multishot) {
+    uint32_t index = allocateOperation(OperationType::Accept, userData, socket.getNativeHandle());
+    mOperations[index].multishot = multishot;
+    enqueue(index);
+}
+
+void IoUring::prepareConnect(Socket& socket, const Endpoint& endpoint, uint64_t userData) {
+    uint32_t index = allocateOperation(OperationType::Connect, userData, socket.getNativeHandle());
+    Operation& operation = mOperations[index];
+    operation.addressSize = endpoint.c_size();
+    std::memcpy(&operation.address, endpoint.c_addr(), operation.addressSize);
+    enqueue(index);
+}
+
+void IoUring::prepareSend(Socket& socket, std::span<const std::byte> data, uint64_t userData) {
+    uint32_t index = allocateOperation(OperationType::Send, userData, socket.getNativeHandle());
+    Operation& operation = mOperations[index];
+    operation.data = const_cast<std::byte*>(data.data());
+    operation.size = data.size();
+    enqueue(index);
+}
+
+void IoUring::prepareRecv(Socket& socket, std::span<std::byte> buffer, uint64_t userData) {
+    uint32_t index = allocateOperation(OperationType::Recv, userData, socket.getNativeHandle());
+    Operation& operation = mOperations[index];
+    operation.data = buffer.data();
+    operation.size = buffer.size();
+    enqueue(index);
+}
+
+void IoUring::prepareRecvMultishot(Socket& socket, uint16_t group, uint64_t userData) {
+    if ( findBufferGroup(group) == nullptr ) {
+        throw SocketException("Unknown buffer group: " + std::to_string(group));
+    }
+
+    uint32_t index = allocateOperation(OperationType::Recv, userData, socket.getNativeHandle());
+    Operation& operation = mOperations[index];
+    operation.multishot = true;
+    operation.bufferGroup = group;
+    enqueue(index);
+}
+
+void IoUring::prepareSendTo(Socket& socket, std::span<const std::byte> data, const Endpoint& endpoint, uint64_t userData) {
+    uint32_t index = allocateOperation(OperationType::SendMsg, userData, socket.getNativeHandle());
+    Operation& operation = mOperations[index];
+    operation.addressSize = endpoint.c_size();
+    std::memcpy(&operation.address, endpoint.c_addr(), operation.addressSize);
+    operation.vector.iov_base = const_cast<std::byte*>(data.data());
+    operation.vector.iov_len = data.size();
+    operation.message.msg_name = &operation.address;
+    operation.message.msg_namelen = operation.addressSize;
+    operation.message.msg_iov = &operation.vector;
+    operation.message.msg_iovlen = 1;
+    enqueue(index);
+}
+
+void IoUring::prepareRecvFrom(Socket& socket, std::span<std::byte> buffer, uint64_t userData) {
+    uint32_t index = allocateOperation(OperationType::RecvMsg, userData, socket.getNativeHandle());
+    Operation& operation = mOperations[index];
+    operation.vector.iov_base = buffer.data();
+    operation.vector.iov_len = buffer.size();
+    operation.message.msg_name = &operation.address;
+    operation.message.msg_namelen = sizeof(operation.address);
+    operation.message.msg_iov = &operation.vector;
+    operation.message.msg_iovlen = 1;
+    enqueue(index);
+}
+
+void IoUring::prepareSendFixed(Socket& socket, unsigned bufferIndex, std::span<const std::byte> data, uint64_t userData) {
+    uint32_t index = allocateOperation(OperationType::SendFixed, userData, socket.getNativeHandle());
+    Operation& operation = mOperations[index];
+    operation.data = const_cast<std::byte*>(data.data());
+    operation.size = data.size();
+    operation.bufferIndex = bufferIndex;
+    enqueue(index);
+}
+
+void IoUring::prepareRecvFixed(Socket& socket, unsigned bufferIndex, std::span<std::byte> buffer, uint64_t userData) {
+    uint32_t index = allocateOperation(OperationType::RecvFixed, userData, socket.getNativeHandle());
+    Operation& operation = mOperations[index];
+    operation.data = buffer.data();
+    operation.size = buffer.size();
+    operation.bufferIndex = bufferIndex;
+    enqueue(index);
+}
+
+void IoUring::prepareCancel(uint64_t userData) {
+    for ( uint32_t index = 0; index < mOperations.size(); index++ ) {
+        const Operation& operation = mOperations[index];
+        if ( !operation.active || operation.internal || operation.userData != userData ) {
+            continue;
+        }
+
+        // a queued operation never reached the kernel, so it is simply dropped
+        auto pending = std::find(mFallbackPending.begin(), mFallbackPending.end(), index);
+        if ( pending != mFallbackPending.end() ) {
+            mFallbackPending.erase(pending);
+            mFallbackResults.push_back({index, -ECANCELED, 0});
+            continue;
+        }
+
+        if ( ringSupports(OperationType::Cancel) ) {
+            uint32_t cancel = allocateOperation(OperationType::Cancel, 0, -1);
+            mOperations[cancel].internal = true;
+            mOperations[cancel].target = index;
+            enqueue(cancel);
+        }
+    }
+}
+
+unsigned IoUring::submit() {
+#ifdef SOCKETSPARROW_IO_URING
+    if ( mRing == -1 || mToSubmit == 0 ) {
+        return 0;
+    }
+
+    int submitted = ioUringEnter(mRing, mToSubmit, 0, 0);
+    if ( submitted == -1 ) {
+        throw SocketException(errno, "Failed to submit operations");
+    }
+    mToSubmit -= static_cast<unsigned>(submitted);
+    return static_cast<unsigned>(submitted);
+#else
+    return 0;
+#endif
+}
+
+size_t IoUring::complete(const CompletionHandler& handler, unsigned waitFor) {
+    size_t dispatched = 0;
+
+    for ( ;; ) {
+        const size_t ringInFlight = mInFlight - mFallbackPending.size();
+
+        // operations without ring support run with the plain system calls once their Socket is ready
+        if ( !mFallbackPending.empty() ) {
+#ifdef SOCKETSPARROW_IO_URING
+            const bool withRing = mRing != -1 && ringInFlight > 0;
+            if ( withRing ) {
+                submit();
+            }
+#else
+            const bool withRing = false;
+#endif
+            runFallbacks(dispatched < waitFor, withRing);
+        }
+
+        size_t fallbackIndex = 0;
+        while ( fallbackIndex < mFallbackResults.size() ) {
+            FallbackResult fallback = mFallbackResults[fallbackIndex++];
+            if ( !mOperations[fallback.operation].internal ) {
+                dispatched++;
+            }
+            finish(fallback.operation, fallback.result, fallback.flags, handler);
+        }
+        mFallbackResults.clear();
+
+#ifdef SOCKETSPARROW_IO_URING
+        if ( mRing != -1 ) {
+            // with queued fallbacks the ring was already polled above, so only reap it here
+            unsigned wait = 0;
+            if ( mFallbackPending.empty() && dispatched < waitFor ) {
+                wait = static_cast<unsigned>(std::min<size_t>(waitFor - dispatched, mInFlight));
+            }
+
+            if ( mToSubmit > 0 || wait > 0 ) {
+                int submitted = ioUringEnter(mRing, mToSubmit, wait, wait > 0 ? IORING_ENTER_GETEVENTS : 0);
+                if ( submitted == -1 && errno != EINTR && errno != EAGAIN && errno != EBUSY ) {
+                    throw SocketException(errno, "Failed to wait for completions");
+                }
+                if ( submitted > 0 ) {
+                    mToSubmit -= static_cast<unsigned>(submitted);
+                }
+            }
+
+            unsigned head = *mCqHead;
+            unsigned tail = loadAcquire(mCqTail);
+            while ( head != tail ) {
+                const io_uring_cqe& cqe = mCqes[head & mCqMask];
+                uint32_t index = static_cast<uint32_t>(cqe.user_data);
+                int32_t result = cqe.res;
+                uint32_t flags = cqe.flags;
+                storeRelease(mCqHead, ++head);
+
+                if ( !mOperations[index].internal ) {
+                    dispatched++;
+                }
+                finish(index, result, flags, handler);
+
+                if ( head == tail ) {
+                    tail = loadAcquire(mCqTail);
+                }
+            }
+        }
+#else
+        (void)ringInFlight;
+#endif
+
+        if ( dispatched >= waitFor || mInFlight == 0 ) {
+            return dispatched;
+        }
+    }
+}
+
+size_t IoUring::inFlight() const {
+    return mInFlight;
+}
+
+}   // namespace SocketSparrow
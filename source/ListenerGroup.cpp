@@ -0,0 +1,157 @@
+#include "ListenerGroup.hpp"
+#include "Exceptions.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <iterator>
+
+#include <fcntl.h>
+#include <linux/filter.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace SocketSparrow {
+
+ListenerGroup::ListenerGroup(const Endpoint& endpoint, AcceptCallback callback, Options options)
+    : mEndpoint(endpoint),
+    mCallback(std::move(callback)),
+    mOptions(options) {
+    if ( mOptions.workers == 0 ) {
+        mOptions.workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    mWorkers.resize(mOptions.workers);
+    for ( size_t i = 0; i < mWorkers.size(); i++ ) {
+        Worker& worker = mWorkers[i];
+        worker.listener = std::make_unique<Socket>(mEndpoint.getAddressFamily(), SocketType::TCP);
+        worker.listener->enableAddressReuse(true);
+        worker.listener->enablePortReuse(true);
+        worker.listener->bind(mEndpoint);
+        worker.listener->listen(mOptions.backlog);
+        worker.listener->enableNonBlocking(true);
+
+        if ( i == 0 && mEndpoint.getPort() == 0 ) {
+            // every further listener has to join the port the kernel picked for the first one
+            sockaddr_storage address;
+            socklen_t size = sizeof(address);
+            if ( getsockname(worker.listener->getNativeHandle(), reinterpret_cast<sockaddr*>(&address), &size) == -1 ) {
+                throw SocketException(errno, "Failed to get the listening port");
+            }
+            mEndpoint = Endpoint(address, size);
+        }
+
+        worker.reactor = std::make_unique<Reactor>();
+        worker.accepted.resize(AcceptBatch);
+        worker.reactor->add(*worker.listener, IOEvent::Read, [this, i](Socket& listener, IOEvent) {
+            Worker& self = mWorkers[i];
+            size_t count = 0;
+            try {
+                count = listener.acceptMany(self.accepted);
+            } catch ( const SocketException& error ) {
+                // only a lack of descriptors is helped by shedding, anything else (ENOBUFS, ENOMEM)
+                // leaves the connection queued for the next round
+                if ( error.getErrorCode() == EMFILE || error.getErrorCode() == ENFILE ) {
+                    shedConnection(self);
+                }
+                return;
+            }
+            for ( size_t j = 0; j < count; j++ ) {
+                Socket connection(std::move(self.accepted[j]));
+                mCallback(std::move(connection), *self.reactor, i);
+            }
+        });
+    }
+
+    if ( mOptions.steerByCpu ) {
+        attachSteeringProgram();
+    }
+}
+
+ListenerGroup::ListenerGroup(const Endpoint& endpoint, AcceptCallback callback)
+    : ListenerGroup(endpoint, std::move(callback), Options()) {}
+
+ListenerGroup::~ListenerGroup() {
+    stop();
+}
+
+void ListenerGroup::attachSteeringProgram() {
+    // the program returns the index of the listener in the group: the current CPU modulo the worker count
+    sock_filter code[] = {
+        { BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU) },
+        { BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<uint32_t>(mWorkers.size()) },
+        { BPF_RET | BPF_A, 0, 0, 0 },
+    };
+    sock_fprog program = { static_cast<unsigned short>(std::size(code)), code };
+
+    // the program applies to the whole reuseport group, attaching it to one listener is enough
+    if ( setsockopt(mWorkers[0].listener->getNativeHandle(), SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)) == -1 ) {
+        throw SocketException(errno, "Failed to attach the reuseport steering program");
+    }
+}
+
+void ListenerGroup::shedConnection(Worker& worker) {
+    // the level triggered Reactor reports the pending connection again and again until it is taken
+    if ( worker.reserve != -1 ) {
+        ::close(worker.reserve);
+    }
+    int connection = ::accept4(worker.listener->getNativeHandle(), nullptr, nullptr, SOCK_CLOEXEC);
+    if ( connection != -1 ) {
+        ::close(connection);
+    }
+    worker.reserve = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+}
+
+void ListenerGroup::runWorker(size_t index) {
+    if ( mOptions.pinWorkers ) {
+        unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(index % cpus, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+    mWorkers[index].reactor->run();
+}
+
+void ListenerGroup::start() {
+    for ( const Worker& worker : mWorkers ) {
+        if ( worker.thread.joinable() ) {
+            throw SocketException("ListenerGroup is already running");
+        }
+    }
+    for ( size_t i = 0; i < mWorkers.size(); i++ ) {
+        mWorkers[i].reserve = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+        mWorkers[i].thread = std::thread(&ListenerGroup::runWorker, this, i);
+    }
+}
+
+void ListenerGroup::stop() {
+    for ( Worker& worker : mWorkers ) {
+        if ( worker.thread.joinable() ) {
+            worker.reactor->stop();
+            worker.thread.join();
+        }
+        if ( worker.reserve != -1 ) {
+            ::close(worker.reserve);
+            worker.reserve = -1;
+        }
+    }
+}
+
+size_t ListenerGroup::size() const {
+    return mWorkers.size();
+}
+
+const Endpoint& ListenerGroup::endpoint() const {
+    return mEndpoint;
+}
+
+Reactor& ListenerGroup::reactor(size_t worker) {
+    if ( worker >= mWorkers.size() ) {
+        throw SocketException("ListenerGroup worker index out of range");
+    }
+    return *mWorkers[worker].reactor;
+}
+
+}   // namespace SocketSparrow
@@ -0,0 +1,110 @@
+#include "MulticastPublisher.hpp"
+#include "Exceptions.hpp"
+
+#include <cerrno>
+#include <utility>
+
+namespace SocketSparrow {
+
+namespace {
+
+AddressFamily groupFamily(const std::vector<Endpoint>& groups) {
+    if ( groups.empty() ) {
+        throw SocketException("MulticastPublisher needs at least one group");
+    }
+    return groups.front().getAddressFamily();
+}
+
+} // namespace
+
+MulticastPublisher::MulticastPublisher(std::vector<Endpoint> groups, Options options)
+    : mSocket(groupFamily(groups), SocketType::UDP),
+    mGroups(std::move(groups)),
+    mBatch(options.batchSize, options.packetSize) {
+    for ( const Endpoint& group : mGroups ) {
+        if ( group.getAddressFamily() != mGroups.front().getAddressFamily() ) {
+            throw SocketException("MulticastPublisher groups have to share one Address Family");
+        }
+    }
+    if ( mGroups.size() > mBatch.capacity() ) {
+        throw SocketException("MulticastPublisher has more groups than fit a batch");
+    }
+
+    mSocket.setMulticastTTL(options.ttl);
+    mSocket.enableMulticastLoop(options.loop);
+    if ( options.interfaceIndex != 0 ) {
+        mSocket.setMulticastInterface(options.interfaceIndex);
+    }
+}
+
+MulticastPublisher::MulticastPublisher(const Endpoint& group)
+    : MulticastPublisher(std::vector<Endpoint>{ group }, Options()) {}
+
+MulticastPublisher::~MulticastPublisher() {
+    try {
+        flush();
+    } catch ( const SocketSparrowException& ) {
+        // a destructor cannot report it, and the datagrams are stale by now anyway
+    }
+}
+
+void MulticastPublisher::publish(std::span<const std::byte> payload) {
+    std::span<const char> data(reinterpret_cast<const char*>(payload.data()), payload.size());
+    if ( data.size() > mBatch.packetSize() ) {
+        throw SocketException("Payload is larger than the packet size");
+    }
+    if ( mBatch.capacity() - mBatch.size() < mGroups.size() ) {
+        flush();
+        if ( mBatch.capacity() - mBatch.size() < mGroups.size() ) {
+            // flush() only returns early if the Socket would block
+            throw SendError(EWOULDBLOCK, "Failed to send, the batch is still full");
+        }
+    }
+    for ( const Endpoint& group : mGroups ) {
+        mBatch.push(data, group);
+    }
+    if ( mBatch.full() ) {
+        flush();
+    }
+}
+
+void MulticastPublisher::publish(std::string_view data) {
+    publish(std::as_bytes(std::span(data.data(), data.size())));
+}
+
+size_t MulticastPublisher::flush() {
+    size_t total = 0;
+    while ( !mBatch.empty() ) {
+        IOResult<size_t> sent = mSocket.try_sendBatch(mBatch);
+        if ( !sent ) {
+            const int error = sent.error().value();
+            if ( sent.wouldBlock() ) {
+                break;
+            }
+            // a full queue clears up, anything else fails the same datagram every time and would
+            // hold back everything queued behind it, so only that one is dropped
+            if ( error != ENOBUFS ) {
+                mBatch.drop(1);
+            }
+            throw SendError(error, "Failed to send");
+        }
+        // only what went out is dropped, so a retry does not duplicate datagrams
+        mBatch.drop(sent.value());
+        total += sent.value();
+    }
+    return total;
+}
+
+size_t MulticastPublisher::pending() const {
+    return mBatch.size();
+}
+
+const std::vector<Endpoint>& MulticastPublisher::groups() const {
+    return mGroups;
+}
+
+Socket& MulticastPublisher::socket() {
+    return mSocket;
+}
+
+}   // namespace SocketSparrow
@@ -0,0 +1,173 @@
+#include "PacketBatch.hpp"
+#include "Exceptions.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace SocketSparrow {
+
+PacketBatch::PacketBatch(size_t capacity, size_t packetSize)
+    : mCapacity(capacity),
+    mPacketSize(packetSize) {
+
+    if ( capacity == 0 || packetSize == 0 ) {
+        throw SocketException("PacketBatch needs at least one slot of at least one byte");
+    }
+
+    mStorage.resize(capacity * packetSize);
+    mIovecs.resize(capacity);
+    mAddresses.resize(capacity);
+    mMessages.resize(capacity);
+
+    for ( size_t i = 0; i < capacity; i++ ) {
+        mIovecs[i].iov_base = mStorage.data() + i * packetSize;
+        mIovecs[i].iov_len = 0;
+
+        msghdr& header = mMessages[i].msg_hdr;
+        std::memset(&header, 0, sizeof(header));
+        header.msg_iov = &mIovecs[i];
+        header.msg_iovlen = 1;
+    }
+}
+
+void PacketBatch::prepareRecv() {
+    mSize = 0;
+    for ( size_t i = 0; i < mCapacity; i++ ) {
+        mIovecs[i].iov_len = mPacketSize;
+
+        msghdr& header = mMessages[i].msg_hdr;
+        header.msg_name = &mAddresses[i];
+        header.msg_namelen = sizeof(sockaddr_storage);
+        header.msg_flags = 0;
+        mMessages[i].msg_len = 0;
+    }
+}
+
+void PacketBatch::finishRecv(size_t count) {
+    mSize = count;
+    for ( size_t i = 0; i < count; i++ ) {
+        // a truncated datagram reports its full length
+        mIovecs[i].iov_len = std::min<size_t>(mMessages[i].msg_len, mPacketSize);
+    }
+}
+
+size_t PacketBatch::capacity() const {
+    return mCapacity;
+}
+
+size_t PacketBatch::packetSize() const {
+    return mPacketSize;
+}
+
+size_t PacketBatch::size() const {
+    return mSize;
+}
+
+bool PacketBatch::empty() const {
+    return mSize == 0;
+}
+
+bool PacketBatch::full() const {
+    return mSize == mCapacity;
+}
+
+void PacketBatch::clear() {
+    mSize = 0;
+}
+
+void PacketBatch::drop(size_t count) {
+    if ( count > mSize ) {
+        throw SocketException("PacketBatch index out of range");
+    }
+
+    // slots own fixed storage, so the payloads and addresses are moved instead of the iovecs
+    for ( size_t from = count; from < mSize; from++ ) {
+        size_t to = from - count;
+        std::memcpy(mIovecs[to].iov_base, mIovecs[from].iov_base, mIovecs[from].iov_len);
+        mIovecs[to].iov_len = mIovecs[from].iov_len;
+        mAddresses[to] = mAddresses[from];
+
+        const msghdr& source = mMessages[from].msg_hdr;
+        msghdr& header = mMessages[to].msg_hdr;
+        header.msg_name = source.msg_name != nullptr ? &mAddresses[to] : nullptr;
+        header.msg_namelen = source.msg_namelen;
+        header.msg_flags = source.msg_flags;
+    }
+    mSize -= count;
+}
+
+void PacketBatch::push(std::span<const char> data, const Endpoint& endpoint) {
+    push(data);
+
+    msghdr& header = mMessages[mSize - 1].msg_hdr;
+    std::memcpy(&mAddresses[mSize - 1], endpoint.c_addr(), endpoint.c_size());
+    header.msg_name = &mAddresses[mSize - 1];
+    header.msg_namelen = endpoint.c_size();
+}
+
+void PacketBatch::push(std::span<const char> data) {
+    if ( full() ) {
+        throw SocketException("PacketBatch is full");
+    }
+
+    if ( data.size() > mPacketSize ) {
+        throw SocketException("Packet does not fit into a PacketBatch slot");
+    }
+
+    std::memcpy(mIovecs[mSize].iov_base, data.data(), data.size());
+    mIovecs[mSize].iov_len = data.size();
+
+    msghdr& header = mMessages[mSize].msg_hdr;
+    header.msg_name = nullptr;
+    header.msg_namelen = 0;
+    header.msg_flags = 0;
+    mSize++;
+}
+
+std::span<const char> PacketBatch::data(size_t index) const {
+    if ( index >= mSize ) {
+        throw SocketException("PacketBatch index out of range");
+    }
+    return { static_cast<const char*>(mIovecs[index].iov_base), mIovecs[index].iov_len };
+}
+
+bool PacketBatch::truncated(size_t index) const {
+    if ( index >= mSize ) {
+        throw SocketException("PacketBatch index out of range");
+    }
+    return (mMessages[index].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+}
+
+const sockaddr* PacketBatch::source(size_t index) const {
+    if ( index >= mSize ) {
+        throw SocketException("PacketBatch index out of range");
+    }
+    if ( mMessages[index].msg_hdr.msg_namelen == 0 ) {
+        return nullptr;
+    }
+    return reinterpret_cast<const sockaddr*>(&mAddresses[index]);
+}
+
+socklen_t PacketBatch::sourceSize(size_t index) const {
+    if ( index >= mSize ) {
+        throw SocketException("PacketBatch index out of range");
+    }
+    return mMessages[index].msg_hdr.msg_namelen;
+}
+
+Endpoint PacketBatch::endpoint(size_t index) const {
+    if ( source(index) == nullptr ) {
+        return Endpoint();
+    }
+    return Endpoint(mAddresses[index], sourceSize(index));
+}
+
+UDPPacket PacketBatch::packet(size_t index) const {
+    std::span<const char> payload = data(index);
+    if ( source(index) == nullptr ) {
+        return UDPPacket(std::vector<char>(payload.begin(), payload.end()));
+    }
+    return UDPPacket(std::vector<char>(payload.begin(), payload.end()), Endpoint(mAddresses[index], sourceSize(index)));
+}
+
+}   // namespace SocketSparrow
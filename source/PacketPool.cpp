@@ -0,0 +1,312 @@
+#include "PacketPool.hpp"
+#include "Exceptions.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
+#include <utility>
+
+namespace SocketSparrow {
+
+namespace {
+
+std::atomic<uint64_t> nextPoolId = 1;
+
+// pools that are still alive, so exiting threads can return their cached buffers
+std::mutex registryMutex;
+std::unordered_map<uint64_t, PacketPool*> registry;
+
+} // namespace
+
+/**
+ * @brief Buffers one thread holds back for one pool
+ */
+struct PacketPool::Cache {
+    uint64_t poolId;
+    std::mutex mutex;   // only contended when another thread steals from the cache
+    std::vector<PooledPacket::Slot*> slots;
+};
+
+/**
+ * @brief The caches of the calling thread, one per pool it used
+ */
+struct PacketPool::ThreadCaches {
+    std::vector<std::unique_ptr<Cache>> caches;
+
+    void forget(uint64_t poolId) {
+        std::erase_if(caches, [poolId](const std::unique_ptr<Cache>& cache) { return cache->poolId == poolId; });
+    }
+
+    // a pool only forgets the cache of the thread destroying it, the others are dropped here
+    void forgetDead() {
+        std::lock_guard lock(registryMutex);
+        std::erase_if(caches, [](const std::unique_ptr<Cache>& cache) { return !registry.contains(cache->poolId); });
+    }
+
+    ~ThreadCaches() {
+        std::lock_guard lock(registryMutex);
+        for ( std::unique_ptr<Cache>& cache : caches ) {
+            auto pool = registry.find(cache->poolId);
+            if ( pool != registry.end() ) {
+                pool->second->unregister(cache.get());
+            }
+        }
+    }
+};
+
+PacketPool::ThreadCaches& PacketPool::localCaches() {
+    thread_local ThreadCaches caches;
+    return caches;
+}
+
+
+PooledPacket::PooledPacket(PacketPool* pool, Slot* slot)
+    : mPool(pool),
+    mSlot(slot) {}
+
+PooledPacket::PooledPacket(PooledPacket&& other) noexcept
+    : mPool(std::exchange(other.mPool, nullptr)),
+    mSlot(std::exchange(other.mSlot, nullptr)) {}
+
+PooledPacket& PooledPacket::operator=(PooledPacket&& other) noexcept {
+    if ( this != &other ) {
+        reset();
+        mPool = std::exchange(other.mPool, nullptr);
+        mSlot = std::exchange(other.mSlot, nullptr);
+    }
+    return *this;
+}
+
+PooledPacket::~PooledPacket() {
+    reset();
+}
+
+void PooledPacket::reset() {
+    if ( mSlot != nullptr ) {
+        mPool->release(mSlot);
+        mPool = nullptr;
+        mSlot = nullptr;
+    }
+}
+
+PooledPacket::operator bool() const {
+    return mSlot != nullptr;
+}
+
+std::span<const char> PooledPacket::data() const {
+    if ( mSlot == nullptr ) {
+        return {};
+    }
+    return { mSlot->data, mSlot->size };
+}
+
+std::span<char> PooledPacket::buffer() {
+    if ( mSlot == nullptr ) {
+        return {};
+    }
+    return { mSlot->data, mPool->mPacketSize };
+}
+
+size_t PooledPacket::size() const {
+    return mSlot != nullptr ? mSlot->size : 0;
+}
+
+size_t PooledPacket::capacity() const {
+    return mSlot != nullptr ? mPool->mPacketSize : 0;
+}
+
+void PooledPacket::resize(size_t size) {
+    if ( mSlot == nullptr ) {
+        throw SocketException("Cannot resize an empty PooledPacket");
+    }
+    if ( size > capacity() ) {
+        throw SocketException("PooledPacket size exceeds its capacity");
+    }
+    mSlot->size = size;
+}
+
+const sockaddr* PooledPacket::source() const {
+    if ( mSlot == nullptr || mSlot->addressSize == 0 ) {
+        return nullptr;
+    }
+    return reinterpret_cast<const sockaddr*>(&mSlot->address);
+}
+
+socklen_t PooledPacket::sourceSize() const {
+    return mSlot != nullptr ? mSlot->addressSize : 0;
+}
+
+Endpoint PooledPacket::endpoint() const {
+    if ( source() == nullptr ) {
+        return Endpoint();
+    }
+    return Endpoint(mSlot->address, mSlot->addressSize);
+}
+
+
+PacketPool::PacketPool(size_t count, size_t packetSize, size_t cacheSize)
+    : mId(nextPoolId++),
+    mPacketSize(packetSize),
+    mCacheSize(cacheSize) {
+
+    if ( count == 0 || packetSize == 0 ) {
+        throw SocketException("PacketPool needs at least one buffer of at least one byte");
+    }
+
+    mStorage.resize(count * packetSize);
+    mSlots.resize(count);
+    mFree.reserve(count);
+    for ( size_t i = count; i > 0; i-- ) {
+        mSlots[i - 1].data = mStorage.data() + (i - 1) * packetSize;
+        mFree.push_back(&mSlots[i - 1]);
+    }
+
+    std::lock_guard lock(registryMutex);
+    registry.emplace(mId, this);
+}
+
+PacketPool::~PacketPool() {
+    std::lock_guard lock(registryMutex);
+    registry.erase(mId);
+    localCaches().forget(mId);
+}
+
+PooledPacket PacketPool::acquire() {
+    PooledPacket packet = tryAcquire();
+    if ( !packet ) {
+        throw SocketException("PacketPool is exhausted");
+    }
+    return packet;
+}
+
+PacketPool::Cache& PacketPool::localCache() {
+    ThreadCaches& local = localCaches();
+    for ( std::unique_ptr<Cache>& cache : local.caches ) {
+        if ( cache->poolId == mId ) {
+            return *cache;
+        }
+    }
+
+    local.forgetDead();
+    Cache& cache = *local.caches.emplace_back(std::make_unique<Cache>());
+    cache.poolId = mId;
+    std::lock_guard lock(mMutex);
+    mCaches.push_back(&cache);
+    return cache;
+}
+
+PooledPacket PacketPool::tryAcquire() {
+    PooledPacket::Slot* slot = nullptr;
+
+    if ( mCacheSize == 0 ) {
+        std::lock_guard lock(mMutex);
+        if ( !mFree.empty() ) {
+            slot = mFree.back();
+            mFree.pop_back();
+        }
+    } else {
+        Cache& cache = localCache();
+        {
+            std::lock_guard lock(cache.mutex);
+            if ( !cache.slots.empty() ) {
+                slot = cache.slots.back();
+                cache.slots.pop_back();
+            }
+        }
+        if ( slot == nullptr ) {
+            // refill half the cache at once so the shared lock is taken rarely
+            std::lock_guard lock(mMutex);
+            std::lock_guard cacheLock(cache.mutex);
+            size_t count = std::min(mFree.size(), std::max<size_t>(mCacheSize / 2, 1));
+            cache.slots.insert(cache.slots.end(), mFree.end() - count, mFree.end());
+            mFree.resize(mFree.size() - count);
+            if ( cache.slots.empty() ) {
+                steal(cache.slots, cache);
+            }
+            if ( !cache.slots.empty() ) {
+                slot = cache.slots.back();
+                cache.slots.pop_back();
+            }
+        }
+    }
+
+    if ( slot == nullptr ) {
+        return {};
+    }
+
+    slot->size = 0;
+    slot->addressSize = 0;
+    return PooledPacket(this, slot);
+}
+
+void PacketPool::release(PooledPacket::Slot* slot) {
+    if ( mCacheSize == 0 ) {
+        std::lock_guard lock(mMutex);
+        mFree.push_back(slot);
+        return;
+    }
+
+    Cache& cache = localCache();
+    bool overflow;
+    {
+        std::lock_guard lock(cache.mutex);
+        cache.slots.push_back(slot);
+        overflow = cache.slots.size() > mCacheSize;
+    }
+    if ( overflow ) {
+        std::lock_guard lock(mMutex);
+        std::lock_guard cacheLock(cache.mutex);
+        if ( cache.slots.size() > mCacheSize / 2 ) {
+            releaseShared(cache.slots, cache.slots.size() - mCacheSize / 2);
+        }
+    }
+}
+
+void PacketPool::releaseShared(std::vector<PooledPacket::Slot*>& slots, size_t count) {
+    // mMutex is held by the caller
+    mFree.insert(mFree.end(), slots.end() - count, slots.end());
+    slots.resize(slots.size() - count);
+}
+
+void PacketPool::steal(std::vector<PooledPacket::Slot*>& slots, const Cache& thief) {
+    // mMutex is held by the caller, take half of the first cache that has buffers
+    for ( Cache* cache : mCaches ) {
+        if ( cache == &thief ) {
+            continue;
+        }
+        std::lock_guard lock(cache->mutex);
+        size_t count = (cache->slots.size() + 1) / 2;
+        slots.insert(slots.end(), cache->slots.end() - count, cache->slots.end());
+        cache->slots.resize(cache->slots.size() - count);
+        if ( !slots.empty() ) {
+            return;
+        }
+    }
+}
+
+void PacketPool::unregister(Cache* cache) {
+    std::lock_guard lock(mMutex);
+    std::lock_guard cacheLock(cache->mutex);
+    releaseShared(cache->slots, cache->slots.size());
+    std::erase(mCaches, cache);
+}
+
+size_t PacketPool::capacity() const {
+    return mSlots.size();
+}
+
+size_t PacketPool::packetSize() const {
+    return mPacketSize;
+}
+
+size_t PacketPool::available() const {
+    std::lock_guard lock(mMutex);
+    size_t available = mFree.size();
+    for ( Cache* cache : mCaches ) {
+        std::lock_guard cacheLock(cache->mutex);
+        available += cache->slots.size();
+    }
+    return available;
+}
+
+}   // namespace SocketSparrow
@@ -0,0 +1,245 @@
+#include "Reactor.hpp"
+#include "Exceptions.hpp"
+
+#include <cerrno>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace SocketSparrow {
+
+namespace {
+
+uint32_t toNativeEvents(IOEvent interest, TriggerMode mode) {
+    uint32_t events = EPOLLRDHUP;
+    if ( hasEvent(interest, IOEvent::Read) ) events |= EPOLLIN;
+    if ( hasEvent(interest, IOEvent::Write) ) events |= EPOLLOUT;
+    if ( mode == TriggerMode::Edge ) events |= EPOLLET;
+    return events;
+}
+
+IOEvent fromNativeEvents(uint32_t events) {
+    IOEvent result = IOEvent::None;
+    if ( events & (EPOLLIN | EPOLLPRI) ) result |= IOEvent::Read;
+    if ( events & EPOLLOUT ) result |= IOEvent::Write;
+    if ( events & (EPOLLHUP | EPOLLRDHUP) ) result |= IOEvent::HangUp;
+    if ( events & EPOLLERR ) result |= IOEvent::Error;
+    return result;
+}
+
+} // namespace
+
+Reactor::Reactor(size_t maxEvents)
+    : mEvents(maxEvents > 0 ? maxEvents : 1) {
+    mEpoll = epoll_create1(EPOLL_CLOEXEC);
+    if ( mEpoll == -1 ) {
+        throw SocketException(errno, "Failed to create epoll instance");
+    }
+
+    mWakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if ( mWakeup == -1 ) {
+        int error = errno;
+        ::close(mEpoll);
+        throw SocketException(error, "Failed to create wakeup event");
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = mWakeup;
+    if ( epoll_ctl(mEpoll, EPOLL_CTL_ADD, mWakeup, &event) == -1 ) {
+        int error = errno;
+        ::close(mWakeup);
+        ::close(mEpoll);
+        throw SocketException(error, "Failed to register wakeup event");
+    }
+}
+
+Reactor::~Reactor() {
+    ::close(mWakeup);
+    ::close(mEpoll);
+}
+
+void Reactor::registerSocket(Socket& socket, IOEvent interest, TriggerMode mode, Callback callback, Handler* handler) {
+    int fd = socket.getNativeHandle();
+    if ( fd < 0 ) {
+        throw SocketException("Cannot register an invalid Socket");
+    }
+
+    if ( contains(socket) ) {
+        throw SocketException("Socket is already registered");
+    }
+
+    epoll_event event = {};
+    event.events = toNativeEvents(interest, mode);
+    event.data.fd = fd;
+    if ( epoll_ctl(mEpoll, EPOLL_CTL_ADD, fd, &event) == -1 ) {
+        throw SocketException(errno, "Failed to register Socket");
+    }
+
+    if ( static_cast<size_t>(fd) >= mRegistrations.size() ) {
+        mRegistrations.resize(static_cast<size_t>(fd) + 1);
+    }
+
+    Registration& registration = mRegistrations[fd];
+    registration.socket = &socket;
+    registration.interest = interest;
+    registration.mode = mode;
+    registration.callback = std::move(callback);
+    registration.handler = handler;
+    registration.generation = ++mGeneration;
+    mRegistered++;
+}
+
+void Reactor::add(Socket& socket, IOEvent interest, Callback callback, TriggerMode mode) {
+    if ( !callback ) {
+        throw SocketException("Cannot register a Socket without a Callback");
+    }
+    registerSocket(socket, interest, mode, std::move(callback), nullptr);
+}
+
+void Reactor::add(Socket& socket, IOEvent interest, Handler& handler, TriggerMode mode) {
+    registerSocket(socket, interest, mode, nullptr, &handler);
+}
+
+void Reactor::modify(Socket& socket, IOEvent interest) {
+    if ( !contains(socket) ) {
+        throw SocketException("Socket is not registered");
+    }
+
+    int fd = socket.getNativeHandle();
+    Registration& registration = mRegistrations[fd];
+
+    epoll_event event = {};
+    event.events = toNativeEvents(interest, registration.mode);
+    event.data.fd = fd;
+    if ( epoll_ctl(mEpoll, EPOLL_CTL_MOD, fd, &event) == -1 ) {
+        throw SocketException(errno, "Failed to modify Socket registration");
+    }
+    registration.interest = interest;
+}
+
+void Reactor::remove(Socket& socket) {
+    if ( !contains(socket) ) {
+        throw SocketException("Socket is not registered");
+    }
+
+    int fd = socket.getNativeHandle();
+    // the descriptor may already be gone, the registration is dropped regardless
+    epoll_ctl(mEpoll, EPOLL_CTL_DEL, fd, nullptr);
+
+    Registration& registration = mRegistrations[fd];
+    registration.socket = nullptr;
+    registration.interest = IOEvent::None;
+    registration.callback = nullptr;
+    registration.handler = nullptr;
+    registration.generation = ++mGeneration;
+    mRegistered--;
+}
+
+bool Reactor::contains(const Socket& socket) const {
+    int fd = socket.getNativeHandle();
+    return fd >= 0
+        && static_cast<size_t>(fd) < mRegistrations.size()
+        && mRegistrations[fd].socket == &socket;
+}
+
+size_t Reactor::size() const {
+    return mRegistered;
+}
+
+void Reactor::dispatch(int fd, IOEvent events) {
+    if ( static_cast<size_t>(fd) >= mRegistrations.size() ) {
+        return;
+    }
+
+    // Callbacks may add or remove Sockets, which can reallocate mRegistrations,
+    // so the registration is looked up again after every invocation.
+    const uint64_t generation = mRegistrations[fd].generation;
+    auto stillRegistered = [&]() {
+        return mRegistrations[fd].generation == generation && mRegistrations[fd].socket != nullptr;
+    };
+
+    if ( !stillRegistered() ) {
+        return;
+    }
+
+    Socket& socket = *mRegistrations[fd].socket;
+
+    if ( mRegistrations[fd].handler == nullptr ) {
+        // keep the Callback alive while it runs, it may remove its own registration
+        Callback callback = std::move(mRegistrations[fd].callback);
+        callback(socket, events);
+        if ( stillRegistered() && !mRegistrations[fd].callback ) {
+            mRegistrations[fd].callback = std::move(callback);
+        }
+        return;
+    }
+
+    Handler* handler = mRegistrations[fd].handler;
+    if ( hasEvent(events, IOEvent::Read) ) {
+        handler->onReadable(socket);
+    }
+    if ( hasEvent(events, IOEvent::Write) && stillRegistered() ) {
+        handler->onWritable(socket);
+    }
+    if ( hasEvent(events, IOEvent::HangUp) && stillRegistered() ) {
+        handler->onHangUp(socket);
+    }
+    if ( hasEvent(events, IOEvent::Error) && stillRegistered() ) {
+        handler->onError(socket);
+    }
+}
+
+size_t Reactor::poll(int timeoutMs) {
+    int count = epoll_wait(mEpoll, mEvents.data(), static_cast<int>(mEvents.size()), timeoutMs);
+    if ( count == -1 ) {
+        if ( errno == EINTR ) {
+            return 0;
+        }
+        throw SocketException(errno, "Failed to wait for events");
+    }
+
+    size_t dispatched = 0;
+    for ( int i = 0; i < count; i++ ) {
+        int fd = mEvents[i].data.fd;
+        if ( fd == mWakeup ) {
+            eventfd_t value;
+            eventfd_read(mWakeup, &value);
+            continue;
+        }
+
+        dispatch(fd, fromNativeEvents(mEvents[i].events));
+        dispatched++;
+    }
+    return dispatched;
+}
+
+void Reactor::run() {
+    mRunning = true;
+    try {
+        while ( !mStopRequested ) {
+            poll(-1);
+        }
+    } catch ( ... ) {
+        mRunning = false;
+        mStopRequested = false;
+        throw;
+    }
+    mStopRequested = false;
+    mRunning = false;
+}
+
+void Reactor::stop() {
+    mStopRequested = true;
+    wakeup();
+}
+
+void Reactor::wakeup() {
+    eventfd_write(mWakeup, 1);
+}
+
+bool Reactor::isRunning() const {
+    return mRunning;
+}
+
+}   // namespace SocketSparrow
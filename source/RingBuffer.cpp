@@ -0,0 +1,130 @@
+#include "RingBuffer.hpp"
+#include "Exceptions.hpp"
+
+#include <cstring>
+#include <new>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace SocketSparrow {
+
+namespace {
+
+size_t roundToPages(size_t size) {
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return (size + page - 1) / page * page;
+}
+
+/**
+ * @brief map size bytes of a memfd twice in a row, nullptr if the system does not allow it
+ */
+std::byte* mapMirrored(size_t size) {
+    int fd = memfd_create("SocketSparrow-RingBuffer", MFD_CLOEXEC);
+    if ( fd == -1 ) {
+        return nullptr;
+    }
+    if ( ftruncate(fd, static_cast<off_t>(size)) == -1 ) {
+        close(fd);
+        return nullptr;
+    }
+
+    // reserve the whole range first so nothing else can end up between the two views
+    void* base = mmap(nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ( base == MAP_FAILED ) {
+        close(fd);
+        return nullptr;
+    }
+
+    std::byte* data = static_cast<std::byte*>(base);
+    bool mapped = mmap(data, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED
+        && mmap(data + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+    close(fd);
+    if ( !mapped ) {
+        munmap(base, 2 * size);
+        return nullptr;
+    }
+    return data;
+}
+
+} // namespace
+
+RingBuffer::RingBuffer(size_t capacity)
+    : mCapacity(roundToPages(capacity)) {
+    if ( capacity == 0 ) {
+        throw SocketException("RingBuffer needs a capacity of at least one byte");
+    }
+
+    mData = mapMirrored(mCapacity);
+    mMirrored = mData != nullptr;
+    if ( !mMirrored ) {
+        mData = new (std::nothrow) std::byte[mCapacity];
+        if ( mData == nullptr ) {
+            throw SocketException("Failed to allocate RingBuffer memory");
+        }
+    }
+}
+
+RingBuffer::~RingBuffer() {
+    if ( mMirrored ) {
+        munmap(mData, 2 * mCapacity);
+    } else {
+        delete[] mData;
+    }
+}
+
+std::span<const std::byte> RingBuffer::readable() const {
+    return { mData + mHead, mSize };
+}
+
+std::span<std::byte> RingBuffer::writable() {
+    // without the mirror, move the data to the front once the space behind it runs out or
+    // gets small next to what space() promises, an empty span would read as a full buffer
+    if ( !mMirrored && mHead > 0
+        && (mCapacity - mHead - mSize == 0 || mCapacity - mHead - mSize < (mCapacity - mSize) / 2) ) {
+        std::memmove(mData, mData + mHead, mSize);
+        mHead = 0;
+    }
+
+    size_t length = mMirrored ? mCapacity - mSize : mCapacity - mHead - mSize;
+    return { mData + mHead + mSize, length };
+}
+
+void RingBuffer::consume(size_t count) {
+    if ( count > mSize ) {
+        throw SocketException("Cannot consume more than the RingBuffer holds");
+    }
+    mSize -= count;
+    mHead = mSize == 0 ? 0 : (mHead + count) % mCapacity;
+}
+
+void RingBuffer::commit(size_t count) {
+    size_t writable = mMirrored ? mCapacity - mSize : mCapacity - mHead - mSize;
+    if ( count > writable ) {
+        throw SocketException("Cannot commit more than the writable RingBuffer space");
+    }
+    mSize += count;
+}
+
+void RingBuffer::clear() {
+    mHead = 0;
+    mSize = 0;
+}
+
+size_t RingBuffer::size() const {
+    return mSize;
+}
+
+size_t RingBuffer::space() const {
+    return mCapacity - mSize;
+}
+
+size_t RingBuffer::capacity() const {
+    return mCapacity;
+}
+
+bool RingBuffer::isMirrored() const {
+    return mMirrored;
+}
+
+}   // namespace SocketSparrow
@@ -0,0 +1,197 @@
+#include "Scheduler.hpp"
+#include "Exceptions.hpp"
+
+#include <utility>
+
+namespace SocketSparrow {
+
+namespace {
+
+thread_local Scheduler* currentScheduler = nullptr;
+
+/**
+ * @brief makes a Scheduler the current one for the lifetime of the guard
+ */
+class CurrentSchedulerGuard {
+private:
+    Scheduler* mPrevious;
+
+public:
+    explicit CurrentSchedulerGuard(Scheduler* scheduler)
+        : mPrevious(std::exchange(currentScheduler, scheduler)) {}
+
+    ~CurrentSchedulerGuard() {
+        currentScheduler = mPrevious;
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Fire and forget Coroutine owning a spawned Task
+ */
+struct Scheduler::Detached {
+    struct promise_type {
+        Scheduler* scheduler;
+
+        promise_type(Task<void>&, Scheduler* owner) noexcept : scheduler(owner) {}
+
+        // the frame is destroyed at its end or by the Scheduler, both ways it stops being tracked
+        ~promise_type() {
+            scheduler->mTasks.erase(std::coroutine_handle<promise_type>::from_promise(*this).address());
+        }
+
+        Detached get_return_object() {
+            scheduler->mTasks.insert(std::coroutine_handle<promise_type>::from_promise(*this).address());
+            return {};
+        }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+Scheduler::Detached Scheduler::runDetached(Task<void> task, Scheduler* scheduler) {
+    try {
+        co_await std::move(task);
+    } catch ( ... ) {
+        if ( !scheduler->mError ) {
+            scheduler->mError = std::current_exception();
+        }
+    }
+    scheduler->mActive--;
+}
+
+Scheduler::Scheduler() {}
+
+Scheduler::~Scheduler() {
+    // parked Coroutines never resume, their Sockets may die with their frames
+    for ( const Waiters& waiters : mWaiters ) {
+        AsyncOperation* operation = waiters.reader != nullptr ? waiters.reader : waiters.writer;
+        if ( operation != nullptr && mReactor.contains(operation->getSocket()) ) {
+            mReactor.remove(operation->getSocket());
+        }
+    }
+    mWaiters.clear();
+
+    while ( !mTasks.empty() ) {
+        std::coroutine_handle<>::from_address(*mTasks.begin()).destroy();
+    }
+}
+
+Scheduler* Scheduler::current() {
+    return currentScheduler;
+}
+
+void Scheduler::spawn(Task<void> task) {
+    CurrentSchedulerGuard guard(this);
+    mActive++;
+    runDetached(std::move(task), this);
+}
+
+void Scheduler::run() {
+    CurrentSchedulerGuard guard(this);
+    while ( mActive > 0 && !mStopRequested ) {
+        if ( mError ) {
+            break;
+        }
+        mReactor.poll(-1);
+    }
+    mStopRequested = false;
+
+    if ( mError ) {
+        std::rethrow_exception(std::exchange(mError, nullptr));
+    }
+}
+
+void Scheduler::stop() {
+    mStopRequested = true;
+    mReactor.wakeup();
+}
+
+size_t Scheduler::active() const {
+    return mActive;
+}
+
+Reactor& Scheduler::getReactor() {
+    return mReactor;
+}
+
+void Scheduler::wait(AsyncOperation& operation) {
+    Socket& socket = operation.getSocket();
+    int fd = socket.getNativeHandle();
+    if ( fd < 0 ) {
+        throw SocketException("Cannot wait on an invalid Socket");
+    }
+
+    if ( static_cast<size_t>(fd) >= mWaiters.size() ) {
+        mWaiters.resize(static_cast<size_t>(fd) + 1);
+    }
+
+    AsyncOperation*& slot = hasEvent(operation.mInterest, IOEvent::Read)
+        ? mWaiters[fd].reader
+        : mWaiters[fd].writer;
+    if ( slot != nullptr ) {
+        throw SocketException("Another Coroutine is already waiting on this Socket");
+    }
+    slot = &operation;
+
+    updateRegistration(socket);
+}
+
+void Scheduler::updateRegistration(Socket& socket) {
+    const Waiters& waiters = mWaiters[socket.getNativeHandle()];
+    IOEvent interest = IOEvent::None;
+    if ( waiters.reader != nullptr ) interest |= IOEvent::Read;
+    if ( waiters.writer != nullptr ) interest |= IOEvent::Write;
+
+    if ( interest == IOEvent::None ) {
+        if ( mReactor.contains(socket) ) {
+            mReactor.remove(socket);
+        }
+    } else if ( mReactor.contains(socket) ) {
+        mReactor.modify(socket, interest);
+    } else {
+        mReactor.add(socket, interest, *this);
+    }
+}
+
+void Scheduler::retry(Socket& socket, AsyncOperation* Waiters::* slot) {
+    int fd = socket.getNativeHandle();
+    if ( fd < 0 || static_cast<size_t>(fd) >= mWaiters.size() ) {
+        return;
+    }
+
+    AsyncOperation* operation = mWaiters[fd].*slot;
+    if ( operation == nullptr || !operation->attempt() ) {
+        return;
+    }
+
+    // unpark before resuming, the Coroutine may wait again or destroy the Socket
+    mWaiters[fd].*slot = nullptr;
+    updateRegistration(socket);
+    operation->mHandle.resume();
+}
+
+void Scheduler::onReadable(Socket& socket) {
+    retry(socket, &Waiters::reader);
+}
+
+void Scheduler::onWritable(Socket& socket) {
+    retry(socket, &Waiters::writer);
+}
+
+void Scheduler::onHangUp(Socket& socket) {
+    int fd = socket.getNativeHandle();
+    retry(socket, &Waiters::reader);
+    if ( static_cast<size_t>(fd) < mWaiters.size() && mWaiters[fd].writer != nullptr ) {
+        retry(mWaiters[fd].writer->getSocket(), &Waiters::writer);
+    }
+}
+
+void Scheduler::onError(Socket& socket) {
+    onHangUp(socket);
+}
+
+}   // namespace SocketSparrow
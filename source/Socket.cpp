@@ -4,22 +4,34 @@
 
 #include <thread>
 #include <cstring>
+#include <cstddef>
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include <new>
+#include <utility>
 
 #include <sys/socket.h>
+#include <sys/sendfile.h>
+#include <sys/uio.h>
 #include <sys/unistd.h>
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <error.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <linux/errqueue.h>
 
 namespace SocketSparrow {
 
 using namespace Util;
 
-Socket::Socket(int fd, std::shared_ptr<Endpoint> endpoint, SocketType protocol)
+Socket::Socket(int fd, const Endpoint& endpoint, SocketType protocol)
     : mNativeSocket(fd),
     mProtocol(protocol),
-    mAddressFamily(endpoint->getAddressFamily()),
+    mAddressFamily(endpoint.getAddressFamily()),
     mEndpoint(endpoint) {
     if ( mNativeSocket == -1 ) {
         throw SocketException("Failed to create Socket");
@@ -27,6 +39,54 @@ Socket::Socket(int fd, std::shared_ptr<Endpoint> endpoint, SocketType protocol)
     mState = SocketState::Open;
 }
 
+AcceptedConnection::AcceptedConnection(AcceptedConnection&& other) noexcept
+    : fd(other.release()),
+    endpoint(other.endpoint),
+    type(other.type) {}
+
+AcceptedConnection& AcceptedConnection::operator=(AcceptedConnection&& other) noexcept {
+    if ( this != &other ) {
+        reset();
+        fd = other.release();
+        endpoint = other.endpoint;
+        type = other.type;
+    }
+    return *this;
+}
+
+AcceptedConnection::~AcceptedConnection() {
+    reset();
+}
+
+int AcceptedConnection::release() {
+    int released = fd;
+    fd = -1;
+    return released;
+}
+
+void AcceptedConnection::reset() {
+    if ( fd != -1 ) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+Socket::Socket(int fd, std::shared_ptr<Endpoint> endpoint, SocketType protocol)
+    : Socket(fd, *endpoint, protocol) {}
+
+Socket::Socket(AcceptedConnection&& connection)
+    : mNativeSocket(connection.fd),
+    mProtocol(connection.type),
+    mAddressFamily(connection.endpoint.getAddressFamily()),
+    mEndpoint(connection.endpoint) {
+    if ( mNativeSocket == -1 ) {
+        throw SocketException("Cannot create a Socket from an empty AcceptedConnection");
+    }
+    connection.release();
+    mState = SocketState::Connected;
+    mNonBlocking = true;
+}
+
 Socket::Socket(AddressFamily af, SocketType protocol)
     : mProtocol(protocol), 
     mAddressFamily(af) {
@@ -42,7 +102,7 @@ Socket::Socket(AddressFamily af, SocketType protocol)
     mState = SocketState::Open;
 }
 
-Socket::Socket(AddressFamily af, std::shared_ptr<Endpoint> endpoint)
+Socket::Socket(AddressFamily af, const Endpoint& endpoint)
     : mProtocol(SocketType::TCP), 
     mAddressFamily(af) {
     mNativeSocket = socket(
@@ -60,13 +120,188 @@ Socket::Socket(AddressFamily af, std::shared_ptr<Endpoint> endpoint)
     bind(endpoint);
 }
 
+Socket::Socket(int fd, AddressFamily af, SocketType protocol)
+    : mNativeSocket(fd),
+    mProtocol(protocol),
+    mAddressFamily(af) {
+    mState = SocketState::Open;
+}
+
+Socket::Socket(Socket&& other) noexcept
+    : mNativeSocket(std::exchange(other.mNativeSocket, -1)),
+    mProtocol(other.mProtocol),
+    mAddressFamily(other.mAddressFamily),
+    mEndpoint(std::move(other.mEndpoint)),
+    mState(std::exchange(other.mState, SocketState::Closed)),
+    mNonBlocking(other.mNonBlocking),
+    mSenderCache(std::move(other.mSenderCache)),
+    mZeroCopy(std::exchange(other.mZeroCopy, false)),
+    mZeroCopyNextId(std::exchange(other.mZeroCopyNextId, 0)),
+    mSplicePipe{ std::exchange(other.mSplicePipe[0], -1), std::exchange(other.mSplicePipe[1], -1) },
+    mSplicePending(std::exchange(other.mSplicePending, 0)) {
+    other.mEndpoint.reset();
+}
+
+Socket& Socket::operator=(Socket&& other) noexcept {
+    if ( this != &other ) {
+        closeDescriptors();
+        mNativeSocket = std::exchange(other.mNativeSocket, -1);
+        mProtocol = other.mProtocol;
+        mAddressFamily = other.mAddressFamily;
+        mEndpoint = std::move(other.mEndpoint);
+        other.mEndpoint.reset();
+        mState = std::exchange(other.mState, SocketState::Closed);
+        mNonBlocking = other.mNonBlocking;
+        mSenderCache = std::move(other.mSenderCache);
+        mZeroCopy = std::exchange(other.mZeroCopy, false);
+        mZeroCopyNextId = std::exchange(other.mZeroCopyNextId, 0);
+        mSplicePipe[0] = std::exchange(other.mSplicePipe[0], -1);
+        mSplicePipe[1] = std::exchange(other.mSplicePipe[1], -1);
+        mSplicePending = std::exchange(other.mSplicePending, 0);
+    }
+    return *this;
+}
+
 Socket::~Socket() {
-    close(mNativeSocket);
+    closeDescriptors();
+}
+
+void Socket::closeDescriptors() {
+    if ( mSplicePipe[0] != -1 ) {
+        close(mSplicePipe[0]);
+        close(mSplicePipe[1]);
+        mSplicePipe[0] = mSplicePipe[1] = -1;
+        mSplicePending = 0;
+    }
+    if ( mNativeSocket != -1 ) {
+        close(mNativeSocket);
+        mNativeSocket = -1;
+    }
     mState = SocketState::Closed;
 }
 
+bool Socket::isConnectionOriented() const {
+    return mProtocol == SocketType::TCP || mProtocol == SocketType::SeqPacket;
+}
 
-void Socket::bind(std::shared_ptr<Endpoint> endpoint) {
+int Socket::multicastLevel() const {
+    if ( mProtocol != SocketType::UDP ) {
+        throw SocketException("Multicast needs a UDP socket");
+    }
+    switch ( mAddressFamily ) {
+    case AddressFamily::IPv4: return IPPROTO_IP;
+    case AddressFamily::IPv6: return IPPROTO_IPV6;
+    default: throw SocketException("Multicast needs an IPv4 or IPv6 socket");
+    }
+}
+
+void Socket::changeMembership(int option, const Endpoint& group, const Endpoint* source, unsigned interfaceIndex) {
+    int level = multicastLevel();
+    if ( group.getAddressFamily() != mAddressFamily || (source && source->getAddressFamily() != mAddressFamily) ) {
+        throw SocketException("Multicast address does not match the Address Family of the Socket");
+    }
+
+    // the protocol independent MCAST_* requests take the same structures for IPv4 and IPv6
+    if ( source ) {
+        group_source_req request{};
+        request.gsr_interface = interfaceIndex;
+        std::memcpy(&request.gsr_group, group.c_addr(), group.c_size());
+        std::memcpy(&request.gsr_source, source->c_addr(), source->c_size());
+        if ( setsockopt(mNativeSocket, level, option, &request, sizeof(request)) == -1 ) {
+            throw SocketException(errno, "Failed to change source-specific group membership");
+        }
+        return;
+    }
+
+    group_req request{};
+    request.gr_interface = interfaceIndex;
+    std::memcpy(&request.gr_group, group.c_addr(), group.c_size());
+    if ( setsockopt(mNativeSocket, level, option, &request, sizeof(request)) == -1 ) {
+        throw SocketException(errno, "Failed to change group membership");
+    }
+}
+
+std::pair<Socket, Socket> Socket::pair(SocketType type) {
+    int fds[2];
+    if ( socketpair(AF_UNIX, getNativeSocketType(type) | SOCK_CLOEXEC, 0, fds) == -1 ) {
+        throw SocketException(errno, "Failed to create Socket pair");
+    }
+
+    std::pair<Socket, Socket> sockets(Socket(fds[0], AddressFamily::Unix, type), Socket(fds[1], AddressFamily::Unix, type));
+    sockets.first.mState = SocketState::Connected;
+    sockets.second.mState = SocketState::Connected;
+    return sockets;
+}
+
+Socket Socket::adopt(int fd) {
+    int type = 0;
+    int domain = 0;
+    socklen_t size = sizeof(int);
+    if ( getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &size) == -1 ) {
+        throw SocketException(errno, "Failed to adopt the descriptor");
+    }
+    size = sizeof(int);
+    if ( getsockopt(fd, SOL_SOCKET, SO_DOMAIN, &domain, &size) == -1 ) {
+        throw SocketException(errno, "Failed to adopt the descriptor");
+    }
+    if ( (type != SOCK_STREAM && type != SOCK_DGRAM && type != SOCK_SEQPACKET)
+        || (domain != AF_INET && domain != AF_INET6 && domain != AF_UNIX) ) {
+        throw SocketException("Cannot adopt a descriptor that is not an IP or Unix Domain socket");
+    }
+
+    int flags = fcntl(fd, F_GETFL);
+    if ( flags == -1 ) {
+        throw SocketException(errno, "Failed to adopt the descriptor");
+    }
+
+    Socket socket(fd, static_cast<AddressFamily>(domain), static_cast<SocketType>(type));
+    socket.mNonBlocking = (flags & O_NONBLOCK) != 0;
+
+    // like accept() and bind(), the Endpoint is the peer of a connection and the local address otherwise
+    sockaddr_storage address;
+    socklen_t addressSize = sizeof(address);
+    int listening = 0;
+    size = sizeof(listening);
+    if ( getpeername(fd, reinterpret_cast<sockaddr*>(&address), &addressSize) == 0 ) {
+        socket.mState = SocketState::Connected;
+        socket.mEndpoint = Endpoint(address, addressSize);
+    } else {
+        addressSize = sizeof(address);
+        if ( getsockname(fd, reinterpret_cast<sockaddr*>(&address), &addressSize) == 0 ) {
+            Endpoint local(address, addressSize);
+            bool bound = local.getAddressFamily() == AddressFamily::Unix
+                ? addressSize > offsetof(sockaddr_un, sun_path)
+                : local.getPort() != 0;
+            if ( bound ) {
+                socket.mEndpoint = local;
+            }
+        }
+        if ( getsockopt(fd, SOL_SOCKET, SO_ACCEPTCONN, &listening, &size) == 0 && listening != 0 ) {
+            socket.mState = SocketState::Listening;
+        }
+    }
+    return socket;
+}
+
+
+int Socket::getNativeHandle() const {
+    return mNativeSocket;
+}
+
+int Socket::release() {
+    int released = std::exchange(mNativeSocket, -1);
+    closeDescriptors();
+    return released;
+}
+
+SocketState Socket::getState() const {
+    return mState;
+}
+
+Socket::Socket(AddressFamily af, std::shared_ptr<Endpoint> endpoint)
+    : Socket(af, *endpoint) {}
+
+void Socket::bind(const Endpoint& endpoint) {
     mEndpoint = endpoint;
     if ( ::bind(mNativeSocket, mEndpoint->c_addr(), mEndpoint->c_size()) == -1 ) {
         throw SocketException(errno, "Failed to bind to endpoint");
@@ -74,31 +309,39 @@ void Socket::bind(std::shared_ptr<Endpoint> endpoint) {
 
 }
 
+void Socket::bind(std::shared_ptr<Endpoint> endpoint) {
+    bind(*endpoint);
+}
+
 void Socket::bindToPort(uint16_t port) {
-    mEndpoint = std::make_shared<Endpoint>(mAddressFamily, port);
+    mEndpoint = Endpoint(mAddressFamily, port);
     if ( ::bind(mNativeSocket, mEndpoint->c_addr(), mEndpoint->c_size()) == -1 ) {
         throw SocketException(errno, "Failed to bind to endpoint");
     }
 }
 
-void Socket::connect(std::shared_ptr<Endpoint> endpoint) {
-    if ( mProtocol != SocketType::TCP ) {
+void Socket::connect(const Endpoint& endpoint) {
+    if ( !isConnectionOriented() ) {
         throw SocketException("Cannot connect a UDP socket");
     }
 
-    if ( ::connect(mNativeSocket, endpoint->c_addr(), endpoint->c_size()) == -1 ) {
+    if ( ::connect(mNativeSocket, endpoint.c_addr(), endpoint.c_size()) == -1 ) {
         throw SocketException(errno, "Failed to connect");
     }
 
     mState = SocketState::Connected;
 }
 
+void Socket::connect(std::shared_ptr<Endpoint> endpoint) {
+    connect(*endpoint);
+}
+
 void Socket::listen(int backlog) {
-    if ( mProtocol != SocketType::TCP ) {
+    if ( !isConnectionOriented() ) {
         throw SocketException("Cannot listen on a UDP socket");
     }
 
-    if( mEndpoint == nullptr ) {
+    if( !mEndpoint ) {
         throw SocketException("Cannot listen without binding to an endpoint");
     }
 
@@ -110,11 +353,11 @@ void Socket::listen(int backlog) {
 }
 
 std::shared_ptr<Socket> Socket::accept() {
-    if ( mProtocol != SocketType::TCP ) {
+    if ( !isConnectionOriented() ) {
         throw SocketException("Cannot accept on a UDP socket");
     }
 
-    if( mEndpoint == nullptr ) {
+    if( !mEndpoint ) {
         throw SocketException("Cannot accept without binding to an endpoint");
     }
 
@@ -130,13 +373,74 @@ std::shared_ptr<Socket> Socket::accept() {
         throw SocketException(errno, "Failed to accept");
     }
 
-    std::shared_ptr<Endpoint> clientEndpoint = std::make_shared<Endpoint>(clientAddr, clientAddrSize);
-    Socket* Connection = new Socket(clientSocket, clientEndpoint, mProtocol);
+    Socket* Connection = new Socket(clientSocket, Endpoint(clientAddr, clientAddrSize), mProtocol);
     Connection->mState = SocketState::Connected;
     
     return std::shared_ptr<Socket>(Connection);
 }
 
+size_t Socket::acceptMany(std::span<AcceptedConnection> connections, size_t maxCount) {
+    if ( !isConnectionOriented() ) {
+        throw SocketException("Cannot accept on a UDP socket");
+    }
+
+    if( mState != SocketState::Listening ) {
+        throw SocketException("Cannot accept without listening");
+    }
+
+    const size_t limit = std::min(connections.size(), maxCount);
+    size_t count = 0;
+    while ( count < limit ) {
+        if ( count > 0 && !mNonBlocking ) {
+            pollfd descriptor = { mNativeSocket, POLLIN, 0 };
+            if ( ::poll(&descriptor, 1, 0) <= 0 ) {
+                break;
+            }
+        }
+
+        sockaddr_storage clientAddr;
+        socklen_t clientAddrSize = sizeof(clientAddr);
+        int clientSocket = ::accept4(mNativeSocket, reinterpret_cast<sockaddr*>(&clientAddr), &clientAddrSize, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if ( clientSocket == -1 ) {
+            if ( errno == EINTR || errno == ECONNABORTED ) {
+                continue;
+            }
+            if ( errno == EAGAIN || errno == EWOULDBLOCK || count > 0 ) {
+                break;
+            }
+            throw SocketException(errno, "Failed to accept");
+        }
+
+        AcceptedConnection& connection = connections[count++];
+        connection.reset();
+        connection.fd = clientSocket;
+        connection.endpoint = Endpoint(clientAddr, clientAddrSize);
+        connection.type = mProtocol;
+    }
+    return count;
+}
+
+IOResult<Socket> Socket::try_accept() {
+    if ( !isConnectionOriented() || mState != SocketState::Listening ) {
+        return IOResult<Socket>::fromErrno(EINVAL);
+    }
+
+    sockaddr_storage clientAddr;
+    socklen_t clientAddrSize = sizeof(clientAddr);
+    int clientSocket;
+    do {
+        clientSocket = ::accept4(mNativeSocket, reinterpret_cast<sockaddr*>(&clientAddr), &clientAddrSize, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    } while ( clientSocket == -1 && (errno == EINTR || errno == ECONNABORTED) );
+    if ( clientSocket == -1 ) {
+        return IOResult<Socket>::fromErrno(errno);
+    }
+
+    Socket connection(clientSocket, Endpoint(clientAddr, clientAddrSize), mProtocol);
+    connection.mState = SocketState::Connected;
+    connection.mNonBlocking = true;
+    return connection;
+}
+
 void Socket::enableBroadcast(bool enable) {
     int opt = enable ? 1 : 0;
     if ( setsockopt(mNativeSocket, SOL_SOCKET, SO_BROADCAST, &opt, sizeof(opt)) == -1 ) {
@@ -144,6 +448,75 @@ void Socket::enableBroadcast(bool enable) {
     }
 }
 
+void Socket::setSegmentSize(uint16_t segmentSize) {
+    if ( mProtocol != SocketType::UDP ) {
+        throw SocketException("Segmentation offload needs a UDP socket");
+    }
+    int opt = segmentSize;
+    if ( setsockopt(mNativeSocket, SOL_UDP, UDP_SEGMENT, &opt, sizeof(opt)) == -1 ) {
+        throw SocketException(errno,"Failed to set socket option");
+    }
+}
+
+void Socket::enableGro(bool enable) {
+    if ( mProtocol != SocketType::UDP ) {
+        throw SocketException("Receive offload needs a UDP socket");
+    }
+    int opt = enable ? 1 : 0;
+    if ( setsockopt(mNativeSocket, SOL_UDP, UDP_GRO, &opt, sizeof(opt)) == -1 ) {
+        throw SocketException(errno,"Failed to set socket option");
+    }
+}
+
+void Socket::joinGroup(const Endpoint& group, unsigned interfaceIndex) {
+    changeMembership(MCAST_JOIN_GROUP, group, nullptr, interfaceIndex);
+}
+
+void Socket::leaveGroup(const Endpoint& group, unsigned interfaceIndex) {
+    changeMembership(MCAST_LEAVE_GROUP, group, nullptr, interfaceIndex);
+}
+
+void Socket::joinSourceGroup(const Endpoint& group, const Endpoint& source, unsigned interfaceIndex) {
+    changeMembership(MCAST_JOIN_SOURCE_GROUP, group, &source, interfaceIndex);
+}
+
+void Socket::leaveSourceGroup(const Endpoint& group, const Endpoint& source, unsigned interfaceIndex) {
+    changeMembership(MCAST_LEAVE_SOURCE_GROUP, group, &source, interfaceIndex);
+}
+
+void Socket::enableMulticastLoop(bool enable) {
+    int level = multicastLevel();
+    int opt = enable ? 1 : 0;
+    int name = level == IPPROTO_IP ? IP_MULTICAST_LOOP : IPV6_MULTICAST_LOOP;
+    if ( setsockopt(mNativeSocket, level, name, &opt, sizeof(opt)) == -1 ) {
+        throw SocketException(errno,"Failed to set socket option");
+    }
+}
+
+void Socket::setMulticastTTL(int ttl) {
+    int level = multicastLevel();
+    int name = level == IPPROTO_IP ? IP_MULTICAST_TTL : IPV6_MULTICAST_HOPS;
+    if ( setsockopt(mNativeSocket, level, name, &ttl, sizeof(ttl)) == -1 ) {
+        throw SocketException(errno,"Failed to set socket option");
+    }
+}
+
+void Socket::setMulticastInterface(unsigned interfaceIndex) {
+    int level = multicastLevel();
+    if ( level == IPPROTO_IP ) {
+        ip_mreqn request{};
+        request.imr_ifindex = static_cast<int>(interfaceIndex);
+        if ( setsockopt(mNativeSocket, IPPROTO_IP, IP_MULTICAST_IF, &request, sizeof(request)) == -1 ) {
+            throw SocketException(errno,"Failed to set socket option");
+        }
+        return;
+    }
+
+    if ( setsockopt(mNativeSocket, IPPROTO_IPV6, IPV6_MULTICAST_IF, &interfaceIndex, sizeof(interfaceIndex)) == -1 ) {
+        throw SocketException(errno,"Failed to set socket option");
+    }
+}
+
 void Socket::enablePortReuse(bool enable) {
     int opt = enable ? 1 : 0;
     if ( setsockopt(mNativeSocket, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) == -1 ) {
@@ -173,9 +546,97 @@ void Socket::enableNonBlocking(bool enable) {
     if ( fcntl(mNativeSocket, F_SETFL, flags) == -1 ) {
         throw SocketException(errno,"Failed to set socket flags");
     }
+    mNonBlocking = enable;
+}
+
+bool Socket::isNonBlocking() const {
+    return mNonBlocking;
+}
+
+PeerCredentials Socket::peerCredentials() const {
+    ucred credentials;
+    socklen_t size = sizeof(credentials);
+    if ( getsockopt(mNativeSocket, SOL_SOCKET, SO_PEERCRED, &credentials, &size) == -1 ) {
+        throw SocketException(errno, "Failed to get peer credentials");
+    }
+    if ( credentials.pid == 0 ) {
+        throw SocketException("Socket has no peer credentials");
+    }
+    return PeerCredentials{ credentials.pid, credentials.uid, credentials.gid };
+}
+
+void Socket::enableZeroCopy(bool enable) {
+    int opt = enable ? 1 : 0;
+    if ( setsockopt(mNativeSocket, SOL_SOCKET, SO_ZEROCOPY, &opt, sizeof(opt)) == -1 ) {
+        throw SocketException(errno, "Failed to set socket option");
+    }
+    mZeroCopy = enable;
+}
+
+bool Socket::isZeroCopy() const {
+    return mZeroCopy;
+}
+
+ZeroCopySend Socket::sendZeroCopy(std::span<const std::byte> data) {
+    if ( !mZeroCopy ) {
+        throw SocketException("Cannot sendZeroCopy without enableZeroCopy");
+    }
+
+    ssize_t sent = ::send(mNativeSocket, data.data(), data.size(), MSG_ZEROCOPY);
+    if ( sent == -1 ) {
+        throw SendError(errno, "Failed to send");
+    }
+
+    // the kernel only counts sends that queued data
+    uint32_t id = mZeroCopyNextId;
+    if ( sent > 0 ) {
+        mZeroCopyNextId++;
+    }
+    return { sent, id };
+}
+
+size_t Socket::readZeroCopyCompletions(const std::function<void(const ZeroCopyCompletion&)>& callback) const {
+    size_t completions = 0;
+    while ( true ) {
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(sock_extended_err)) + 64];
+        msghdr message = {};
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+
+        if ( ::recvmsg(mNativeSocket, &message, MSG_ERRQUEUE | MSG_DONTWAIT) == -1 ) {
+            if ( errno == EAGAIN || errno == EWOULDBLOCK ) {
+                return completions;
+            }
+            if ( errno == EINTR ) {
+                continue;
+            }
+            throw RecvError(errno, "Failed to read the error queue");
+        }
+
+        for ( cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header) ) {
+            bool recvErr = (header->cmsg_level == SOL_IP && header->cmsg_type == IP_RECVERR)
+                || (header->cmsg_level == SOL_IPV6 && header->cmsg_type == IPV6_RECVERR);
+            if ( !recvErr ) {
+                continue;
+            }
+
+            sock_extended_err error;
+            std::memcpy(&error, CMSG_DATA(header), sizeof(error));
+            if ( error.ee_origin != SO_EE_ORIGIN_ZEROCOPY || error.ee_errno != 0 ) {
+                continue;
+            }
+
+            callback(ZeroCopyCompletion{
+                error.ee_info,
+                error.ee_data,
+                (error.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0
+            });
+            completions++;
+        }
+    }
 }
 
-ssize_t Socket::send(std::vector<char> data) const {
+ssize_t Socket::send(std::span<const std::byte> data) const {
     ssize_t sent = ::send(mNativeSocket, data.data(), data.size(), 0);
     if ( sent == -1 ) {
         throw SendError(errno, "Failed to send");
@@ -183,34 +644,359 @@ ssize_t Socket::send(std::vector<char> data) const {
     return sent;
 }
 
-ssize_t Socket::send(const std::string& data) const {
-    return send(std::vector<char>(data.begin(), data.end()));
+ssize_t Socket::send(const std::vector<char>& data) const {
+    return send(std::as_bytes(std::span(data)));
 }
 
-ssize_t Socket::recv(std::vector<char>& buffer, ExplicitBool autoresize) const {
-    ssize_t totalReceived = 0;
-    if(autoresize) {
-        buffer.resize(1024);
+ssize_t Socket::send(std::string_view data) const {
+    return send(std::as_bytes(std::span(data)));
+}
+
+IOResult<size_t> Socket::try_send(std::span<const std::byte> data) const noexcept {
+    ssize_t sent;
+    do {
+        sent = ::send(mNativeSocket, data.data(), data.size(), MSG_NOSIGNAL);
+    } while ( sent == -1 && errno == EINTR );
+    if ( sent == -1 ) {
+        return IOResult<size_t>::fromErrno(errno);
     }
-    while(totalReceived < buffer.size()) {
-        ssize_t received = ::recv(mNativeSocket, buffer.data() + totalReceived, buffer.size() - totalReceived, 0);
-        if ( received == -1 ) {
-            throw RecvError(errno, "Failed to receive");
+    return static_cast<size_t>(sent);
+}
+
+IOResult<size_t> Socket::try_send(std::string_view data) const noexcept {
+    return try_send(std::as_bytes(std::span(data)));
+}
+
+ssize_t Socket::recv(std::span<std::byte> buffer) const {
+    ssize_t received = ::recv(mNativeSocket, buffer.data(), buffer.size(), 0);
+    if ( received == -1 ) {
+        throw RecvError(errno, "Failed to receive");
+    }
+    return received;
+}
+
+IOResult<size_t> Socket::try_recv(std::span<std::byte> buffer) const noexcept {
+    ssize_t received;
+    do {
+        received = ::recv(mNativeSocket, buffer.data(), buffer.size(), 0);
+    } while ( received == -1 && errno == EINTR );
+    if ( received == -1 ) {
+        return IOResult<size_t>::fromErrno(errno);
+    }
+    return static_cast<size_t>(received);
+}
+
+namespace {
+
+/**
+ * @brief copy the iovecs of a Buffer list, on the stack for the usual short lists
+ */
+template<typename Buffer, typename Function>
+ssize_t withIovecs(std::initializer_list<Buffer> buffers, Function function) {
+    constexpr size_t stackBuffers = 16;
+    if ( buffers.size() <= stackBuffers ) {
+        iovec iovecs[stackBuffers];
+        std::transform(buffers.begin(), buffers.end(), iovecs, [](const Buffer& buffer) { return buffer.native(); });
+        return function(std::span<const iovec>(iovecs, buffers.size()));
+    }
+    std::vector<iovec> iovecs;
+    iovecs.reserve(buffers.size());
+    std::transform(buffers.begin(), buffers.end(), std::back_inserter(iovecs), [](const Buffer& buffer) { return buffer.native(); });
+    return function(std::span<const iovec>(iovecs));
+}
+
+} // namespace
+
+ssize_t Socket::send(std::span<const iovec> buffers) const {
+    if ( mProtocol == SocketType::UDP && buffers.size() > IOV_MAX ) {
+        throw SendError(EMSGSIZE, "Cannot send a datagram of more than IOV_MAX buffers");
+    }
+
+    size_t total = 0;
+    size_t index = 0;
+    size_t offset = 0;  // bytes of buffers[index] that were already sent
+    while ( index < buffers.size() ) {
+        msghdr message = {};
+        iovec rest;
+        if ( offset > 0 ) {
+            // finish a partially sent buffer on its own, the caller's array stays untouched
+            rest.iov_base = static_cast<char*>(buffers[index].iov_base) + offset;
+            rest.iov_len = buffers[index].iov_len - offset;
+            message.msg_iov = &rest;
+            message.msg_iovlen = 1;
+        } else {
+            message.msg_iov = const_cast<iovec*>(&buffers[index]);
+            message.msg_iovlen = std::min<size_t>(buffers.size() - index, IOV_MAX);
         }
-        totalReceived += received;
-        if(autoresize && buffer.size() - totalReceived < 1024 && received == 1024) {
-            buffer.resize(buffer.size() + 1024);
+
+        ssize_t sent = ::sendmsg(mNativeSocket, &message, 0);
+        if ( sent == -1 ) {
+            if ( errno == EINTR ) {
+                continue;
+            }
+            if ( total > 0 ) {
+                break;
+            }
+            throw SendError(errno, "Failed to send");
         }
+        total += sent;
 
-        if(received < 1024) {
-            break;
+        size_t remaining = sent;
+        while ( index < buffers.size() && remaining >= buffers[index].iov_len - offset ) {
+            remaining -= buffers[index].iov_len - offset;
+            offset = 0;
+            index++;
+        }
+        offset += remaining;
+    }
+    return total;
+}
+
+ssize_t Socket::sendv(std::initializer_list<ConstBuffer> buffers) const {
+    return withIovecs(buffers, [this](std::span<const iovec> iovecs) { return send(iovecs); });
+}
+
+ssize_t Socket::recvv(std::span<const iovec> buffers) const {
+    msghdr message = {};
+    message.msg_iov = const_cast<iovec*>(buffers.data());
+    message.msg_iovlen = std::min<size_t>(buffers.size(), IOV_MAX);
+
+    ssize_t received = ::recvmsg(mNativeSocket, &message, 0);
+    if ( received == -1 ) {
+        throw RecvError(errno, "Failed to receive");
+    }
+    return received;
+}
+
+ssize_t Socket::recvv(std::initializer_list<MutableBuffer> buffers) const {
+    return withIovecs(buffers, [this](std::span<const iovec> iovecs) { return recvv(iovecs); });
+}
+
+ssize_t Socket::sendFile(int fd, off_t offset, size_t length) const {
+    size_t total = 0;
+    while ( total < length ) {
+        ssize_t sent = ::sendfile(mNativeSocket, fd, &offset, length - total);
+        if ( sent == -1 ) {
+            if ( errno == EINTR ) {
+                continue;
+            }
+            if ( total > 0 ) {
+                break;
+            }
+            throw SendError(errno, "Failed to send file");
+        }
+        if ( sent == 0 ) {
+            break;  // end of file
         }
+        total += sent;
     }
-    if(autoresize) {
-        buffer.resize(totalReceived);
+    return total;
+}
+
+ssize_t Socket::spliceTo(Socket& destination, size_t length) {
+    if ( mSplicePipe[0] == -1 && pipe2(mSplicePipe, O_CLOEXEC) == -1 ) {
+        throw SocketException(errno, "Failed to create splice pipe");
     }
 
-    return totalReceived;
+    // the pipe is only filled when empty and only drained when filled, so it never blocks
+    // and each side blocks exactly when its Socket does
+    unsigned int flags = SPLICE_F_MOVE | SPLICE_F_NONBLOCK;
+    size_t total = 0;
+    while ( total < length ) {
+        if ( mSplicePending == 0 ) {
+            ssize_t read = ::splice(mNativeSocket, nullptr, mSplicePipe[1], nullptr, length - total,
+                mNonBlocking ? flags : SPLICE_F_MOVE);
+            if ( read == -1 ) {
+                if ( errno == EINTR ) {
+                    continue;
+                }
+                if ( total > 0 ) {
+                    break;
+                }
+                throw RecvError(errno, "Failed to splice from socket");
+            }
+            if ( read == 0 ) {
+                break;  // end of stream
+            }
+            mSplicePending = read;
+        }
+
+        ssize_t written = ::splice(mSplicePipe[0], nullptr, destination.mNativeSocket, nullptr, std::min(mSplicePending, length - total),
+            destination.mNonBlocking ? flags : SPLICE_F_MOVE);
+        if ( written == -1 ) {
+            if ( errno == EINTR ) {
+                continue;
+            }
+            if ( total > 0 ) {
+                break;
+            }
+            throw SendError(errno, "Failed to splice to socket");
+        }
+        mSplicePending -= written;
+        total += written;
+    }
+    return total;
+}
+
+namespace {
+
+constexpr size_t MaxPassedFds = 253;    // SCM_MAX_FD, the kernel limit per message
+
+} // namespace
+
+ssize_t Socket::sendFds(std::span<const int> fds, std::span<const std::byte> data) const {
+    if ( mAddressFamily != AddressFamily::Unix ) {
+        throw SocketException("Descriptors can only be passed over Unix Domain Sockets");
+    }
+    if ( fds.size() > MaxPassedFds ) {
+        throw SocketException("Too many descriptors for one message");
+    }
+
+    const std::byte placeholder{ 0 };
+    if ( data.empty() ) {
+        data = std::span(&placeholder, 1);
+    }
+    iovec payload = { const_cast<std::byte*>(data.data()), data.size() };
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * MaxPassedFds)];
+    msghdr message = {};
+    message.msg_iov = &payload;
+    message.msg_iovlen = 1;
+    if ( !fds.empty() ) {
+        message.msg_control = control;
+        message.msg_controllen = CMSG_SPACE(sizeof(int) * fds.size());
+        cmsghdr* header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+        memcpy(CMSG_DATA(header), fds.data(), sizeof(int) * fds.size());
+    }
+
+    ssize_t sent;
+    do {
+        sent = ::sendmsg(mNativeSocket, &message, MSG_NOSIGNAL);
+    } while ( sent == -1 && errno == EINTR );
+    if ( sent == -1 ) {
+        throw SendError(errno, "Failed to send descriptors");
+    }
+    return sent;
+}
+
+ssize_t Socket::recvFds(std::span<std::byte> buffer, std::vector<int>& fds) const {
+    if ( mAddressFamily != AddressFamily::Unix ) {
+        throw SocketException("Descriptors can only be passed over Unix Domain Sockets");
+    }
+    if ( buffer.empty() ) {
+        throw SocketException("Receiving descriptors needs room for at least one payload byte");
+    }
+
+    iovec payload = { buffer.data(), buffer.size() };
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * MaxPassedFds)];
+    msghdr message = {};
+    message.msg_iov = &payload;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    ssize_t received;
+    do {
+        received = ::recvmsg(mNativeSocket, &message, MSG_CMSG_CLOEXEC);
+    } while ( received == -1 && errno == EINTR );
+    if ( received == -1 ) {
+        throw RecvError(errno, "Failed to receive descriptors");
+    }
+
+    const size_t first = fds.size();
+    for ( cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header) ) {
+        if ( header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS ) {
+            continue;
+        }
+        const size_t count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        const size_t offset = fds.size();
+        fds.resize(offset + count);
+        memcpy(fds.data() + offset, CMSG_DATA(header), sizeof(int) * count);
+    }
+
+    if ( message.msg_flags & MSG_CTRUNC ) {
+        // the message is consumed, so the descriptors that did arrive cannot be handed out as complete
+        for ( size_t i = first; i < fds.size(); i++ ) {
+            close(fds[i]);
+        }
+        fds.resize(first);
+        throw SocketException("Passed descriptors were truncated");
+    }
+    return received;
+}
+
+namespace {
+
+// the largest UDP payload, including datagrams coalesced by GRO
+constexpr size_t MaxDatagramSize = 65536;
+
+/**
+ * @brief uninitialised per thread buffer taking the part of a datagram that does not fit
+ *        the bytes a UDPPacket already holds
+ */
+std::span<char> stagingBuffer() {
+    thread_local std::unique_ptr<char[]> buffer(new char[MaxDatagramSize]);
+    return { buffer.get(), MaxDatagramSize };
+}
+
+/**
+ * @brief receive into a resizable buffer (std::vector<char> or std::string)
+ *        growing it geometrically while reads keep filling it
+ */
+template<typename Buffer>
+ssize_t recvGrowing(int fd, Buffer& buffer, const RecvOptions& options) {
+    const size_t chunkSize = std::max<size_t>(options.chunkSize, 1);
+    const bool exact = options.mode == RecvMode::Exact;
+    const size_t limit = exact ? options.exactSize : options.maxSize;
+
+    // resizing zero-fills every byte past the current size, so only grow to one chunk (or the
+    // size left by the previous call) up front; the capacity of earlier calls still saves allocations
+    buffer.resize(exact ? limit : std::min(std::max(buffer.size(), chunkSize), limit));
+
+    size_t total = 0;
+    while ( total < limit ) {
+        if ( !exact && buffer.size() - total < chunkSize && buffer.size() < limit ) {
+            buffer.resize(std::min(std::max(buffer.size() * 2, total + chunkSize), limit));
+        }
+
+        int flags = exact ? MSG_WAITALL : (total > 0 ? MSG_DONTWAIT : 0);
+        size_t space = buffer.size() - total;
+        ssize_t received = ::recv(fd, buffer.data() + total, space, flags);
+        if ( received == -1 ) {
+            if ( errno == EINTR ) {
+                continue;
+            }
+            if ( total > 0 && (errno == EAGAIN || errno == EWOULDBLOCK) ) {
+                break;
+            }
+            int error = errno;
+            buffer.resize(total);
+            throw RecvError(error, "Failed to receive");
+        }
+        if ( received == 0 ) {
+            break;  // peer closed the connection
+        }
+        total += received;
+
+        if ( options.mode == RecvMode::Once && static_cast<size_t>(received) < space ) {
+            break;  // the read did not fill the buffer, nothing else is queued
+        }
+    }
+
+    buffer.resize(total);
+    return total;
+}
+
+} // namespace
+
+ssize_t Socket::recv(std::vector<char>& buffer, ExplicitBool autoresize) const {
+    if ( autoresize ) {
+        return recv(buffer, RecvOptions());
+    }
+    return recv(std::as_writable_bytes(std::span(buffer)));
 }
 
 ssize_t Socket::recv(std::vector<char>& buffer, size_t size) const {
@@ -219,33 +1005,80 @@ ssize_t Socket::recv(std::vector<char>& buffer, size_t size) const {
 }
 
 ssize_t Socket::recv(std::string& buffer) const {
-    std::vector<char> vec;
-    ssize_t received = recv(vec, ExplicitBool(true));
-    buffer = std::string(vec.begin(), vec.end());
-    return received;
+    return recv(buffer, RecvOptions());
 }
 
-ssize_t Socket::send_to(std::vector<char> data, std::shared_ptr<Endpoint> endpoint) {
+ssize_t Socket::recv(std::vector<char>& buffer, const RecvOptions& options) const {
+    return recvGrowing(mNativeSocket, buffer, options);
+}
+
+ssize_t Socket::recv(std::string& buffer, const RecvOptions& options) const {
+    return recvGrowing(mNativeSocket, buffer, options);
+}
+
+ssize_t Socket::send_to(std::span<const std::byte> data, const Endpoint& endpoint) {
     if(mProtocol != SocketType::UDP) {
         throw SocketException("Cannot send_to from a TCP socket");
     }
-    ssize_t sent = ::sendto(mNativeSocket, data.data(), data.size(), 0, endpoint->c_addr(), endpoint->c_size());
+    ssize_t sent = ::sendto(mNativeSocket, data.data(), data.size(), 0, endpoint.c_addr(), endpoint.c_size());
     if ( sent == -1 ) {
         throw SendError(errno, "Failed to send");
     }
     return sent;
 }
 
-ssize_t Socket::send_to(const std::string& data, std::shared_ptr<Endpoint> endpoint) {
-    return send_to(std::vector<char>(data.begin(), data.end()), endpoint);
-}
-
-ssize_t Socket::send_to(UDPPacket packet) {
+ssize_t Socket::send_to(std::span<const std::byte> data, const Endpoint& endpoint, uint16_t segmentSize) {
+    if ( segmentSize == 0 ) {
+        return send_to(data, endpoint);
+    }
     if(mProtocol != SocketType::UDP) {
         throw SocketException("Cannot send_to from a TCP socket");
     }
 
-    return send_to(packet.data, packet.endpoint);
+    iovec vector = { const_cast<std::byte*>(data.data()), data.size() };
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(segmentSize))] = {};
+    msghdr message = {};
+    message.msg_name = const_cast<sockaddr*>(endpoint.c_addr());
+    message.msg_namelen = endpoint.c_size();
+    message.msg_iov = &vector;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    cmsghdr* header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_UDP;
+    header->cmsg_type = UDP_SEGMENT;
+    header->cmsg_len = CMSG_LEN(sizeof(segmentSize));
+    std::memcpy(CMSG_DATA(header), &segmentSize, sizeof(segmentSize));
+
+    ssize_t sent = ::sendmsg(mNativeSocket, &message, 0);
+    if ( sent == -1 ) {
+        throw SendError(errno, "Failed to send");
+    }
+    return sent;
+}
+
+ssize_t Socket::send_to(std::span<const std::byte> data, std::shared_ptr<Endpoint> endpoint) {
+    return send_to(data, *endpoint);
+}
+
+ssize_t Socket::send_to(const std::vector<char>& data, std::shared_ptr<Endpoint> endpoint) {
+    return send_to(std::as_bytes(std::span(data)), std::move(endpoint));
+}
+
+ssize_t Socket::send_to(std::string_view data, std::shared_ptr<Endpoint> endpoint) {
+    return send_to(std::as_bytes(std::span(data)), std::move(endpoint));
+}
+
+ssize_t Socket::send_to(std::string_view data, const Endpoint& endpoint) {
+    return send_to(std::as_bytes(std::span(data)), endpoint);
+}
+
+ssize_t Socket::send_to(const UDPPacket& packet) {
+    if(!packet.endpoint.isSpecified()) {
+        throw SocketException("Cannot send_to without an Endpoint");
+    }
+    return send_to(std::as_bytes(std::span(packet.data)), packet.endpoint, packet.segmentSize);
 }
 
 UDPPacket Socket::recv_from() const {
@@ -254,15 +1087,248 @@ UDPPacket Socket::recv_from() const {
     }
 
     UDPPacket packet;
-    sockaddr addr;
-    socklen_t size;
-    ssize_t received = ::recvfrom(mNativeSocket, packet.data.data(), packet.data.size(), 0, &addr, &size);
+    recv_from(packet);
+    return packet;
+}
+
+ssize_t Socket::recv_from(UDPPacket& packet) const {
+    if(mProtocol != SocketType::UDP) {
+        throw SocketException("Cannot recv_from from a TCP socket");
+    }
+
+    IOResult<size_t> received = receiveFrom(packet, 0);
+    if ( !received ) {
+        if ( received.error().value() == EMSGSIZE ) {
+            throw RecvError(EMSGSIZE, "Received datagram is larger than the packet");
+        }
+        throw RecvError(received.error().value(), "Failed to receive");
+    }
+    return static_cast<ssize_t>(received.value());
+}
+
+IOResult<size_t> Socket::receiveFrom(UDPPacket& packet, int flags) const noexcept {
+    if ( packet.data.capacity() == 0 ) {
+        try {
+            packet.data.reserve(MAX_UDP_PACKET_SIZE);
+        } catch ( const std::bad_alloc& ) {
+            return IOResult<size_t>::fromErrno(ENOMEM);
+        }
+    }
+
+    // growing the vector would zero-fill it, so the datagram lands in the bytes the packet
+    // already holds and only spills into a staging buffer beyond them
+    const size_t initialised = packet.data.size();
+    const size_t limit = std::min(packet.data.capacity(), MaxDatagramSize);
+    std::span<char> staging = stagingBuffer();
+    iovec vectors[2] = {
+        { packet.data.data(), std::min(initialised, limit) },
+        { staging.data(), limit - std::min(initialised, limit) }
+    };
+
+    // recvmsg instead of recvfrom, a GRO enabled Socket reports the coalesced segment size as cmsg
+    sockaddr_storage addr;
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    msghdr message = {};
+    message.msg_name = &addr;
+    message.msg_iov = vectors;
+    message.msg_iovlen = 2;
+    message.msg_control = control;
+
+    ssize_t received;
+    do {
+        message.msg_namelen = sizeof(addr);
+        message.msg_controllen = sizeof(control);
+        received = ::recvmsg(mNativeSocket, &message, flags);
+    } while ( received == -1 && errno == EINTR );
+
     if ( received == -1 ) {
-        throw RecvError(errno, "Failed to receive");
+        const int error = errno;
+        // a packet that only would have blocked keeps its buffer for the retry
+        if ( error != EAGAIN && error != EWOULDBLOCK ) {
+            packet.data.clear();
+        }
+        return IOResult<size_t>::fromErrno(error);
     }
-    
+    if ( (message.msg_flags & MSG_TRUNC) != 0 ) {
+        // the rest of the datagram is gone, a partial payload would look complete
+        packet.data.clear();
+        return IOResult<size_t>::fromErrno(EMSGSIZE);
+    }
+
+    packet.segmentSize = 0;
+    for ( cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header) ) {
+        if ( header->cmsg_level == SOL_UDP && header->cmsg_type == UDP_GRO ) {
+            int segmentSize;
+            std::memcpy(&segmentSize, CMSG_DATA(header), sizeof(segmentSize));
+            packet.segmentSize = static_cast<uint16_t>(segmentSize);
+        }
+    }
+
+    // shrinking, or growing into the reserved capacity, so this does not allocate
     packet.data.resize(received);
-    return packet;
+    if ( static_cast<size_t>(received) > initialised ) {
+        std::memcpy(packet.data.data() + initialised, staging.data(), received - initialised);
+    }
+    packet.endpoint = Endpoint(addr, message.msg_namelen);
+    return static_cast<size_t>(received);
+}
+
+void Socket::enableSenderCache(size_t capacity) {
+    if ( capacity == 0 ) {
+        mSenderCache.reset();
+    } else {
+        mSenderCache = std::make_unique<EndpointCache>(capacity);
+    }
+}
+
+std::shared_ptr<Endpoint> Socket::sender(const UDPPacket& packet) {
+    if ( mSenderCache ) {
+        return mSenderCache->intern(packet.endpoint);
+    }
+
+    if ( !packet.endpoint.isSpecified() ) {
+        throw InvalidAddressException("Packet has no sender");
+    }
+    return std::make_shared<Endpoint>(packet.endpoint);
+}
+
+ssize_t Socket::recv_from(PooledPacket& packet) const {
+    if(mProtocol != SocketType::UDP) {
+        throw SocketException("Cannot recv_from from a TCP socket");
+    }
+
+    if(!packet) {
+        throw SocketException("Cannot receive into an empty PooledPacket");
+    }
+
+    std::span<char> buffer = packet.buffer();
+    PooledPacket::Slot& slot = *packet.mSlot;
+    slot.addressSize = sizeof(slot.address);
+    ssize_t received = ::recvfrom(
+        mNativeSocket,
+        buffer.data(),
+        buffer.size(),
+        MSG_TRUNC,  // report the full size, so a truncated datagram is noticed
+        reinterpret_cast<sockaddr*>(&slot.address),
+        &slot.addressSize
+    );
+    if ( received == -1 ) {
+        slot.addressSize = 0;
+        throw RecvError(errno, "Failed to receive");
+    }
+    if ( static_cast<size_t>(received) > buffer.size() ) {
+        slot.size = 0;
+        slot.addressSize = 0;
+        throw RecvError(EMSGSIZE, "Received datagram is larger than the packet");
+    }
+
+    slot.size = received;
+    return received;
+}
+
+size_t Socket::recvBatch(PacketBatch& batch) const {
+    if(mProtocol != SocketType::UDP) {
+        throw SocketException("Cannot recvBatch from a TCP socket");
+    }
+
+    batch.prepareRecv();
+    int received;
+    do {
+        received = ::recvmmsg(mNativeSocket, batch.mMessages.data(), batch.capacity(), MSG_WAITFORONE, nullptr);
+    } while ( received == -1 && errno == EINTR );
+
+    if ( received == -1 ) {
+        if ( errno == EAGAIN || errno == EWOULDBLOCK ) {
+            return 0;
+        }
+        throw RecvError(errno, "Failed to receive");
+    }
+
+    batch.finishRecv(received);
+    return received;
+}
+
+size_t Socket::sendBatch(const PacketBatch& batch) const {
+    if(mProtocol != SocketType::UDP) {
+        throw SocketException("Cannot sendBatch from a TCP socket");
+    }
+
+    IOResult<size_t> sent = try_sendBatch(batch);
+    if ( !sent ) {
+        if ( sent.wouldBlock() ) {
+            return 0;
+        }
+        throw SendError(sent.error().value(), "Failed to send");
+    }
+    return sent.value();
+}
+
+IOResult<size_t> Socket::try_sendBatch(const PacketBatch& batch) const noexcept {
+    if(mProtocol != SocketType::UDP) {
+        return IOResult<size_t>::fromErrno(EINVAL);
+    }
+
+    size_t totalSent = 0;
+    while ( totalSent < batch.size() ) {
+        int sent = ::sendmmsg(mNativeSocket, batch.mMessages.data() + totalSent, batch.size() - totalSent, 0);
+        if ( sent == -1 ) {
+            if ( errno == EINTR ) {
+                continue;
+            }
+            // like sendmmsg itself, report the progress and leave the error to the next call
+            if ( totalSent > 0 ) {
+                break;
+            }
+            return IOResult<size_t>::fromErrno(errno);
+        }
+        totalSent += sent;
+    }
+    return totalSent;
+}
+
+AsyncAccept Socket::asyncAccept() {
+    if ( !isConnectionOriented() ) {
+        throw SocketException("Cannot accept on a UDP socket");
+    }
+
+    if( mState != SocketState::Listening ) {
+        throw SocketException("Cannot accept without listening");
+    }
+
+    if ( !mNonBlocking ) {
+        enableNonBlocking(true);
+    }
+    return AsyncAccept(*this);
+}
+
+AsyncConnect Socket::asyncConnect(const Endpoint& endpoint) {
+    if ( !isConnectionOriented() ) {
+        throw SocketException("Cannot connect a UDP socket");
+    }
+
+    if ( !mNonBlocking ) {
+        enableNonBlocking(true);
+    }
+    return AsyncConnect(*this, endpoint);
+}
+
+AsyncConnect Socket::asyncConnect(std::shared_ptr<Endpoint> endpoint) {
+    return asyncConnect(*endpoint);
+}
+
+AsyncRecv Socket::asyncRecv(std::span<std::byte> buffer) {
+    return AsyncRecv(*this, buffer);
+}
+
+AsyncSend Socket::asyncSend(std::span<const std::byte> data) {
+    return AsyncSend(*this, data);
+}
+
+AsyncRecvFrom Socket::asyncRecvFrom(UDPPacket& packet) {
+    if(mProtocol != SocketType::UDP) {
+        throw SocketException("Cannot recv_from from a TCP socket");
+    }
+    return AsyncRecvFrom(*this, packet);
 }
 
 
@@ -270,8 +1336,8 @@ ssize_t Socket::operator<<(const std::vector<char>& data) const {
     return send(data);
 }
 
-ssize_t Socket::operator<<(const std::string& data) const {
-    return send(std::vector<char>(data.begin(), data.end()));
+ssize_t Socket::operator<<(std::string_view data) const {
+    return send(data);
 }
 
 ssize_t Socket::operator>>(std::vector<char>& buffer) const {
@@ -279,17 +1345,22 @@ ssize_t Socket::operator>>(std::vector<char>& buffer) const {
 }
 
 ssize_t Socket::operator>>(std::string& buffer) const {
-    std::vector<char> vec;
-    ssize_t received = recv(vec);
-    buffer = std::string(vec.begin(), vec.end());
-    return received;
+    return recv(buffer);
 }
 
 ssize_t Socket::operator>>(std::stringstream& stream) const {
-    std::vector<char> vec;
-    ssize_t received = recv(vec);
-    stream.write(vec.data(), received);
-    return received;
+    char chunk[1024];
+    ssize_t totalReceived = 0;
+    while(true) {
+        ssize_t received = recv(std::as_writable_bytes(std::span(chunk)));
+        stream.write(chunk, received);
+        totalReceived += received;
+
+        if(received < static_cast<ssize_t>(sizeof(chunk))) {
+            break;
+        }
+    }
+    return totalReceived;
 }
 
 }   // namespace SocketSparrow
\ No newline at end of file
@@ -11,6 +11,8 @@ namespace SocketSparrow::Util {
 constexpr std::pair<AddressFamily, const char*> addressFamilyMapping[] = {
     {AddressFamily::IPv4, "AF_INET"},
     {AddressFamily::IPv6, "AF_INET6"},
+    {AddressFamily::Unix, "AF_UNIX"},
+    {AddressFamily::Unix, "AF_LOCAL"},
     {AddressFamily::Unknown, "AF_UNSPEC"}
 };
 
@@ -23,6 +25,8 @@ constexpr std::pair<SocketType, const char*> socketTypeMapping[] = {
     {SocketType::TCP, "SOCK_STREAM"},
     {SocketType::UDP, "UDP"},
     {SocketType::UDP, "SOCK_DGRAM"},
+    {SocketType::SeqPacket, "SeqPacket"},
+    {SocketType::SeqPacket, "SOCK_SEQPACKET"},
     {SocketType::Unknown, "SOCK_RAW"},
     {SocketType::Unknown, "Unknown"}
 };
@@ -53,6 +57,7 @@ AddressFamily getAddressFamily(int nativeFamily) {
     switch (nativeFamily){
         case AF_INET:
         case AF_INET6:
+        case AF_UNIX:
         case AF_UNSPEC:
             return static_cast<AddressFamily>(nativeFamily);
         default:
@@ -78,6 +83,7 @@ SocketType getSocketType(int nativeType) {
     switch (nativeType){
         case SOCK_STREAM:
         case SOCK_DGRAM:
+        case SOCK_SEQPACKET:
         case SOCK_RAW:
             return static_cast<SocketType>(nativeType);
         default:
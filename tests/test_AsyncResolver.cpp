@@ -0,0 +1,235 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "AsyncResolver.hpp"
+#include "Exceptions.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include <poll.h>
+
+using namespace SocketSparrow;
+
+namespace {
+
+/**
+ * @brief Minimal DNS server answering "example.test" and "v6.test", everything else is NXDOMAIN
+ */
+class StandInResponder {
+private:
+    Socket mSocket;
+    std::atomic<bool> mRunning = true;
+    std::atomic<int> mQueries = 0;
+    std::thread mThread;
+
+    static void put16(std::vector<char>& out, uint16_t value) {
+        out.push_back(static_cast<char>(value >> 8));
+        out.push_back(static_cast<char>(value));
+    }
+
+    static void addRecord(std::vector<char>& out, uint16_t type, const std::vector<uint8_t>& data) {
+        put16(out, 0xc00c);     // pointer to the question name
+        put16(out, type);
+        put16(out, 1);
+        put16(out, 0);
+        put16(out, 60);         // ttl
+        put16(out, static_cast<uint16_t>(data.size()));
+        out.insert(out.end(), data.begin(), data.end());
+    }
+
+    void answer(const UDPPacket& query) {
+        mQueries++;
+        const std::vector<char>& in = query.data;
+        size_t nameEnd = 12;
+        std::string name;
+        while ( in[nameEnd] != 0 ) {
+            uint8_t length = static_cast<uint8_t>(in[nameEnd]);
+            if ( !name.empty() ) name += '.';
+            name.append(&in[nameEnd + 1], length);
+            nameEnd += length + 1;
+        }
+        uint16_t type = static_cast<uint16_t>(static_cast<uint8_t>(in[nameEnd + 1]) << 8 | static_cast<uint8_t>(in[nameEnd + 2]));
+        size_t questionEnd = nameEnd + 5;
+
+        std::vector<char> out(in.begin(), in.begin() + questionEnd);
+        std::vector<std::vector<uint8_t>> records;
+        if ( name == "example.test" && type == 1 ) {
+            records = { { 10, 0, 0, 1 }, { 10, 0, 0, 2 } };
+        } else if ( (name == "example.test" || name == "v6.test") && type == 28 ) {
+            records = { { 0xfd, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 } };
+        }
+
+        bool exists = name == "example.test" || name == "v6.test";
+        out[2] = static_cast<char>(0x81);
+        out[3] = static_cast<char>(exists ? 0x80 : 0x83);
+        out[6] = 0;
+        out[7] = static_cast<char>(records.size());
+        for ( const auto& record : records ) {
+            addRecord(out, type, record);
+        }
+        mSocket.send_to(UDPPacket(out, query.endpoint));
+    }
+
+public:
+    explicit StandInResponder(uint16_t port)
+        : mSocket(AddressFamily::IPv4, SocketType::UDP) {
+        mSocket.enableAddressReuse(true);
+        mSocket.bind(Endpoint("127.0.0.1", port));
+        mThread = std::thread([this] {
+            UDPPacket packet(512);
+            while ( mRunning ) {
+                pollfd descriptor = { mSocket.getNativeHandle(), POLLIN, 0 };
+                if ( ::poll(&descriptor, 1, 10) > 0 ) {
+                    mSocket.recv_from(packet);
+                    answer(packet);
+                }
+            }
+        });
+    }
+
+    ~StandInResponder() {
+        mRunning = false;
+        mThread.join();
+    }
+
+    int queries() const {
+        return mQueries;
+    }
+};
+
+struct Result {
+    bool done = false;
+    ResolveStatus status;
+    std::vector<Endpoint> endpoints;
+};
+
+AsyncResolver::Callback capture(Result& result) {
+    return [&result](ResolveStatus status, const std::vector<Endpoint>& endpoints) {
+        result.done = true;
+        result.status = status;
+        result.endpoints = endpoints;
+    };
+}
+
+void wait(AsyncResolver& resolver, const Result& result) {
+    for ( int i = 0; i < 200 && !result.done; i++ ) {
+        resolver.poll(10);
+    }
+}
+
+} // namespace
+
+TEST_CASE("AsyncResolver Lookups", "[AsyncResolver]") {
+    StandInResponder responder(7771);
+    AsyncResolver resolver(Endpoint("127.0.0.1", 7771));
+
+    SECTION("All A and AAAA records") {
+        Result result;
+        resolver.resolve("Example.Test", 443, capture(result));
+        CHECK(resolver.pending() == 2);
+        wait(resolver, result);
+
+        REQUIRE(result.done);
+        CHECK(result.status == ResolveStatus::Success);
+        REQUIRE(result.endpoints.size() == 3);
+        CHECK(result.endpoints[0].toString() == "10.0.0.1:443");
+        CHECK(result.endpoints[1].toString() == "10.0.0.2:443");
+        CHECK(result.endpoints[2].toString() == "[fd00::1]:443");
+        CHECK(responder.queries() == 2);
+
+        // answered from the cache, right away and without a query
+        Result cached;
+        resolver.resolve("example.test", 80, capture(cached), AddressFamily::IPv4);
+        REQUIRE(cached.done);
+        CHECK(cached.endpoints.size() == 2);
+        CHECK(cached.endpoints[0].getPort() == 80);
+        CHECK(responder.queries() == 2);
+        CHECK(resolver.cached("example.test", 80)->size() == 3);
+    }
+
+    SECTION("Family without records") {
+        Result result;
+        resolver.resolve("v6.test", 80, capture(result), AddressFamily::IPv4);
+        wait(resolver, result);
+        REQUIRE(result.done);
+        CHECK(result.status == ResolveStatus::NotFound);
+        CHECK(result.endpoints.empty());
+    }
+
+    SECTION("Negative caching") {
+        Result result;
+        resolver.resolve("missing.test", 80, capture(result), AddressFamily::IPv4);
+        wait(resolver, result);
+        REQUIRE(result.done);
+        CHECK(result.status == ResolveStatus::NotFound);
+
+        Result again;
+        resolver.resolve("missing.test", 80, capture(again), AddressFamily::IPv4);
+        REQUIRE(again.done);
+        CHECK(again.status == ResolveStatus::NotFound);
+        CHECK(responder.queries() == 1);
+
+        resolver.clearCache();
+        CHECK_FALSE(resolver.cached("missing.test", 80, AddressFamily::IPv4));
+    }
+
+    SECTION("Literals and invalid names") {
+        Result result;
+        resolver.resolve("::1", 53, capture(result));
+        REQUIRE(result.done);
+        CHECK(result.endpoints.at(0).toString() == "[::1]:53");
+
+        CHECK_THROWS_AS(resolver.resolve("bad..name", 80, capture(result)), InvalidAddressException);
+        CHECK(responder.queries() == 0);
+    }
+
+    SECTION("Reactor") {
+        Reactor reactor;
+        resolver.attach(reactor);
+
+        Result result;
+        resolver.resolve("example.test", 80, capture(result), AddressFamily::IPv6);
+        for ( int i = 0; i < 200 && !result.done; i++ ) {
+            reactor.poll(10);
+        }
+        REQUIRE(result.done);
+        CHECK(result.endpoints.size() == 1);
+
+        resolver.detach();
+        CHECK(reactor.size() == 0);
+    }
+}
+
+TEST_CASE("AsyncResolver Timeout", "[AsyncResolver]") {
+    AsyncResolver::Options options;
+    options.timeout = std::chrono::milliseconds(20);
+    options.attempts = 2;
+    AsyncResolver resolver(Endpoint("127.0.0.1", 7772), options);
+
+    // a server that never answers, it only records the query ids
+    Socket silent(AddressFamily::IPv4, SocketType::UDP);
+    silent.enableAddressReuse(true);
+    silent.bind(Endpoint("127.0.0.1", 7772));
+
+    Result result;
+    resolver.resolve("example.test", 80, capture(result), AddressFamily::IPv4);
+    CHECK(resolver.nextTimeout() <= 20);
+    wait(resolver, result);
+
+    REQUIRE(result.done);
+    CHECK(result.status == ResolveStatus::Timeout);
+
+    std::vector<uint16_t> ids;
+    silent.enableNonBlocking(true);
+    UDPPacket packet(512);
+    while ( silent.try_recv(std::as_writable_bytes(std::span(packet.data))) ) {
+        ids.push_back(static_cast<uint16_t>(static_cast<uint8_t>(packet.data[0]) << 8 | static_cast<uint8_t>(packet.data[1])));
+    }
+    REQUIRE(ids.size() == 2);
+    CHECK(ids[0] != ids[1]);
+    CHECK(resolver.pending() == 0);
+    CHECK(resolver.nextTimeout() == -1);
+    CHECK_FALSE(resolver.cached("example.test", 80, AddressFamily::IPv4));
+}
@@ -0,0 +1,126 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "BasicSocket.hpp"
+#include "Exceptions.hpp"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+
+using namespace SocketSparrow;
+
+namespace {
+
+template<typename S>
+concept CanListen = requires(S socket) { socket.listen(1); };
+
+template<typename S>
+concept CanAccept = requires(S socket) { socket.accept(); };
+
+template<typename S>
+concept CanSendTo = requires(S socket, Endpoint endpoint) { socket.send_to(std::string_view(), endpoint); };
+
+template<typename S>
+concept CanSetV6Only = requires(S socket) { socket.enableV6Only(); };
+
+std::string text(std::span<const std::byte> data) {
+    return std::string(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+} // namespace
+
+TEST_CASE("BasicSocket Compile-Time Checks", "[BasicSocket]") {
+    CHECK(CanListen<TcpV4Socket>);
+    CHECK(CanAccept<TcpV6Socket>);
+    CHECK_FALSE(CanListen<UdpV4Socket>);
+    CHECK_FALSE(CanAccept<UdpV6Socket>);
+    CHECK(CanSendTo<UdpV4Socket>);
+    CHECK_FALSE(CanSendTo<TcpV4Socket>);
+    CHECK(CanSetV6Only<UdpV6Socket>);
+    CHECK_FALSE(CanSetV6Only<TcpV4Socket>);
+
+    CHECK(TcpV4Socket::addressSize == sizeof(sockaddr_in));
+    CHECK(UdpV6Socket::addressSize == sizeof(sockaddr_in6));
+    CHECK(TcpV4Socket::isTcp);
+    CHECK(UdpV6Socket::isUdp);
+}
+
+TEST_CASE("BasicSocket TCP", "[BasicSocket]") {
+    TcpV4Socket listener;
+    listener.enableAddressReuse();
+    listener.bind(Endpoint("127.0.0.1", 7783));
+    listener.listen(4);
+    listener.enableNonBlocking();
+
+    IOResult<TcpV4Socket> none = listener.try_accept();
+    CHECK(none.wouldBlock());
+
+    TcpV4Socket client;
+    client.connect(Endpoint("127.0.0.1", 7783));
+    client.enableNoDelay();
+
+    listener.enableNonBlocking(false);
+    Endpoint peer;
+    TcpV4Socket server = listener.accept(peer);
+    CHECK(peer.toString().starts_with("127.0.0.1:"));
+    CHECK((fcntl(server.getNativeHandle(), F_GETFD) & FD_CLOEXEC) != 0);
+
+    CHECK(client.send(std::string_view("ping")) == 4);
+    std::byte buffer[16];
+    CHECK(server.recv(buffer) == 4);
+    CHECK(text(std::span(buffer, 4)) == "ping");
+
+    server.enableNonBlocking();
+    IOResult<size_t> empty = server.try_recv(buffer);
+    CHECK(empty.wouldBlock());
+
+    IOResult<size_t> sent = server.try_send(std::as_bytes(std::span("pong", 4)));
+    REQUIRE(sent.ok());
+    CHECK(*sent == 4);
+    CHECK(client.recv(buffer) == 4);
+    CHECK(text(std::span(buffer, 4)) == "pong");
+
+    SECTION("Moving transfers ownership") {
+        const int fd = server.getNativeHandle();
+        TcpV4Socket moved = std::move(server);
+        CHECK(moved.getNativeHandle() == fd);
+        CHECK(server.getNativeHandle() == -1);
+    }
+
+    SECTION("Conversion into a Socket") {
+        const int fd = server.getNativeHandle();
+        Socket socket = std::move(server).toSocket();
+        CHECK(server.getNativeHandle() == -1);
+        CHECK(socket.getNativeHandle() == fd);
+        CHECK(socket.getState() == SocketState::Connected);
+        CHECK(socket.isNonBlocking());
+    }
+
+    SECTION("Endpoints of another Address Family are rejected") {
+        TcpV6Socket v6;
+        CHECK_THROWS_AS(v6.connect(Endpoint("127.0.0.1", 7783)), SocketException);
+    }
+}
+
+TEST_CASE("BasicSocket UDP", "[BasicSocket]") {
+    UdpV4Socket server;
+    UdpV4Socket client;
+    server.enableAddressReuse();
+    server.bind(Endpoint("127.0.0.1", 7784));
+
+    CHECK(client.send_to(std::string_view("datagram"), Endpoint("127.0.0.1", 7784)) == 8);
+
+    std::byte buffer[64];
+    Endpoint sender;
+    CHECK(server.recv_from(buffer, sender) == 8);
+    CHECK(text(std::span(buffer, 8)) == "datagram");
+    CHECK(sender.toString().starts_with("127.0.0.1:"));
+
+    server.connect(sender);
+    CHECK(server.send(std::string_view("reply")) == 5);
+    CHECK(client.recv(buffer) == 5);
+    CHECK(text(std::span(buffer, 5)) == "reply");
+}
@@ -0,0 +1,116 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "BufferedSocket.hpp"
+#include "Exceptions.hpp"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <sys/socket.h>
+
+using namespace SocketSparrow;
+
+TEST_CASE("BufferedSocket Reader and Writer", "[BufferedSocket]") {
+    Socket listener(AddressFamily::IPv4, SocketType::TCP);
+    listener.enableAddressReuse(true);
+    listener.bind(Endpoint("127.0.0.1", 7778));
+    listener.listen(1);
+
+    Socket client(AddressFamily::IPv4, SocketType::TCP);
+    client.connect(Endpoint("127.0.0.1", 7778));
+    auto server = listener.accept();
+
+    SECTION("Coalesced records") {
+        BufferedSocketWriter writer(client, 4096);
+        for ( int i = 0; i < 100; i++ ) {
+            writer << "record " << std::to_string(i) << "\r\n";
+        }
+        CHECK(writer.buffered() > 0);
+        writer.flush();
+        CHECK(writer.buffered() == 0);
+
+        BufferedSocketReader reader(*server, 4096);
+        for ( int i = 0; i < 100; i++ ) {
+            auto record = reader.readUntil("\r\n");
+            REQUIRE(record);
+            CHECK(*record == "record " + std::to_string(i));
+        }
+        CHECK(reader.buffered() == 0);
+    }
+
+    SECTION("Peek and readExact") {
+        std::string large(100000, '\0');
+        for ( size_t i = 0; i < large.size(); i++ ) {
+            large[i] = static_cast<char>('a' + i % 26);
+        }
+
+        std::thread sender([&] {
+            BufferedSocketWriter writer(client, 4096);
+            writer << "HEAD";
+            writer << large;    // larger than the buffer, sent directly after the header
+        });
+
+        BufferedSocketReader reader(*server, 4096);
+        auto header = reader.peek(4);
+        REQUIRE(header.size() == 4);
+        CHECK(std::string(reinterpret_cast<const char*>(header.data()), 4) == "HEAD");
+        reader.consume(4);
+
+        std::string body(large.size(), '\0');
+        CHECK(reader.readExact(std::as_writable_bytes(std::span(body))) == large.size());
+        CHECK(body == large);
+        sender.join();
+
+        CHECK_THROWS_MATCHES(
+            reader.peek(reader.buffered() + 1024 * 1024),
+            SocketException,
+            Catch::Matchers::Message("Cannot peek beyond the BufferedSocketReader capacity")
+        );
+    }
+
+    SECTION("Non-blocking readExact") {
+        server->enableNonBlocking(true);
+        BufferedSocketReader reader(*server, 4096);
+
+        // a short read keeps what arrived
+        REQUIRE(client.send(std::string_view("abcd")) == 4);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::string record(8, '\0');
+        CHECK_THROWS_AS(reader.readExact(std::as_writable_bytes(std::span(record))), RecvError);
+        CHECK(reader.buffered() == 4);
+
+        REQUIRE(client.send(std::string_view("efgh")) == 4);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        CHECK(reader.readExact(std::as_writable_bytes(std::span(record))) == 8);
+        CHECK(record == "abcdefgh");
+        CHECK(reader.buffered() == 0);
+
+        // beyond the capacity the bytes received directly are handed out
+        REQUIRE(client.send(std::string_view("ijkl")) == 4);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        REQUIRE(reader.peek(4).size() == 4);
+        std::string large(8192, '\0');
+        CHECK_THROWS_AS(reader.readExact(std::as_writable_bytes(std::span(large))), RecvError);
+        CHECK(reader.buffered() == 4);
+
+        REQUIRE(client.send(std::string_view("mnop")) == 4);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        CHECK(reader.readExact(std::as_writable_bytes(std::span(large))) == 8);
+        CHECK(large.substr(0, 8) == "ijklmnop");
+        CHECK(reader.buffered() == 0);
+    }
+
+    SECTION("End of stream") {
+        {
+            BufferedSocketWriter writer(client);
+            writer << "partial";
+        }
+        shutdown(client.getNativeHandle(), SHUT_WR);
+
+        BufferedSocketReader reader(*server);
+        CHECK_FALSE(reader.readUntil("\n"));
+        CHECK(reader.peek(100).size() == 7);
+    }
+}
@@ -6,7 +6,11 @@
 
 #include "Exceptions.hpp"
 #include "Util.hpp"
+#include <cstddef>
 #include <cstring>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
 
 using namespace SocketSparrow;
 
@@ -70,6 +74,13 @@ TEST_CASE("Endpoint Creation", "[Endpoint]") {
         sockaddr_storage addr = {};
         socklen_t size = sizeof(addr);
         CHECK_THROWS_AS(Endpoint(addr, size), InvalidAddressException);
+
+        // truncated IP addresses
+        addr.ss_family = AF_INET;
+        CHECK_THROWS_AS(Endpoint(addr, sizeof(sockaddr_in) - 1), InvalidAddressException);
+        addr.ss_family = AF_INET6;
+        CHECK_THROWS_AS(Endpoint(addr, sizeof(sockaddr_in)), InvalidAddressException);
+        CHECK_NOTHROW(Endpoint(addr, sizeof(sockaddr_in6)));
     }
 
     SECTION("Endpoint Creation with ip and port") {
@@ -135,7 +146,7 @@ TEST_CASE("Endpoint Creation", "[Endpoint]") {
         Endpoint endpoint6((sockaddr*)&addr6, size);
         CHECK(endpoint6.c_size() == size);
 
-        endpoint6.mAddressFamily = AddressFamily::Unknown;
+        endpoint6.mSockaddr.base.sa_family = AF_UNSPEC;
         CHECK_THROWS_AS(endpoint6.c_size(), InvalidAddressFamilyException);
         
     }
@@ -155,4 +166,113 @@ TEST_CASE("Endpoint Creation", "[Endpoint]") {
         CHECK(addr->sin_port == htons(8080));
     }
 
-}
\ No newline at end of file
+}
+TEST_CASE("Endpoint Value Semantics", "[Endpoint]") {
+    CHECK(std::is_trivially_copyable_v<Endpoint>);
+
+    Endpoint a("127.0.0.1", 8080);
+    Endpoint b = a;
+    Endpoint c("127.0.0.1", 8081);
+    Endpoint d("127.0.0.2", 80);
+
+    SECTION("Comparison") {
+        CHECK(a == b);
+        CHECK(a != c);
+        CHECK(a < c);
+        CHECK(c < d);
+        CHECK(Endpoint() == Endpoint());
+        CHECK(Endpoint() < a);
+    }
+
+    SECTION("Hashing") {
+        CHECK(std::hash<Endpoint>{}(a) == std::hash<Endpoint>{}(b));
+        CHECK(std::hash<Endpoint>{}(a) != std::hash<Endpoint>{}(c));
+
+        std::unordered_map<Endpoint, int> peers;
+        peers[a] = 1;
+        peers[c] = 2;
+        CHECK(peers[b] == 1);
+        CHECK(peers.size() == 2);
+    }
+
+    SECTION("Equal Endpoints built over dirty memory") {
+        alignas(Endpoint) unsigned char first[sizeof(Endpoint)];
+        alignas(Endpoint) unsigned char second[sizeof(Endpoint)];
+        std::memset(first, 0xab, sizeof(first));
+        std::memset(second, 0xcd, sizeof(second));
+
+        Endpoint* x = new (first) Endpoint(AddressFamily::IPv6, 80);
+        Endpoint* y = new (second) Endpoint(AddressFamily::IPv6, 80);
+        CHECK(*x == *y);
+        CHECK(std::hash<Endpoint>{}(*x) == std::hash<Endpoint>{}(*y));
+
+        x = new (first) Endpoint("::1", 80, AddressFamily::IPv6);
+        std::memset(second, 0xcd, sizeof(second));
+        y = new (second) Endpoint("0:0::1", 80, AddressFamily::IPv6);
+        CHECK(*x == *y);
+        CHECK(std::hash<Endpoint>{}(*x) == std::hash<Endpoint>{}(*y));
+    }
+
+    SECTION("toString") {
+        CHECK(a.toString() == "127.0.0.1:8080");
+        CHECK(Endpoint(AddressFamily::IPv4, 0).toString() == "0.0.0.0:0");
+        CHECK(Endpoint(AddressFamily::IPv6, 65535).toString() == "[::]:65535");
+        CHECK(Endpoint().toString() == "unspecified");
+    }
+}
+
+TEST_CASE("Endpoint Unix Domain", "[Endpoint]") {
+    SECTION("Filesystem paths") {
+        Endpoint endpoint = Endpoint::unixPath("/tmp/sparrow.sock");
+        CHECK(endpoint.getAddressFamily() == AddressFamily::Unix);
+        CHECK(endpoint.getPath() == "/tmp/sparrow.sock");
+        CHECK_FALSE(endpoint.isAbstract());
+        CHECK(endpoint.getPort() == 0);
+        CHECK(endpoint.toString() == "/tmp/sparrow.sock");
+        CHECK(endpoint.c_size() == offsetof(sockaddr_un, sun_path) + 18);
+        CHECK(endpoint.c_addr()->sa_family == AF_UNIX);
+
+        CHECK_THROWS_AS(Endpoint::unixPath(""), InvalidAddressException);
+        CHECK_THROWS_AS(Endpoint::unixPath(std::string(200, 'a')), InvalidAddressException);
+        CHECK_THROWS_AS(Endpoint::unixPath(std::string("a\0b", 3)), InvalidAddressException);
+    }
+
+    SECTION("Abstract names") {
+        Endpoint endpoint = Endpoint::unixAbstract("sparrow");
+        CHECK(endpoint.isAbstract());
+        CHECK(endpoint.getPath() == "sparrow");
+        CHECK(endpoint.toString() == "@sparrow");
+        CHECK(endpoint.c_size() == offsetof(sockaddr_un, sun_path) + 8);
+        CHECK_THROWS_AS(Endpoint::unixAbstract(std::string(200, 'a')), InvalidAddressException);
+    }
+
+    SECTION("From sockaddr") {
+        sockaddr_storage storage = {};
+        memcpy(&storage, Endpoint::unixAbstract("x").c_addr(), Endpoint::unixAbstract("x").c_size());
+        CHECK(Endpoint(storage, offsetof(sockaddr_un, sun_path) + 2) == Endpoint::unixAbstract("x"));
+
+        // unnamed sockets (e.g. the peer of a connecting client) have an empty path
+        Endpoint unnamed(storage, offsetof(sockaddr_un, sun_path));
+        CHECK(unnamed.getAddressFamily() == AddressFamily::Unix);
+        CHECK(unnamed.toString() == "unnamed");
+
+        CHECK_FALSE(Endpoint(storage, 0).isSpecified());
+        CHECK_THROWS_AS(Endpoint(reinterpret_cast<sockaddr*>(&storage), 1), InvalidAddressException);
+    }
+
+    SECTION("Comparison and hashing") {
+        Endpoint path = Endpoint::unixPath("sparrow");
+        Endpoint abstract = Endpoint::unixAbstract("sparrow");
+        CHECK(path == Endpoint::unixPath("sparrow"));
+        CHECK(path != abstract);
+        CHECK(path != Endpoint::unixPath("sparrow2"));
+        CHECK(path != Endpoint(AddressFamily::IPv4, 0));
+        CHECK(std::hash<Endpoint>{}(path) == std::hash<Endpoint>{}(Endpoint::unixPath("sparrow")));
+
+        std::unordered_map<Endpoint, int> peers;
+        peers[path] = 1;
+        peers[abstract] = 2;
+        CHECK(peers.size() == 2);
+        CHECK(peers[Endpoint::unixAbstract("sparrow")] == 2);
+    }
+}
@@ -0,0 +1,44 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "EndpointCache.hpp"
+#include "Exceptions.hpp"
+
+using namespace SocketSparrow;
+
+TEST_CASE("EndpointCache Interning", "[EndpointCache]") {
+    EndpointCache cache(2);
+    CHECK(cache.capacity() == 2);
+    CHECK(cache.size() == 0);
+
+    Endpoint first("127.0.0.1", 1000);
+    Endpoint second("127.0.0.1", 2000);
+    Endpoint third("127.0.0.1", 3000);
+
+    auto shared = cache.intern(first);
+    CHECK(shared->getPort() == 1000);
+    CHECK(cache.intern(Endpoint("127.0.0.1", 1000)) == shared);
+    CHECK(cache.intern(second) != shared);
+    CHECK(cache.size() == 2);
+
+    SECTION("Least recently used Endpoint is replaced") {
+        cache.intern(first);
+        auto replacing = cache.intern(third);
+        CHECK(cache.size() == 2);
+        CHECK(cache.intern(first) == shared);
+        CHECK(cache.intern(third) == replacing);
+    }
+
+    SECTION("Clear") {
+        cache.clear();
+        CHECK(cache.size() == 0);
+        CHECK(cache.intern(first) != shared);
+    }
+
+    CHECK_THROWS_MATCHES(
+        cache.intern(Endpoint()),
+        InvalidAddressException,
+        Catch::Matchers::Message("Cannot cache an unspecified Endpoint")
+    );
+    CHECK_THROWS_AS(EndpointCache(0), SocketException);
+}
@@ -2,6 +2,8 @@
 #include "catch2/matchers/catch_matchers_all.hpp"
 #include "Exceptions.hpp"
 
+#include <cerrno>
+
 using namespace SocketSparrow;
 
 TEST_CASE("Exception Classes", "[Exceptions]") {
@@ -113,6 +115,11 @@ TEST_CASE("Exception Classes", "[Exceptions]") {
         CHECK_THROWS_AS([] { throw SocketException(1); }(), SocketSparrowException);
         CHECK_THROWS_AS([] { throw SocketException("Custom Message"); }(), SocketSparrowException);
         CHECK_THROWS_AS([] { throw SocketException(1, "Custom Message"); }(), SocketSparrowException);
+
+        CHECK(SocketException().getErrorCode() == 0);
+        CHECK(SocketException("Custom Message").getErrorCode() == 0);
+        CHECK(SocketException(EMFILE, "Custom Message").getErrorCode() == EMFILE);
+        CHECK(RecvError(EAGAIN).getErrorCode() == EAGAIN);
     }
 
     SECTION("SendError") {
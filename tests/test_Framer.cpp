@@ -0,0 +1,165 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "Framer.hpp"
+#include "Exceptions.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+
+using namespace SocketSparrow;
+
+namespace {
+
+std::vector<std::byte> bytes(std::initializer_list<int> values) {
+    std::vector<std::byte> result;
+    for ( int value : values ) {
+        result.push_back(static_cast<std::byte>(value));
+    }
+    return result;
+}
+
+std::string text(std::span<const std::byte> data) {
+    return std::string(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+} // namespace
+
+TEST_CASE("Framer Length Prefixes", "[Framer]") {
+    SECTION("U16 big endian") {
+        Framer framer = Framer::lengthPrefixed(LengthPrefix::U16);
+        auto data = bytes({ 0, 3, 'a', 'b', 'c', 0, 1 });
+        CHECK_FALSE(framer.decode(std::span(data).first(1)));
+        CHECK_FALSE(framer.decode(std::span(data).first(4)));
+
+        auto frame = framer.decode(data);
+        REQUIRE(frame);
+        CHECK(text(frame->payload) == "abc");
+        CHECK(frame->size == 5);
+        CHECK(frame->payload.data() == data.data() + 2);
+        CHECK_FALSE(framer.decode(std::span(data).subspan(5)));
+    }
+
+    SECTION("U32 little endian") {
+        Framer framer = Framer::lengthPrefixed(LengthPrefix::U32, ByteOrder::LittleEndian);
+        auto data = bytes({ 2, 0, 0, 0, 'h', 'i' });
+        auto frame = framer.decode(data);
+        REQUIRE(frame);
+        CHECK(text(frame->payload) == "hi");
+    }
+
+    SECTION("Varint") {
+        Framer framer = Framer::lengthPrefixed(LengthPrefix::Varint);
+        std::vector<std::byte> data = bytes({ 0xac, 0x02 });
+        data.resize(2 + 300, std::byte{ 'x' });
+        auto frame = framer.decode(data);
+        REQUIRE(frame);
+        CHECK(frame->payload.size() == 300);
+        CHECK(frame->size == 302);
+
+        auto malformed = bytes({ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01 });
+        CHECK_THROWS_MATCHES(
+            framer.decode(malformed),
+            SocketException,
+            Catch::Matchers::Message("Malformed varint length prefix")
+        );
+
+        // bits beyond 63 in the tenth byte would wrap the length to 5 and pass the size check
+        auto overlong = bytes({ 0x85, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x02 });
+        overlong.resize(overlong.size() + 5, std::byte{ 'x' });
+        CHECK_THROWS_MATCHES(
+            framer.decode(overlong),
+            SocketException,
+            Catch::Matchers::Message("Malformed varint length prefix")
+        );
+
+        // a continuation bit on the tenth byte must not make the prefix look incomplete
+        auto continued = bytes({ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81 });
+        CHECK_THROWS_MATCHES(
+            framer.decode(continued),
+            SocketException,
+            Catch::Matchers::Message("Malformed varint length prefix")
+        );
+
+        // bit 63 alone is a valid, if far too large, length
+        auto largest = bytes({ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01 });
+        CHECK_THROWS_MATCHES(
+            framer.decode(largest),
+            SocketException,
+            Catch::Matchers::Message("Frame exceeds the maximum frame size")
+        );
+    }
+
+    SECTION("Maximum frame size") {
+        Framer framer = Framer::lengthPrefixed(LengthPrefix::U16, ByteOrder::BigEndian, 100);
+        auto data = bytes({ 0, 101 });
+        CHECK_THROWS_MATCHES(
+            framer.decode(data),
+            SocketException,
+            Catch::Matchers::Message("Frame exceeds the maximum frame size")
+        );
+        CHECK(Framer::lengthPrefixed(LengthPrefix::U16).maxFrameSize() == 65535);
+    }
+}
+
+TEST_CASE("Framer Delimiters", "[Framer]") {
+    Framer framer = Framer::delimited("\r\n", 8);
+    std::string stream = "line one\r\nrest";
+    auto data = std::as_bytes(std::span(stream));
+
+    // the delimiter arrives split across two receives
+    CHECK_FALSE(framer.decode(data.first(9)));
+    auto frame = framer.decode(data);
+    REQUIRE(frame);
+    CHECK(text(frame->payload) == "line one");
+    CHECK(frame->size == 10);
+
+    std::string tooLong = "0123456789";
+    CHECK_THROWS_MATCHES(
+        framer.decode(std::as_bytes(std::span(tooLong))),
+        SocketException,
+        Catch::Matchers::Message("Frame exceeds the maximum frame size")
+    );
+    CHECK_THROWS_AS(Framer::delimited(""), SocketException);
+}
+
+TEST_CASE("Framer over a Socket", "[Framer]") {
+    Socket listener(AddressFamily::IPv4, SocketType::TCP);
+    listener.enableAddressReuse(true);
+    listener.bind(Endpoint("127.0.0.1", 7779));
+    listener.listen(1);
+
+    Socket client(AddressFamily::IPv4, SocketType::TCP);
+    client.connect(Endpoint("127.0.0.1", 7779));
+    auto server = listener.accept();
+
+    for ( Framer framer : { Framer::lengthPrefixed(LengthPrefix::Varint), Framer::delimited("\n") } ) {
+        std::thread writer([&] {
+            for ( int i = 0; i < 50; i++ ) {
+                std::string message = "message " + std::to_string(i);
+                framer.writeFrame(client, std::as_bytes(std::span(message)));
+            }
+        });
+
+        Framer decoder = framer;
+        BufferedSocketReader reader(*server, 4096);
+        for ( int i = 0; i < 50; i++ ) {
+            auto payload = decoder.readFrame(reader);
+            REQUIRE(payload);
+            CHECK(text(*payload) == "message " + std::to_string(i));
+        }
+        writer.join();
+    }
+
+    Framer framer = Framer::lengthPrefixed(LengthPrefix::U32);
+    std::string message = "partial";
+    framer.writeFrame(client, std::as_bytes(std::span(message)).first(3));
+    shutdown(client.getNativeHandle(), SHUT_WR);
+
+    BufferedSocketReader reader(*server, 4096);
+    REQUIRE(framer.readFrame(reader));
+    CHECK_FALSE(framer.readFrame(reader));
+}
@@ -0,0 +1,156 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "HotRestart.hpp"
+#include "Exceptions.hpp"
+
+#include <fstream>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace SocketSparrow;
+
+TEST_CASE("HotRestart Hand-Over", "[HotRestart]") {
+    const Endpoint control = Endpoint::unixAbstract("socketsparrow-test-hotrestart");
+    CHECK_THROWS_AS(HotRestart(Endpoint(AddressFamily::IPv4, 0)), SocketException);
+
+    Socket listener(AddressFamily::IPv4, SocketType::TCP);
+    listener.enableAddressReuse(true);
+    listener.bind(Endpoint("127.0.0.1", 7785));
+    listener.listen(8);
+
+    // a connection that arrives before the restart waits in the shared accept queue
+    Socket early(AddressFamily::IPv4, SocketType::TCP);
+    early.connect(Endpoint("127.0.0.1", 7785));
+
+    HotRestart old(control);
+    old.listen();
+    CHECK(old.controlSocket().getState() == SocketState::Listening);
+    auto handedOver = std::async(std::launch::async, [&] { return old.handOver({ listener }); });
+
+    HotRestart successor(control);
+    CHECK_THROWS_AS(successor.drain(), SocketException);
+    std::vector<InheritedListener> listeners = successor.inherit();
+    REQUIRE(listeners.size() == 1);
+    CHECK(listeners[0].endpoint == Endpoint("127.0.0.1", 7785));
+    CHECK(listeners[0].socket.getState() == SocketState::Listening);
+    CHECK(listeners[0].socket.getNativeHandle() != listener.getNativeHandle());
+
+    auto connection = listeners[0].socket.accept();
+    REQUIRE(early.send(std::string_view("hello")) == 5);
+    std::string received;
+    CHECK(connection->recv(received) == 5);
+    CHECK(received == "hello");
+
+    successor.drain();
+    CHECK(handedOver.get());
+}
+
+TEST_CASE("HotRestart survives a dying Successor", "[HotRestart]") {
+    const Endpoint control = Endpoint::unixAbstract("socketsparrow-test-dying");
+
+    Socket listener(AddressFamily::IPv4, SocketType::TCP);
+    listener.bind(Endpoint("127.0.0.1", 0));
+    listener.listen(1);
+
+    HotRestart old(control);
+    old.listen();
+
+    // the successor goes away before anything was sent, this must not raise SIGPIPE
+    {
+        Socket successor(AddressFamily::Unix, SocketType::SeqPacket);
+        successor.connect(control);
+    }
+    CHECK_THROWS_AS(old.handOver({ listener }), SendError);
+    CHECK(old.controlSocket().getState() == SocketState::Listening);
+}
+
+TEST_CASE("HotRestart rejects untrusted Users", "[HotRestart]") {
+    if ( geteuid() != 0 ) {
+        WARN("switching to another user needs root");
+        return;
+    }
+    const Endpoint control = Endpoint::unixAbstract("socketsparrow-test-untrusted");
+
+    Socket listener(AddressFamily::IPv4, SocketType::TCP);
+    listener.bind(Endpoint("127.0.0.1", 0));
+    listener.listen(1);
+
+    HotRestart old(control);
+    old.listen();
+    auto handedOver = std::async(std::launch::async, [&] { return old.handOver({ listener }); });
+
+    // an impostor running as nobody connects first, it must be turned away without descriptors
+    pid_t child = fork();
+    REQUIRE(child != -1);
+    if ( child == 0 ) {
+        if ( setresgid(65534, 65534, 65534) != 0 || setresuid(65534, 65534, 65534) != 0 ) {
+            _exit(2);
+        }
+        int fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+        if ( fd == -1 || connect(fd, control.c_addr(), control.c_size()) != 0 ) {
+            _exit(3);
+        }
+        char data[64];
+        alignas(cmsghdr) char controlBuffer[CMSG_SPACE(sizeof(int))];
+        iovec vector = { data, sizeof(data) };
+        msghdr message = {};
+        message.msg_iov = &vector;
+        message.msg_iovlen = 1;
+        message.msg_control = controlBuffer;
+        message.msg_controllen = sizeof(controlBuffer);
+        ssize_t received = recvmsg(fd, &message, 0);
+        _exit(received == 0 && message.msg_controllen == 0 ? 0 : 1);
+    }
+    int status = 0;
+    REQUIRE(waitpid(child, &status, 0) == child);
+    REQUIRE(WIFEXITED(status));
+    CHECK(WEXITSTATUS(status) == 0);
+
+    // the trusted successor still gets the listener afterwards
+    HotRestart successor(control);
+    std::vector<InheritedListener> listeners = successor.inherit();
+    CHECK(listeners.size() == 1);
+    successor.drain();
+    CHECK(handedOver.get());
+}
+
+TEST_CASE("HotRestart without a predecessor", "[HotRestart]") {
+    HotRestart restart(Endpoint::unixAbstract("socketsparrow-test-nobody"));
+    CHECK_THROWS_AS(restart.inherit(), SocketException);
+    CHECK_THROWS_AS(restart.controlSocket(), SocketException);
+    CHECK_THROWS_AS(restart.handOver(std::span<const int>()), SocketException);
+}
+
+TEST_CASE("HotRestart only replaces Socket Files", "[HotRestart]") {
+    char directory[] = "/tmp/socketsparrow-XXXXXX";
+    REQUIRE(mkdtemp(directory) != nullptr);
+    const std::string path = std::string(directory) + "/control";
+
+    // a stale socket file from an earlier process is replaced
+    {
+        Socket stale(AddressFamily::Unix, SocketType::SeqPacket);
+        stale.bind(Endpoint::unixPath(path));
+    }
+    HotRestart restart(Endpoint::unixPath(path));
+    CHECK_NOTHROW(restart.listen());
+    unlink(path.c_str());
+
+    // a regular file is not
+    std::ofstream(path) << "precious";
+    HotRestart blocked(Endpoint::unixPath(path));
+    CHECK_THROWS_AS(blocked.listen(), SocketException);
+    std::string content;
+    std::ifstream(path) >> content;
+    CHECK(content == "precious");
+
+    unlink(path.c_str());
+    rmdir(directory);
+}
@@ -0,0 +1,251 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "IoUring.hpp"
+#include "Exceptions.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace SocketSparrow;
+
+namespace {
+
+std::span<const std::byte> bytesOf(const std::string& data) {
+    return std::as_bytes(std::span(data.data(), data.size()));
+}
+
+std::string stringOf(std::span<const std::byte> data) {
+    return std::string(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+} // namespace
+
+TEST_CASE("IoUring Setup", "[IoUring]") {
+    IoUring ring(16);
+    CHECK(ring.usesRing() == IoUring::isAvailable());
+    CHECK(ring.inFlight() == 0);
+
+    SECTION("Buffer groups") {
+        REQUIRE_NOTHROW(ring.provideBuffers(1, 4, 256));
+        CHECK_THROWS_MATCHES(
+            ring.provideBuffers(1, 4, 256),
+            SocketException,
+            Catch::Matchers::Message("Buffer group already exists")
+        );
+        CHECK_THROWS_MATCHES(
+            ring.provideBuffers(2, 0, 256),
+            SocketException,
+            Catch::Matchers::Message("Invalid buffer group size")
+        );
+
+        Socket socket(AddressFamily::IPv4, SocketType::UDP);
+        CHECK_THROWS_MATCHES(
+            ring.prepareRecvMultishot(socket, 3, 0),
+            SocketException,
+            Catch::Matchers::Message("Unknown buffer group: 3")
+        );
+    }
+}
+
+TEST_CASE("IoUring UDP", "[IoUring]") {
+    IoUring ring(16);
+    auto endpoint = std::make_shared<Endpoint>("localhost", 7762);
+    Socket server(AddressFamily::IPv4, SocketType::UDP);
+    Socket client(AddressFamily::IPv4, SocketType::UDP);
+    server.enableAddressReuse(true);
+    server.bind(endpoint);
+    ring.registerSocket(server);
+
+    std::string message = "Hello Ring";
+    std::vector<std::byte> buffer(64);
+    std::string received;
+    bool sawSource = false;
+    int sent = 0;
+
+    auto handler = [&](const IoCompletion& completion) {
+        REQUIRE(completion.result >= 0);
+        if ( completion.userData == 1 ) {
+            sent = completion.result;
+        } else if ( completion.userData == 2 ) {
+            received = stringOf(std::span(buffer.data(), static_cast<size_t>(completion.result)));
+            sawSource = completion.source != nullptr && completion.source->sa_family == AF_INET;
+        }
+    };
+
+    ring.prepareSendTo(client, bytesOf(message), *endpoint, 1);
+    CHECK(ring.complete(handler, 1) == 1);
+    CHECK(sent == static_cast<int>(message.size()));
+
+    ring.prepareRecvFrom(server, buffer, 2);
+    CHECK(ring.complete(handler, 1) == 1);
+    CHECK(received == message);
+    CHECK(sawSource);
+    CHECK(ring.inFlight() == 0);
+}
+
+TEST_CASE("IoUring TCP", "[IoUring]") {
+    IoUring ring(16);
+    auto endpoint = std::make_shared<Endpoint>("localhost", 7763);
+    Socket server(AddressFamily::IPv4, SocketType::TCP);
+    server.enableAddressReuse(true);
+    server.bind(endpoint);
+    server.listen(5);
+
+    Socket client(AddressFamily::IPv4, SocketType::TCP);
+    int connectResult = -1;
+    ring.prepareConnect(client, *endpoint, 1);
+    ring.complete([&](const IoCompletion& completion) { connectResult = completion.result; }, 1);
+    REQUIRE(connectResult == 0);
+
+    SECTION("Accept") {
+        int accepted = -1;
+        ring.prepareAccept(server, 2);
+        ring.complete([&](const IoCompletion& completion) {
+            accepted = completion.result;
+            CHECK(completion.source != nullptr);
+        }, 1);
+        REQUIRE(accepted >= 0);
+        ::close(accepted);
+    }
+
+    SECTION("Send, Recv and multishot Recv") {
+        auto connection = server.accept();
+
+        std::string first = "first";
+        std::string second = "second";
+        ring.prepareSend(client, bytesOf(first), 1);
+        CHECK(ring.complete([](const IoCompletion& completion) {
+            CHECK(completion.result == 5);
+        }, 1) == 1);
+
+        std::vector<std::byte> buffer(16);
+        ring.prepareRecv(*connection, buffer, 2);
+        ring.complete([&](const IoCompletion& completion) {
+            REQUIRE(completion.result == 5);
+            CHECK(stringOf(std::span(buffer.data(), 5)) == first);
+        }, 1);
+
+        ring.provideBuffers(7, 4, 64);
+        ring.prepareSend(client, bytesOf(second), 3);
+        ring.complete([](const IoCompletion&) {}, 1);
+
+        std::string received;
+        ring.prepareRecvMultishot(*connection, 7, 4);
+        ring.complete([&](const IoCompletion& completion) {
+            if ( completion.userData == 4 ) {
+                REQUIRE(completion.result > 0);
+                received = stringOf(completion.buffer);
+            }
+        }, 1);
+        CHECK(received == second);
+    }
+}
+
+TEST_CASE("IoUring Operations wait for their Socket", "[IoUring]") {
+    IoUring ring(16);
+    auto endpoint = std::make_shared<Endpoint>("localhost", 7788);
+    Socket server(AddressFamily::IPv4, SocketType::TCP);
+    server.enableAddressReuse(true);
+    server.bind(endpoint);
+    server.listen(5);
+
+    int accepted = -1;
+    ring.prepareAccept(server, 1);
+    CHECK(ring.complete([](const IoCompletion&) {}, 0) == 0);
+    CHECK(ring.inFlight() == 1);
+
+    Socket client(AddressFamily::IPv4, SocketType::TCP);
+    client.connect(endpoint);
+    CHECK(ring.complete([&](const IoCompletion& completion) { accepted = completion.result; }, 1) == 1);
+    REQUIRE(accepted >= 0);
+    CHECK((::fcntl(accepted, F_GETFD) & FD_CLOEXEC) != 0);
+
+    std::vector<std::byte> buffer(16);
+    std::string received;
+    ring.prepareRecv(client, buffer, 2);
+    CHECK(ring.complete([](const IoCompletion&) {}, 0) == 0);
+    CHECK(ring.inFlight() == 1);
+
+    std::string message = "late";
+    REQUIRE(::send(accepted, message.data(), message.size(), 0) == static_cast<ssize_t>(message.size()));
+    CHECK(ring.complete([&](const IoCompletion& completion) {
+        REQUIRE(completion.result == 4);
+        received = stringOf(std::span(buffer.data(), 4));
+    }, 1) == 1);
+    CHECK(received == message);
+    CHECK(ring.inFlight() == 0);
+    ::close(accepted);
+}
+
+TEST_CASE("IoUring cancels a multishot Accept", "[IoUring]") {
+    IoUring ring(16);
+    auto endpoint = std::make_shared<Endpoint>("localhost", 7789);
+    Socket server(AddressFamily::IPv4, SocketType::TCP);
+    server.enableAddressReuse(true);
+    server.bind(endpoint);
+    server.listen(5);
+
+    std::vector<IoCompletion> completions;
+    auto handler = [&](const IoCompletion& completion) { completions.push_back(completion); };
+
+    ring.prepareAccept(server, 1, true);
+    Socket first(AddressFamily::IPv4, SocketType::TCP);
+    first.connect(endpoint);
+    REQUIRE(ring.complete(handler, 1) == 1);
+    REQUIRE(completions[0].result >= 0);
+    CHECK(completions[0].more);
+    ::close(completions[0].result);
+
+    ring.prepareCancel(1);
+    REQUIRE(ring.complete(handler, 1) == 1);
+    CHECK(completions[1].userData == 1);
+    CHECK(completions[1].result == -ECANCELED);
+    CHECK_FALSE(completions[1].more);
+    CHECK(ring.inFlight() == 0);
+
+    // the next connection stays queued for the listener instead of completing on the ring
+    Socket second(AddressFamily::IPv4, SocketType::TCP);
+    second.connect(endpoint);
+    CHECK(ring.complete(handler, 0) == 0);
+    CHECK(completions.size() == 2);
+    CHECK(server.accept() != nullptr);
+
+    // cancelling nothing is harmless
+    ring.prepareCancel(1);
+    CHECK(ring.complete(handler, 0) == 0);
+    CHECK(ring.inFlight() == 0);
+}
+
+TEST_CASE("IoUring fixed files follow unregisterSocket", "[IoUring]") {
+    IoUring ring(16);
+    Socket client(AddressFamily::IPv4, SocketType::UDP);
+    int handle = -1;
+    {
+        Socket registered(AddressFamily::IPv4, SocketType::UDP);
+        registered.bind(Endpoint("127.0.0.1", 0));
+        handle = registered.getNativeHandle();
+        CHECK(ring.registerSocket(registered) == ring.usesRing());
+        ring.unregisterSocket(registered);
+    }
+
+    // the next Socket gets the handle back and has to receive its own datagrams
+    Socket server(AddressFamily::IPv4, SocketType::UDP);
+    server.bind(Endpoint("127.0.0.1", 7790));
+    REQUIRE(server.getNativeHandle() == handle);
+
+    std::vector<std::byte> buffer(16);
+    std::string received;
+    ring.prepareRecv(server, buffer, 1);
+    std::string message = "reused";
+    REQUIRE(client.send_to(std::string_view(message), Endpoint("127.0.0.1", 7790)) == static_cast<ssize_t>(message.size()));
+    CHECK(ring.complete([&](const IoCompletion& completion) {
+        REQUIRE(completion.result == 6);
+        received = stringOf(std::span(buffer.data(), 6));
+    }, 1) == 1);
+    CHECK(received == message);
+}
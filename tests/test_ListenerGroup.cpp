@@ -0,0 +1,105 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "ListenerGroup.hpp"
+#include "Exceptions.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+using namespace SocketSparrow;
+
+TEST_CASE("ListenerGroup Accept", "[ListenerGroup]") {
+    ListenerGroup::Options options;
+    options.workers = 3;
+
+    SECTION("Plain") {}
+    SECTION("Pinned and steered") {
+        options.pinWorkers = true;
+        options.steerByCpu = true;
+    }
+
+    std::atomic<int> accepted = 0;
+    std::mutex mutex;
+    std::set<size_t> workers;
+    std::vector<Socket> connections;
+
+    ListenerGroup group(Endpoint("127.0.0.1", 0), [&](Socket&& connection, Reactor& reactor, size_t worker) {
+        CHECK(&reactor == &group.reactor(worker));
+        std::lock_guard lock(mutex);
+        workers.insert(worker);
+        connections.push_back(std::move(connection));
+        accepted++;
+    }, options);
+
+    CHECK(group.size() == 3);
+    CHECK(group.endpoint().getPort() != 0);
+    CHECK_THROWS_AS(group.reactor(3), SocketException);
+
+    group.start();
+    CHECK_THROWS_MATCHES(
+        group.start(),
+        SocketException,
+        Catch::Matchers::Message("ListenerGroup is already running")
+    );
+
+    std::vector<std::unique_ptr<Socket>> clients;
+    for ( int i = 0; i < 30; i++ ) {
+        clients.push_back(std::make_unique<Socket>(AddressFamily::IPv4, SocketType::TCP));
+        clients.back()->connect(group.endpoint());
+    }
+    for ( int i = 0; i < 200 && accepted < 30; i++ ) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    group.stop();
+
+    CHECK(accepted == 30);
+    std::lock_guard lock(mutex);
+    for ( size_t worker : workers ) {
+        CHECK(worker < 3);
+    }
+}
+
+TEST_CASE("ListenerGroup out of Descriptors", "[ListenerGroup]") {
+    ListenerGroup::Options options;
+    options.workers = 1;
+
+    std::atomic<int> accepted = 0;
+    ListenerGroup group(Endpoint("127.0.0.1", 0), [&](Socket&&, Reactor&, size_t) {
+        accepted++;
+    }, options);
+    group.start();
+
+    Socket client(AddressFamily::IPv4, SocketType::TCP);
+
+    // the lowest free descriptor becomes the limit, so accepting fails with EMFILE
+    rlimit previous;
+    REQUIRE(getrlimit(RLIMIT_NOFILE, &previous) == 0);
+    int lowest = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+    REQUIRE(lowest != -1);
+    ::close(lowest);
+    rlimit exhausted = previous;
+    exhausted.rlim_cur = static_cast<rlim_t>(lowest);
+    REQUIRE(setrlimit(RLIMIT_NOFILE, &exhausted) == 0);
+
+    client.connect(group.endpoint());
+
+    // the worker sheds the connection instead of spinning on the readable listener
+    pollfd descriptor{ client.getNativeHandle(), POLLIN, 0 };
+    int ready = ::poll(&descriptor, 1, 2000);
+    setrlimit(RLIMIT_NOFILE, &previous);
+    group.stop();
+
+    CHECK(ready == 1);
+    char byte;
+    CHECK(::recv(client.getNativeHandle(), &byte, 1, MSG_DONTWAIT) <= 0);
+    CHECK(accepted == 0);
+}
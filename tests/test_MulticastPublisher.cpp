@@ -0,0 +1,128 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "MulticastPublisher.hpp"
+#include "Exceptions.hpp"
+
+#include <string>
+
+#include <net/if.h>
+#include <poll.h>
+
+using namespace SocketSparrow;
+
+namespace {
+
+// receive one datagram, giving up after the timeout (ms) so a missing multicast route cannot hang the test
+std::string receive(Socket& socket, int timeout = 1000) {
+    pollfd fd{ socket.getNativeHandle(), POLLIN, 0 };
+    if ( poll(&fd, 1, timeout) != 1 ) {
+        return {};
+    }
+    std::byte buffer[256];
+    size_t size = socket.recv(buffer);
+    return std::string(reinterpret_cast<const char*>(buffer), size);
+}
+
+} // namespace
+
+TEST_CASE("Socket Multicast Options", "[Multicast]") {
+    Socket tcp(AddressFamily::IPv4, SocketType::TCP);
+    CHECK_THROWS_AS(tcp.joinGroup(Endpoint("239.255.77.86", 0)), SocketException);
+    CHECK_THROWS_AS(tcp.setMulticastTTL(1), SocketException);
+
+    Socket udp(AddressFamily::IPv4, SocketType::UDP);
+    CHECK_NOTHROW(udp.setMulticastTTL(4));
+    CHECK_NOTHROW(udp.enableMulticastLoop(false));
+    CHECK_THROWS_AS(udp.setMulticastTTL(1000), SocketException);
+
+    Socket udp6(AddressFamily::IPv6, SocketType::UDP);
+    CHECK_NOTHROW(udp6.setMulticastTTL(4));
+    CHECK_NOTHROW(udp6.enableMulticastLoop(true));
+    CHECK_THROWS_AS(udp6.joinGroup(Endpoint("239.255.77.86", 0)), SocketException);
+
+    CHECK_THROWS_AS(MulticastPublisher({}, MulticastPublisher::Options()), SocketException);
+}
+
+TEST_CASE("Multicast on the Loopback Interface", "[Multicast]") {
+    const unsigned lo = if_nametoindex("lo");
+    REQUIRE(lo != 0);
+    const Endpoint group("239.255.77.86", 7786);
+
+    Socket receiver(AddressFamily::IPv4, SocketType::UDP);
+    receiver.enableAddressReuse();
+    receiver.bind(Endpoint("0.0.0.0", 7786));
+    receiver.joinGroup(group, lo);
+
+    MulticastPublisher::Options options;
+    options.interfaceIndex = lo;
+    options.batchSize = 4;
+    MulticastPublisher publisher({ group }, options);
+
+    publisher.publish("first");
+    publisher.publish("second");
+    CHECK(publisher.pending() == 2);
+    CHECK(receive(receiver, 100).empty());
+
+    CHECK(publisher.flush() == 2);
+    CHECK(publisher.pending() == 0);
+    CHECK(receive(receiver) == "first");
+    CHECK(receive(receiver) == "second");
+
+    SECTION("A full batch is sent right away") {
+        for ( int i = 0; i < 4; i++ ) {
+            publisher.publish(std::to_string(i));
+        }
+        CHECK(publisher.pending() == 0);
+        for ( int i = 0; i < 4; i++ ) {
+            CHECK(receive(receiver) == std::to_string(i));
+        }
+    }
+
+    SECTION("Source-specific membership filters other senders") {
+        receiver.leaveGroup(group, lo);
+        receiver.joinSourceGroup(group, Endpoint("127.0.0.2", 0), lo);
+        publisher.publish("filtered");
+        publisher.flush();
+        CHECK(receive(receiver, 100).empty());
+
+        receiver.leaveSourceGroup(group, Endpoint("127.0.0.2", 0), lo);
+        receiver.joinSourceGroup(group, Endpoint("127.0.0.1", 0), lo);
+        MulticastPublisher source({ group }, options);
+        source.socket().bind(Endpoint("127.0.0.1", 0));
+        source.publish("accepted");
+        source.flush();
+        CHECK(receive(receiver) == "accepted");
+    }
+
+    SECTION("Leaving the group stops delivery") {
+        receiver.leaveGroup(group, lo);
+        publisher.publish("gone");
+        publisher.flush();
+        CHECK(receive(receiver, 100).empty());
+    }
+}
+
+TEST_CASE("Multicast to a refused group", "[Multicast]") {
+    Socket receiver(AddressFamily::IPv4, SocketType::UDP);
+    receiver.bind(Endpoint("127.0.0.1", 7793));
+
+    // broadcasting without SO_BROADCAST fails with EACCES every time, like an unroutable group
+    MulticastPublisher publisher({ Endpoint("255.255.255.255", 7793), Endpoint("127.0.0.1", 7793) }, MulticastPublisher::Options());
+
+    publisher.publish("first");
+    CHECK_THROWS_AS(publisher.flush(), SendError);
+    CHECK(publisher.pending() == 1);
+    CHECK(publisher.flush() == 1);
+    CHECK(receive(receiver) == "first");
+
+    // the failing datagram in the middle of the batch does not hold back the ones behind it
+    publisher.publish("second");
+    publisher.publish("third");
+    CHECK_THROWS_AS(publisher.flush(), SendError);
+    CHECK_THROWS_AS(publisher.flush(), SendError);
+    CHECK(publisher.flush() == 1);
+    CHECK(publisher.pending() == 0);
+    CHECK(receive(receiver) == "second");
+    CHECK(receive(receiver) == "third");
+}
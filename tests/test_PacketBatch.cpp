@@ -0,0 +1,141 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "PacketBatch.hpp"
+#include "Socket.hpp"
+#include "Exceptions.hpp"
+
+#include <string>
+#include <string_view>
+
+using namespace SocketSparrow;
+
+namespace {
+
+std::string_view asString(std::span<const char> data) {
+    return { data.data(), data.size() };
+}
+
+} // namespace
+
+TEST_CASE("PacketBatch Slots", "[PacketBatch]") {
+    PacketBatch batch(2, 8);
+    CHECK(batch.capacity() == 2);
+    CHECK(batch.packetSize() == 8);
+    CHECK(batch.empty());
+
+    std::string_view first = "first";
+    REQUIRE_NOTHROW(batch.push(first, Endpoint("127.0.0.1", 7766)));
+    REQUIRE_NOTHROW(batch.push(std::string_view("second")));
+    CHECK(batch.full());
+    CHECK(batch.size() == 2);
+
+    CHECK(asString(batch.data(0)) == "first");
+    CHECK(batch.endpoint(0).getPort() == 7766);
+    CHECK(asString(batch.data(1)) == "second");
+    CHECK(batch.source(1) == nullptr);
+    CHECK_FALSE(batch.endpoint(1).isSpecified());
+
+    CHECK_THROWS_MATCHES(
+        batch.push(first),
+        SocketException,
+        Catch::Matchers::Message("PacketBatch is full")
+    );
+    CHECK_THROWS_MATCHES(
+        batch.data(2),
+        SocketException,
+        Catch::Matchers::Message("PacketBatch index out of range")
+    );
+
+    batch.clear();
+    CHECK(batch.empty());
+    CHECK_THROWS_MATCHES(
+        batch.push(std::string_view("too long for a slot")),
+        SocketException,
+        Catch::Matchers::Message("Packet does not fit into a PacketBatch slot")
+    );
+
+    CHECK_THROWS_AS(PacketBatch(0, 8), SocketException);
+}
+
+TEST_CASE("PacketBatch Send and Receive", "[PacketBatch]") {
+    Socket receiver(AddressFamily::IPv4, SocketType::UDP);
+    receiver.enableAddressReuse(true);
+    receiver.bindToPort(7766);
+
+    Socket sender(AddressFamily::IPv4, SocketType::UDP);
+    Endpoint destination("127.0.0.1", 7766);
+
+    PacketBatch outgoing(4, 64);
+    outgoing.push(std::string_view("one"), destination);
+    outgoing.push(std::string_view("two"), destination);
+    outgoing.push(std::string_view("three"), destination);
+    REQUIRE(sender.sendBatch(outgoing) == 3);
+
+    PacketBatch incoming(4, 4);
+    size_t received = 0;
+    while ( received < 3 ) {
+        size_t count = receiver.recvBatch(incoming);
+        REQUIRE(count > 0);
+        for ( size_t i = 0; i < count; i++, received++ ) {
+            switch ( received ) {
+            case 0: CHECK(asString(incoming.data(i)) == "one"); break;
+            case 1: CHECK(asString(incoming.data(i)) == "two"); break;
+            case 2:
+                CHECK(asString(incoming.data(i)) == "thre");
+                CHECK(incoming.truncated(i));
+                break;
+            }
+            REQUIRE(incoming.source(i) != nullptr);
+            CHECK(incoming.sourceSize(i) == sizeof(sockaddr_in));
+            CHECK(incoming.endpoint(i).getAddressFamily() == AddressFamily::IPv4);
+        }
+    }
+
+    receiver.enableNonBlocking(true);
+    CHECK(receiver.recvBatch(incoming) == 0);
+    CHECK(incoming.empty());
+
+    Socket tcp(AddressFamily::IPv4, SocketType::TCP);
+    CHECK_THROWS_MATCHES(
+        tcp.recvBatch(incoming),
+        SocketException,
+        Catch::Matchers::Message("Cannot recvBatch from a TCP socket")
+    );
+    CHECK_THROWS_MATCHES(
+        tcp.sendBatch(outgoing),
+        SocketException,
+        Catch::Matchers::Message("Cannot sendBatch from a TCP socket")
+    );
+}
+
+TEST_CASE("PacketBatch partial Send", "[PacketBatch]") {
+    Socket sender(AddressFamily::IPv4, SocketType::UDP);
+    Endpoint destination("127.0.0.1", 7790);
+
+    // an unconnected Socket cannot send the Packet without a destination
+    PacketBatch outgoing(4, 64);
+    outgoing.push(std::string_view("one"), destination);
+    outgoing.push(std::string_view("lost"));
+    outgoing.push(std::string_view("three"), destination);
+
+    REQUIRE(sender.sendBatch(outgoing) == 1);
+    outgoing.drop(1);
+    REQUIRE(outgoing.size() == 2);
+    CHECK(asString(outgoing.data(0)) == "lost");
+    CHECK(outgoing.source(0) == nullptr);
+    CHECK(asString(outgoing.data(1)) == "three");
+    CHECK(outgoing.endpoint(1).getPort() == 7790);
+
+    CHECK_THROWS_AS(sender.sendBatch(outgoing), SendError);
+    outgoing.drop(1);
+    CHECK(sender.sendBatch(outgoing) == 1);
+    outgoing.drop(1);
+    CHECK(outgoing.empty());
+
+    CHECK_THROWS_MATCHES(
+        outgoing.drop(1),
+        SocketException,
+        Catch::Matchers::Message("PacketBatch index out of range")
+    );
+}
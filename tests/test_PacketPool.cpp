@@ -0,0 +1,149 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "PacketPool.hpp"
+#include "Socket.hpp"
+#include "Exceptions.hpp"
+
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SocketSparrow;
+
+TEST_CASE("PacketPool Acquire and Release", "[PacketPool]") {
+    PacketPool pool(4, 16, 2);
+    CHECK(pool.capacity() == 4);
+    CHECK(pool.packetSize() == 16);
+    CHECK(pool.available() == 4);
+
+    SECTION("Exhaustion") {
+        std::vector<PooledPacket> packets;
+        for ( int i = 0; i < 4; i++ ) {
+            packets.push_back(pool.acquire());
+            CHECK(packets.back().capacity() == 16);
+            CHECK(packets.back().size() == 0);
+        }
+        CHECK_FALSE(pool.tryAcquire());
+        CHECK_THROWS_MATCHES(
+            pool.acquire(),
+            SocketException,
+            Catch::Matchers::Message("PacketPool is exhausted")
+        );
+
+        packets.pop_back();
+        CHECK(pool.tryAcquire());
+    }
+
+    SECTION("Move and Reset") {
+        PooledPacket packet = pool.acquire();
+        const char* buffer = packet.buffer().data();
+
+        PooledPacket moved = std::move(packet);
+        CHECK_FALSE(packet);
+        REQUIRE(moved);
+        CHECK(moved.buffer().data() == buffer);
+
+        moved.resize(3);
+        CHECK(moved.data().size() == 3);
+        CHECK_THROWS_MATCHES(
+            moved.resize(17),
+            SocketException,
+            Catch::Matchers::Message("PooledPacket size exceeds its capacity")
+        );
+
+        moved.reset();
+        CHECK_FALSE(moved);
+        CHECK(moved.source() == nullptr);
+        CHECK_THROWS_MATCHES(
+            moved.resize(0),
+            SocketException,
+            Catch::Matchers::Message("Cannot resize an empty PooledPacket")
+        );
+    }
+
+    SECTION("Cross Thread Release") {
+        std::vector<PooledPacket> packets;
+        for ( int i = 0; i < 4; i++ ) {
+            packets.push_back(pool.acquire());
+        }
+
+        // the worker thread's cache goes back to the shared list when it exits
+        std::thread worker([packets = std::move(packets)]() mutable {
+            packets.clear();
+        });
+        worker.join();
+
+        std::vector<PooledPacket> again;
+        for ( int i = 0; i < 4; i++ ) {
+            again.push_back(pool.acquire());
+        }
+        CHECK_FALSE(pool.tryAcquire());
+    }
+
+    CHECK_THROWS_AS(PacketPool(0), SocketException);
+}
+
+TEST_CASE("PacketPool Release on a Live Thread", "[PacketPool]") {
+    // the pool is no larger than a thread cache, so every buffer fits the worker's cache
+    PacketPool pool(4, 16);
+
+    std::vector<PooledPacket> packets;
+    for ( int i = 0; i < 4; i++ ) {
+        packets.push_back(pool.acquire());
+    }
+    CHECK(pool.available() == 0);
+
+    std::promise<void> released;
+    std::promise<void> done;
+    std::thread worker([&, packets = std::move(packets)]() mutable {
+        packets.clear();
+        released.set_value();
+        done.get_future().wait();
+    });
+    released.get_future().wait();
+
+    // the worker keeps running, its cached buffers are still available to this thread
+    CHECK(pool.available() == 4);
+    std::vector<PooledPacket> again;
+    for ( int i = 0; i < 4; i++ ) {
+        again.push_back(pool.acquire());
+    }
+    CHECK_FALSE(pool.tryAcquire());
+    CHECK(pool.available() == 0);
+
+    done.set_value();
+    worker.join();
+}
+
+TEST_CASE("PacketPool recv_from", "[PacketPool]") {
+    PacketPool pool(2, 64);
+    Socket server(AddressFamily::IPv4, SocketType::UDP);
+    server.enableAddressReuse(true);
+    server.bindToPort(7768);
+
+    Socket client(AddressFamily::IPv4, SocketType::UDP);
+    client.send_to("Hello Pool!", std::make_shared<Endpoint>("127.0.0.1", 7768));
+
+    PooledPacket packet = pool.acquire();
+    REQUIRE(server.recv_from(packet) == 11);
+    CHECK(std::string(packet.data().begin(), packet.data().end()) == "Hello Pool!");
+    REQUIRE(packet.source() != nullptr);
+    CHECK(packet.endpoint().getAddressFamily() == AddressFamily::IPv4);
+
+    const std::string tooLarge(100, 'x');
+    client.send_to(tooLarge, std::make_shared<Endpoint>("127.0.0.1", 7768));
+    client.send_to(tooLarge, std::make_shared<Endpoint>("127.0.0.1", 7768));
+    CHECK_THROWS_AS(server.recv_from(packet), RecvError);
+    CHECK_THROWS_WITH(server.recv_from(packet), Catch::Matchers::StartsWith("Received datagram is larger than the packet"));
+    CHECK(packet.size() == 0);
+
+    PooledPacket empty;
+    CHECK_FALSE(empty.endpoint().isSpecified());
+    CHECK_THROWS_MATCHES(
+        server.recv_from(empty),
+        SocketException,
+        Catch::Matchers::Message("Cannot receive into an empty PooledPacket")
+    );
+}
@@ -0,0 +1,164 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "Reactor.hpp"
+#include "Exceptions.hpp"
+
+#include <thread>
+#include <chrono>
+
+using namespace SocketSparrow;
+
+TEST_CASE("Reactor Registration", "[Reactor]") {
+    Reactor reactor;
+    Socket socket(AddressFamily::IPv4, SocketType::UDP);
+    auto callback = [](Socket&, IOEvent) {};
+
+    SECTION("Add and Remove") {
+        CHECK(reactor.size() == 0);
+        CHECK_FALSE(reactor.contains(socket));
+
+        REQUIRE_NOTHROW(reactor.add(socket, IOEvent::Read, callback));
+        CHECK(reactor.contains(socket));
+        CHECK(reactor.size() == 1);
+
+        REQUIRE_NOTHROW(reactor.modify(socket, IOEvent::Read | IOEvent::Write));
+        REQUIRE_NOTHROW(reactor.remove(socket));
+        CHECK_FALSE(reactor.contains(socket));
+        CHECK(reactor.size() == 0);
+    }
+
+    SECTION("Invalid Registrations") {
+        reactor.add(socket, IOEvent::Read, callback);
+        CHECK_THROWS_MATCHES(
+            reactor.add(socket, IOEvent::Read, callback),
+            SocketException,
+            Catch::Matchers::Message("Socket is already registered")
+        );
+
+        Socket other(AddressFamily::IPv4, SocketType::UDP);
+        CHECK_THROWS_MATCHES(
+            reactor.modify(other, IOEvent::Write),
+            SocketException,
+            Catch::Matchers::Message("Socket is not registered")
+        );
+        CHECK_THROWS_MATCHES(
+            reactor.remove(other),
+            SocketException,
+            Catch::Matchers::Message("Socket is not registered")
+        );
+        CHECK_THROWS_MATCHES(
+            reactor.add(other, IOEvent::Read, Reactor::Callback()),
+            SocketException,
+            Catch::Matchers::Message("Cannot register a Socket without a Callback")
+        );
+    }
+}
+
+TEST_CASE("Reactor Dispatch", "[Reactor]") {
+    Reactor reactor;
+
+    SECTION("Callback on readable UDP Socket") {
+        auto endpoint = std::make_shared<Endpoint>("localhost", 7760);
+        Socket server(AddressFamily::IPv4, SocketType::UDP);
+        server.enableAddressReuse(true);
+        server.bind(endpoint);
+
+        int calls = 0;
+        std::string received;
+        reactor.add(server, IOEvent::Read, [&](Socket& socket, IOEvent events) {
+            calls++;
+            CHECK(hasEvent(events, IOEvent::Read));
+            UDPPacket packet = socket.recv_from();
+            received.assign(packet.data.begin(), packet.data.end());
+        });
+
+        CHECK(reactor.poll(0) == 0);
+
+        Socket client(AddressFamily::IPv4, SocketType::UDP);
+        client.send_to("Hello Reactor", endpoint);
+
+        CHECK(reactor.poll(1000) == 1);
+        CHECK(calls == 1);
+        CHECK(received == "Hello Reactor");
+    }
+
+    SECTION("Handler accepts TCP connections") {
+        struct AcceptHandler : Reactor::Handler {
+            std::shared_ptr<Socket> connection;
+            void onReadable(Socket& socket) override {
+                connection = socket.accept();
+            }
+        } handler;
+
+        auto endpoint = std::make_shared<Endpoint>("localhost", 7761);
+        Socket server(AddressFamily::IPv4, SocketType::TCP);
+        server.enableAddressReuse(true);
+        server.bind(endpoint);
+        server.listen(5);
+        reactor.add(server, IOEvent::Read, handler);
+
+        Socket client(AddressFamily::IPv4, SocketType::TCP);
+        client.connect(endpoint);
+
+        CHECK(reactor.poll(1000) == 1);
+        REQUIRE(handler.connection);
+        CHECK(handler.connection->getState() == SocketState::Connected);
+    }
+
+    SECTION("Level and Edge triggered") {
+        Socket level(AddressFamily::IPv4, SocketType::UDP);
+        Socket edge(AddressFamily::IPv4, SocketType::UDP);
+        int levelCalls = 0;
+        int edgeCalls = 0;
+
+        reactor.add(level, IOEvent::Write, [&](Socket&, IOEvent) { levelCalls++; });
+        reactor.add(edge, IOEvent::Write, [&](Socket&, IOEvent) { edgeCalls++; }, TriggerMode::Edge);
+
+        reactor.poll(0);
+        reactor.poll(0);
+        reactor.poll(0);
+
+        CHECK(levelCalls == 3);
+        CHECK(edgeCalls == 1);
+    }
+
+    SECTION("Remove from within Callback") {
+        Socket socket(AddressFamily::IPv4, SocketType::UDP);
+        int calls = 0;
+        reactor.add(socket, IOEvent::Write, [&](Socket& self, IOEvent) {
+            calls++;
+            reactor.remove(self);
+        });
+
+        CHECK(reactor.poll(0) == 1);
+        CHECK(reactor.poll(0) == 0);
+        CHECK(calls == 1);
+        CHECK(reactor.size() == 0);
+    }
+}
+
+TEST_CASE("Reactor Run and Stop", "[Reactor]") {
+    Reactor reactor;
+
+    SECTION("Stop from another thread") {
+        std::thread stopper([&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            reactor.stop();
+        });
+
+        REQUIRE_NOTHROW(reactor.run());
+        stopper.join();
+        CHECK_FALSE(reactor.isRunning());
+    }
+
+    SECTION("Stop before run") {
+        reactor.stop();
+        REQUIRE_NOTHROW(reactor.run());
+    }
+
+    SECTION("Wakeup interrupts poll") {
+        reactor.wakeup();
+        CHECK(reactor.poll(1000) == 0);
+    }
+}
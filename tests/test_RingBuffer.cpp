@@ -0,0 +1,102 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#define private public
+#include "RingBuffer.hpp"
+#undef private
+
+#include "Exceptions.hpp"
+
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include <unistd.h>
+
+using namespace SocketSparrow;
+
+namespace {
+
+void append(RingBuffer& ring, std::string_view text) {
+    while ( !text.empty() ) {
+        std::span<std::byte> space = ring.writable();
+        size_t count = std::min(space.size(), text.size());
+        std::memcpy(space.data(), text.data(), count);
+        ring.commit(count);
+        text.remove_prefix(count);
+    }
+}
+
+std::string contents(const RingBuffer& ring) {
+    std::span<const std::byte> data = ring.readable();
+    return std::string(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+} // namespace
+
+TEST_CASE("RingBuffer Basics", "[RingBuffer]") {
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    RingBuffer ring(100);
+    CHECK(ring.capacity() == page);
+    CHECK(ring.size() == 0);
+    CHECK(ring.space() == page);
+
+    append(ring, "hello world");
+    CHECK(ring.size() == 11);
+    CHECK(contents(ring) == "hello world");
+
+    ring.consume(6);
+    CHECK(contents(ring) == "world");
+
+    CHECK_THROWS_MATCHES(
+        ring.consume(6),
+        SocketException,
+        Catch::Matchers::Message("Cannot consume more than the RingBuffer holds")
+    );
+    CHECK_THROWS_AS(ring.commit(page), SocketException);
+
+    ring.clear();
+    CHECK(ring.size() == 0);
+    CHECK_THROWS_AS(RingBuffer(0), SocketException);
+}
+
+TEST_CASE("RingBuffer Wrap Around", "[RingBuffer]") {
+    RingBuffer ring(1);
+    const size_t capacity = ring.capacity();
+
+    // fill almost completely, drain most of it and write across the end
+    append(ring, std::string(capacity - 8, 'x'));
+    ring.consume(capacity - 12);
+    append(ring, "0123456789abcdef");
+
+    CHECK(ring.size() == 20);
+    CHECK(contents(ring) == "xxxx0123456789abcdef");
+    if ( ring.isMirrored() ) {
+        // the free space crossing the end is one contiguous span as well
+        CHECK(ring.writable().size() == capacity - 20);
+    }
+
+    ring.consume(20);
+    CHECK(ring.size() == 0);
+    CHECK(ring.writable().size() == capacity);
+}
+
+TEST_CASE("RingBuffer Compaction", "[RingBuffer]") {
+    RingBuffer ring(1);
+    const size_t capacity = ring.capacity();
+    // the mirrored view is twice the capacity, so the plain layout fits into it
+    const bool mirrored = ring.mMirrored;
+    ring.mMirrored = false;
+
+    // one byte free, all of it in front of the data
+    append(ring, std::string(capacity - 1, 'x'));
+    ring.consume(1);
+    append(ring, "y");
+    CHECK(ring.size() == capacity - 1);
+    CHECK(ring.space() == 1);
+    CHECK(ring.writable().size() == 1);
+    CHECK(ring.mHead == 0);
+    CHECK(contents(ring).back() == 'y');
+
+    ring.mMirrored = mirrored;
+}
@@ -0,0 +1,217 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_all.hpp"
+
+#include "Scheduler.hpp"
+#include "Socket.hpp"
+#include "Exceptions.hpp"
+
+#include <string>
+#include <thread>
+
+using namespace SocketSparrow;
+
+namespace {
+
+Task<int> answer() {
+    co_return 42;
+}
+
+Task<void> throwing() {
+    throw SocketException("Task failed");
+    co_return;
+}
+
+Task<void> echoServer(Socket& listener, std::string& received) {
+    Socket connection = co_await listener.asyncAccept();
+    std::byte buffer[64];
+    size_t size = co_await connection.asyncRecv(buffer);
+    received.assign(reinterpret_cast<const char*>(buffer), size);
+    co_await connection.asyncSend(std::span<const std::byte>(buffer, size));
+}
+
+Task<void> echoClient(std::shared_ptr<Endpoint> endpoint, std::string& echoed) {
+    Socket socket(AddressFamily::IPv4, SocketType::TCP);
+    co_await socket.asyncConnect(endpoint);
+
+    const std::string message = "Hello, Coroutines!";
+    co_await socket.asyncSend(std::as_bytes(std::span(message)));
+
+    std::byte buffer[64];
+    size_t size = co_await socket.asyncRecv(buffer);
+    echoed.assign(reinterpret_cast<const char*>(buffer), size);
+}
+
+Task<void> receivePacket(Socket& socket, UDPPacket& packet, size_t& size) {
+    size = co_await socket.asyncRecvFrom(packet);
+}
+
+struct DestructionFlag {
+    bool& destroyed;
+    ~DestructionFlag() { destroyed = true; }
+};
+
+Task<void> parkForever(bool& destroyed, int& handle) {
+    DestructionFlag flag{destroyed};
+    Socket socket(AddressFamily::IPv4, SocketType::UDP);
+    socket.bind(std::make_shared<Endpoint>("127.0.0.1", 7789));
+    handle = socket.getNativeHandle();
+    UDPPacket packet;
+    co_await socket.asyncRecvFrom(packet);
+}
+
+} // namespace
+
+TEST_CASE("Task", "[Scheduler]") {
+    Scheduler scheduler;
+    CHECK(Scheduler::current() == nullptr);
+
+    SECTION("Result") {
+        int result = 0;
+        scheduler.spawn([](int& result) -> Task<void> {
+            result = co_await answer();
+        }(result));
+        CHECK(scheduler.active() == 0);
+        CHECK(result == 42);
+    }
+
+    SECTION("Exceptions") {
+        scheduler.spawn(throwing());
+        CHECK_THROWS_MATCHES(
+            scheduler.run(),
+            SocketException,
+            Catch::Matchers::Message("Task failed")
+        );
+    }
+}
+
+TEST_CASE("Scheduler TCP Echo", "[Scheduler]") {
+    Scheduler scheduler;
+    Socket listener(AddressFamily::IPv4, SocketType::TCP);
+    listener.enableAddressReuse(true);
+    listener.bindToPort(7764);
+    listener.listen(1);
+
+    std::string received;
+    std::string echoed;
+    scheduler.spawn(echoServer(listener, received));
+    scheduler.spawn(echoClient(std::make_shared<Endpoint>("127.0.0.1", 7764), echoed));
+    CHECK(scheduler.active() == 2);
+
+    REQUIRE_NOTHROW(scheduler.run());
+    CHECK(scheduler.active() == 0);
+    CHECK(received == "Hello, Coroutines!");
+    CHECK(echoed == "Hello, Coroutines!");
+    CHECK(scheduler.getReactor().size() == 0);
+}
+
+TEST_CASE("Scheduler UDP Receive", "[Scheduler]") {
+    Scheduler scheduler;
+    Socket receiver(AddressFamily::IPv4, SocketType::UDP);
+    receiver.enableAddressReuse(true);
+    receiver.bindToPort(7765);
+
+    UDPPacket packet;
+    size_t size = 0;
+    scheduler.spawn(receivePacket(receiver, packet, size));
+    REQUIRE(scheduler.active() == 1);
+
+    std::thread sender([] {
+        Socket socket(AddressFamily::IPv4, SocketType::UDP);
+        socket.send_to("Hello, Packet!", std::make_shared<Endpoint>("127.0.0.1", 7765));
+    });
+
+    REQUIRE_NOTHROW(scheduler.run());
+    sender.join();
+
+    CHECK(size == 14);
+    CHECK(std::string(packet.data.begin(), packet.data.end()) == "Hello, Packet!");
+    CHECK(packet.endpoint.getAddressFamily() == AddressFamily::IPv4);
+}
+
+TEST_CASE("Scheduler UDP Receive reuses the Packet", "[Scheduler]") {
+    Scheduler scheduler;
+    Socket receiver(AddressFamily::IPv4, SocketType::UDP);
+    receiver.enableAddressReuse(true);
+    receiver.bindToPort(7791);
+
+    Socket client(AddressFamily::IPv4, SocketType::UDP);
+    auto destination = std::make_shared<Endpoint>("127.0.0.1", 7791);
+
+    // leftovers of an earlier GRO receive must not survive into the next one
+    UDPPacket packet(64);
+    packet.data.assign(20, 'x');
+    packet.segmentSize = 1000;
+
+    size_t size = 0;
+    client.send_to("short", destination);
+    scheduler.spawn(receivePacket(receiver, packet, size));
+    REQUIRE_NOTHROW(scheduler.run());
+    CHECK(size == 5);
+    CHECK(std::string(packet.data.begin(), packet.data.end()) == "short");
+    CHECK(packet.segmentSize == 0);
+
+    client.send_to("a longer datagram", destination);
+    scheduler.spawn(receivePacket(receiver, packet, size));
+    REQUIRE_NOTHROW(scheduler.run());
+    CHECK(size == 17);
+    CHECK(std::string(packet.data.begin(), packet.data.end()) == "a longer datagram");
+    CHECK(packet.data.capacity() >= 64);
+}
+
+TEST_CASE("Scheduler UDP Receive truncated", "[Scheduler]") {
+    Scheduler scheduler;
+    Socket receiver(AddressFamily::IPv4, SocketType::UDP);
+    receiver.enableAddressReuse(true);
+    receiver.bindToPort(7792);
+
+    Socket client(AddressFamily::IPv4, SocketType::UDP);
+    auto destination = std::make_shared<Endpoint>("127.0.0.1", 7792);
+    client.send_to("does not fit eight bytes", destination);
+    client.send_to("fits", destination);
+
+    // a datagram larger than the packet is reported instead of silently cut off
+    UDPPacket small(8);
+    size_t size = 0;
+    scheduler.spawn(receivePacket(receiver, small, size));
+    CHECK_THROWS_WITH(scheduler.run(), Catch::Matchers::StartsWith("Received datagram is larger than the packet"));
+    CHECK(small.data.empty());
+
+    scheduler.spawn(receivePacket(receiver, small, size));
+    REQUIRE_NOTHROW(scheduler.run());
+    CHECK(size == 4);
+    CHECK(std::string(small.data.begin(), small.data.end()) == "fits");
+}
+
+TEST_CASE("Scheduler Errors", "[Scheduler]") {
+    Socket socket(AddressFamily::IPv4, SocketType::UDP);
+    CHECK_THROWS_MATCHES(
+        socket.asyncAccept(),
+        SocketException,
+        Catch::Matchers::Message("Cannot accept on a UDP socket")
+    );
+
+    Socket tcp(AddressFamily::IPv4, SocketType::TCP);
+    CHECK_THROWS_MATCHES(
+        tcp.asyncAccept(),
+        SocketException,
+        Catch::Matchers::Message("Cannot accept without listening")
+    );
+}
+
+TEST_CASE("Scheduler destroys parked Tasks", "[Scheduler]") {
+    bool destroyed = false;
+    int handle = -1;
+    {
+        Scheduler scheduler;
+        scheduler.spawn(parkForever(destroyed, handle));
+        REQUIRE(scheduler.active() == 1);
+        CHECK(scheduler.getReactor().size() == 1);
+        CHECK_FALSE(destroyed);
+    }
+    CHECK(destroyed);
+
+    // the Socket owned by the frame was closed, so its port is free again
+    Socket socket(AddressFamily::IPv4, SocketType::UDP);
+    CHECK_NOTHROW(socket.bind(std::make_shared<Endpoint>("127.0.0.1", 7789)));
+    CHECK(handle >= 0);
+}
@@ -12,8 +12,11 @@
 #include <thread>
 #include <chrono>
 #include <atomic>
+#include <algorithm>
 
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <errno.h>
 
 // === System Call Mocking ===
@@ -337,7 +340,7 @@ TEST_CASE("Socket Send and Recv", "[Socket]") {
 
             Socket client(SocketSparrow::AddressFamily::IPv4, SocketSparrow::SocketType::TCP);
             REQUIRE_NOTHROW(client.connect(endpoint2));
-            flag.wait(true);
+            flag.wait(false);
             REQUIRE_NOTHROW(client.send("Hello World!"));
             std::vector<char> recvMessageVec;
             REQUIRE_NOTHROW(client.recv(recvMessageVec));
@@ -397,3 +400,743 @@ TEST_CASE("Socket Send and Recv", "[Socket]") {
     }
 
 }
+
+TEST_CASE("Socket Span Send and Recv", "[Socket]") {
+    auto endpoint = std::make_shared<Endpoint>("127.0.0.1", 7767);
+    Socket server(SocketSparrow::AddressFamily::IPv4, SocketSparrow::SocketType::UDP);
+    Socket client(SocketSparrow::AddressFamily::IPv4, SocketSparrow::SocketType::UDP);
+    server.enableAddressReuse(true);
+    REQUIRE_NOTHROW(server.bind(endpoint));
+
+    const std::string message = "Hello Span!";
+    REQUIRE(client.send_to(std::as_bytes(std::span(message)), endpoint) == 11);
+    REQUIRE(client.send_to(std::string_view(message).substr(0, 5), endpoint) == 5);
+
+    std::byte buffer[32];
+    ssize_t received = server.recv(buffer);
+    REQUIRE(received == 11);
+    CHECK(std::string(reinterpret_cast<const char*>(buffer), received) == message);
+
+    received = server.recv(std::span(buffer, 3));
+    REQUIRE(received == 3);
+    CHECK(std::string(reinterpret_cast<const char*>(buffer), received) == "Hel");
+}
+
+TEST_CASE("Socket recv_from Sender", "[Socket]") {
+    Socket server(SocketSparrow::AddressFamily::IPv4, SocketSparrow::SocketType::UDP);
+    Socket client(SocketSparrow::AddressFamily::IPv4, SocketSparrow::SocketType::UDP);
+    server.enableAddressReuse(true);
+    server.bindToPort(7769);
+    client.bindToPort(7770);
+
+    Endpoint destination("127.0.0.1", 7769);
+    client.send_to(std::as_bytes(std::span(std::string_view("first"))), destination);
+    client.send_to(std::as_bytes(std::span(std::string_view("second"))), destination);
+
+    UDPPacket packet(64);
+    REQUIRE(server.recv_from(packet) == 5);
+    CHECK(std::string(packet.data.begin(), packet.data.end()) == "first");
+    CHECK(packet.endpoint.getAddressFamily() == AddressFamily::IPv4);
+    CHECK(packet.endpoint.getPort() == 7770);
+
+    server.enableSenderCache(4);
+    auto sender = server.sender(packet);
+
+    REQUIRE(server.recv_from(packet) == 6);
+    CHECK(packet.data.capacity() >= 64);
+    CHECK(std::string(packet.data.begin(), packet.data.end()) == "second");
+    CHECK(server.sender(packet) == sender);
+
+    // shorter and longer datagrams than the previous one, the tail comes from the staging buffer
+    client.send_to(std::as_bytes(std::span(std::string_view("abc"))), destination);
+    client.send_to(std::as_bytes(std::span(std::string_view("a longer datagram"))), destination);
+    REQUIRE(server.recv_from(packet) == 3);
+    CHECK(std::string(packet.data.begin(), packet.data.end()) == "abc");
+    REQUIRE(server.recv_from(packet) == 17);
+    CHECK(std::string(packet.data.begin(), packet.data.end()) == "a longer datagram");
+
+    server.enableSenderCache(0);
+    CHECK(server.sender(packet) != sender);
+
+    // a datagram larger than the packet is reported instead of silently cut off
+    UDPPacket small(8);
+    const std::string_view tooLarge = "does not fit eight bytes";
+    client.send_to(std::as_bytes(std::span(tooLarge)), destination);
+    client.send_to(std::as_bytes(std::span(tooLarge)), destination);
+    client.send_to(std::as_bytes(std::span(std::string_view("fits"))), destination);
+    CHECK_THROWS_AS(server.recv_from(small), RecvError);
+    CHECK_THROWS_WITH(server.recv_from(small), Catch::Matchers::StartsWith("Received datagram is larger than the packet"));
+    CHECK(small.data.empty());
+    REQUIRE(server.recv_from(small) == 4);
+    CHECK(std::string(small.data.begin(), small.data.end()) == "fits");
+
+    CHECK_THROWS_MATCHES(
+        client.send_to(UDPPacket(std::vector<char>{ 'A' })),
+        SocketException,
+        Catch::Matchers::Message("Cannot send_to without an Endpoint")
+    );
+}
+
+TEST_CASE("Socket Vectored Send and Recv", "[Socket]") {
+    Socket listener(AddressFamily::IPv4, SocketType::TCP);
+    listener.enableAddressReuse(true);
+    listener.bind(Endpoint("127.0.0.1", 7773));
+    listener.listen(1);
+
+    Socket client(AddressFamily::IPv4, SocketType::TCP);
+    client.connect(Endpoint("127.0.0.1", 7773));
+    auto server = listener.accept();
+
+    SECTION("Header and payload") {
+        const std::string header = "HEAD";
+        const std::vector<char> payload = { 'b', 'o', 'd', 'y' };
+        REQUIRE(client.sendv({ header, payload, "!" }) == 9);
+
+        char head[4];
+        std::string body(5, '\0');
+        REQUIRE(server->recvv({ MutableBuffer(head, sizeof(head)), body }) == 9);
+        CHECK(std::string(head, 4) == header);
+        CHECK(body == "body!");
+    }
+
+    SECTION("More buffers than IOV_MAX") {
+        std::string data(3 * IOV_MAX, '\0');
+        for ( size_t i = 0; i < data.size(); i++ ) {
+            data[i] = static_cast<char>('a' + i % 26);
+        }
+        std::vector<iovec> iovecs;
+        for ( size_t i = 0; i < data.size(); i += 3 ) {
+            iovecs.push_back({ data.data() + i, 3 });
+        }
+
+        std::string received;
+        std::thread reader([&] {
+            std::byte buffer[4096];
+            while ( received.size() < data.size() ) {
+                ssize_t count = server->recv(buffer);
+                if ( count <= 0 ) break;
+                received.append(reinterpret_cast<const char*>(buffer), count);
+            }
+        });
+        CHECK(client.send(std::span<const iovec>(iovecs)) == static_cast<ssize_t>(data.size()));
+        reader.join();
+        CHECK(received == data);
+    }
+}
+
+TEST_CASE("Socket Vectored Datagrams", "[Socket]") {
+    Socket server(AddressFamily::IPv4, SocketType::UDP);
+    Socket client(AddressFamily::IPv4, SocketType::UDP);
+    server.enableAddressReuse(true);
+    server.bind(Endpoint("127.0.0.1", 7774));
+
+    REQUIRE(client.send_to(std::string_view("headpayload"), Endpoint("127.0.0.1", 7774)) == 11);
+    char head[4];
+    std::vector<char> payload(16);
+    REQUIRE(server.recvv({ MutableBuffer(head, sizeof(head)), payload }) == 11);
+    CHECK(std::string(head, 4) == "head");
+    CHECK(std::string(payload.data(), 7) == "payload");
+
+    std::vector<iovec> tooMany(IOV_MAX + 1, iovec{ head, 1 });
+    CHECK_THROWS_AS(client.send(std::span<const iovec>(tooMany)), SendError);
+}
+
+namespace {
+
+std::string receiveExactly(Socket& socket, size_t size) {
+    std::string received;
+    std::byte buffer[4096];
+    while ( received.size() < size ) {
+        ssize_t count = socket.recv(std::span(buffer, std::min(sizeof(buffer), size - received.size())));
+        if ( count <= 0 ) break;
+        received.append(reinterpret_cast<const char*>(buffer), count);
+    }
+    return received;
+}
+
+} // namespace
+
+TEST_CASE("Socket Zero-Copy Transfer", "[Socket]") {
+    Socket listener(AddressFamily::IPv4, SocketType::TCP);
+    listener.enableAddressReuse(true);
+    listener.bind(Endpoint("127.0.0.1", 7775));
+    listener.listen(2);
+
+    Socket client(AddressFamily::IPv4, SocketType::TCP);
+    client.connect(Endpoint("127.0.0.1", 7775));
+    auto server = listener.accept();
+
+    std::string data(200000, '\0');
+    for ( size_t i = 0; i < data.size(); i++ ) {
+        data[i] = static_cast<char>('a' + i % 26);
+    }
+
+    SECTION("sendFile") {
+        FILE* file = tmpfile();
+        REQUIRE(file != nullptr);
+        REQUIRE(fwrite(data.data(), 1, data.size(), file) == data.size());
+        fflush(file);
+
+        std::string received;
+        std::thread reader([&] { received = receiveExactly(*server, data.size() - 10); });
+        CHECK(client.sendFile(fileno(file), 10, data.size()) == static_cast<ssize_t>(data.size() - 10));
+        reader.join();
+        fclose(file);
+        CHECK(received == data.substr(10));
+    }
+
+    SECTION("spliceTo") {
+        Socket sink(AddressFamily::IPv4, SocketType::TCP);
+        sink.connect(Endpoint("127.0.0.1", 7775));
+        auto relayed = listener.accept();
+
+        std::string received;
+        std::thread reader([&] { received = receiveExactly(sink, data.size()); });
+        std::thread writer([&] { client.send(data); });
+
+        size_t moved = 0;
+        while ( moved < data.size() ) {
+            ssize_t count = server->spliceTo(*relayed, data.size() - moved);
+            REQUIRE(count > 0);
+            moved += count;
+        }
+        writer.join();
+        reader.join();
+        CHECK(received == data);
+
+        server->enableNonBlocking(true);
+        CHECK_THROWS_AS(server->spliceTo(*relayed, 100), RecvError);
+    }
+}
+
+TEST_CASE("Socket Zero-Copy Send", "[Socket]") {
+    Socket listener(AddressFamily::IPv4, SocketType::TCP);
+    listener.enableAddressReuse(true);
+    listener.bind(Endpoint("127.0.0.1", 7776));
+    listener.listen(1);
+
+    Socket client(AddressFamily::IPv4, SocketType::TCP);
+    client.connect(Endpoint("127.0.0.1", 7776));
+    auto server = listener.accept();
+
+    const std::vector<char> data(64 * 1024, 'z');
+    CHECK_THROWS_MATCHES(
+        client.sendZeroCopy(std::as_bytes(std::span(data))),
+        SocketException,
+        Catch::Matchers::Message("Cannot sendZeroCopy without enableZeroCopy")
+    );
+
+    try {
+        client.enableZeroCopy();
+    } catch ( const SocketException& ) {
+        WARN("kernel without SO_ZEROCOPY support");
+        return;
+    }
+    CHECK(client.isZeroCopy());
+
+    std::string received;
+    std::thread reader([&] { received = receiveExactly(*server, 2 * data.size()); });
+    ZeroCopySend first = client.sendZeroCopy(std::as_bytes(std::span(data)));
+    CHECK(first.id == 0);
+    size_t sent = first.sent;
+    uint32_t lastId = first.id;
+    while ( sent < 2 * data.size() ) {
+        ZeroCopySend next = client.sendZeroCopy(std::as_bytes(std::span(data)).subspan(sent % data.size()));
+        CHECK(next.id == lastId + 1);
+        lastId = next.id;
+        sent += next.sent;
+    }
+    reader.join();
+    CHECK(received.size() == 2 * data.size());
+
+    std::vector<bool> completed(lastId + 1, false);
+    for ( int i = 0; i < 100 && std::find(completed.begin(), completed.end(), false) != completed.end(); i++ ) {
+        client.readZeroCopyCompletions([&](const ZeroCopyCompletion& completion) {
+            for ( uint32_t id = completion.first; id <= completion.last; id++ ) {
+                completed.at(id) = true;
+            }
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    CHECK(std::find(completed.begin(), completed.end(), false) == completed.end());
+}
+
+TEST_CASE("Socket Recv Options", "[Socket]") {
+    Socket listener(AddressFamily::IPv4, SocketType::TCP);
+    listener.enableAddressReuse(true);
+    listener.bind(Endpoint("127.0.0.1", 7777));
+    listener.listen(1);
+
+    Socket client(AddressFamily::IPv4, SocketType::TCP);
+    client.connect(Endpoint("127.0.0.1", 7777));
+    auto server = listener.accept();
+
+    std::string data(100000, '\0');
+    for ( size_t i = 0; i < data.size(); i++ ) {
+        data[i] = static_cast<char>('a' + i % 26);
+    }
+
+    SECTION("Exact") {
+        std::thread writer([&] { client.send(data); });
+        RecvOptions options;
+        options.mode = RecvMode::Exact;
+        options.exactSize = data.size();
+        std::string received;
+        CHECK(server->recv(received, options) == static_cast<ssize_t>(data.size()));
+        writer.join();
+        CHECK(received == data);
+    }
+
+    SECTION("Until would-block with capacity reuse") {
+        REQUIRE(client.send(std::string_view(data).substr(0, 50000)) == 50000);
+        server->enableNonBlocking(true);
+
+        RecvOptions options;
+        options.mode = RecvMode::UntilWouldBlock;
+        options.chunkSize = 1024;
+        std::vector<char> buffer;
+        CHECK(server->recv(buffer, options) == 50000);
+        CHECK(std::string(buffer.begin(), buffer.end()) == data.substr(0, 50000));
+
+        const size_t capacity = buffer.capacity();
+        const char* storage = buffer.data();
+        REQUIRE(client.send(std::string_view("tail")) == 4);
+        CHECK(server->recv(buffer, options) == 4);
+        CHECK(std::string(buffer.begin(), buffer.end()) == "tail");
+        CHECK(buffer.capacity() == capacity);
+        CHECK(buffer.data() == storage);
+
+        CHECK_THROWS_AS(server->recv(buffer, options), RecvError);
+    }
+
+    SECTION("Once with a size limit") {
+        REQUIRE(client.send(std::string_view(data).substr(0, 10000)) == 10000);
+        RecvOptions options;
+        options.chunkSize = 512;
+        options.maxSize = 3000;
+        std::string received;
+        CHECK(server->recv(received, options) == 3000);
+        CHECK(received == data.substr(0, 3000));
+
+        CHECK(server->recv(received) == 7000);
+        CHECK(received == data.substr(3000, 7000));
+    }
+}
+
+TEST_CASE("Socket acceptMany", "[Socket]") {
+    Socket listener(AddressFamily::IPv4, SocketType::TCP);
+    listener.enableAddressReuse(true);
+    listener.bind(Endpoint("127.0.0.1", 7780));
+    listener.listen(16);
+    listener.enableNonBlocking(true);
+
+    std::vector<AcceptedConnection> connections(8);
+    CHECK(listener.acceptMany(connections) == 0);
+
+    std::vector<std::unique_ptr<Socket>> clients;
+    for ( int i = 0; i < 5; i++ ) {
+        clients.push_back(std::make_unique<Socket>(AddressFamily::IPv4, SocketType::TCP));
+        clients.back()->connect(Endpoint("127.0.0.1", 7780));
+    }
+
+    size_t accepted = 0;
+    for ( int attempt = 0; attempt < 100 && accepted < 5; attempt++ ) {
+        accepted += listener.acceptMany(std::span(connections).subspan(accepted));
+        if ( accepted < 5 ) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(accepted == 5);
+
+    for ( size_t i = 0; i < accepted; i++ ) {
+        CHECK(connections[i].fd != -1);
+        CHECK((fcntl(connections[i].fd, F_GETFL) & O_NONBLOCK) != 0);
+        CHECK((fcntl(connections[i].fd, F_GETFD) & FD_CLOEXEC) != 0);
+        CHECK(connections[i].endpoint.toString().starts_with("127.0.0.1:"));
+    }
+
+    Socket server(std::move(connections[0]));
+    CHECK(connections[0].fd == -1);
+    CHECK(server.mState == SocketState::Connected);
+    CHECK(server.isNonBlocking());
+    REQUIRE(clients[0]->send(std::string_view("ping")) == 4);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    std::string received;
+    CHECK(server.recv(received) == 4);
+    CHECK(received == "ping");
+
+    CHECK_THROWS_AS(Socket(std::move(connections[0])), SocketException);
+
+    SECTION("maxCount limits the batch") {
+        clients.push_back(std::make_unique<Socket>(AddressFamily::IPv4, SocketType::TCP));
+        clients.back()->connect(Endpoint("127.0.0.1", 7780));
+        clients.push_back(std::make_unique<Socket>(AddressFamily::IPv4, SocketType::TCP));
+        clients.back()->connect(Endpoint("127.0.0.1", 7780));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        CHECK(listener.acceptMany(connections, 1) == 1);
+        CHECK(listener.acceptMany(connections) == 1);
+    }
+
+    SECTION("Only listening TCP Sockets accept") {
+        Socket udp(AddressFamily::IPv4, SocketType::UDP);
+        CHECK_THROWS_AS(udp.acceptMany(connections), SocketException);
+        Socket tcp(AddressFamily::IPv4, SocketType::TCP);
+        CHECK_THROWS_AS(tcp.acceptMany(connections), SocketException);
+    }
+}
+
+TEST_CASE("Socket Move, Release and Adopt", "[Socket]") {
+    Socket listener(AddressFamily::IPv4, SocketType::TCP);
+    listener.enableAddressReuse(true);
+    listener.bind(Endpoint("127.0.0.1", 7781));
+    listener.listen(4);
+    const int fd = listener.getNativeHandle();
+
+    SECTION("Move construction transfers the descriptor") {
+        Socket moved(std::move(listener));
+        CHECK(moved.getNativeHandle() == fd);
+        CHECK(moved.getState() == SocketState::Listening);
+        CHECK(listener.getNativeHandle() == -1);
+        CHECK(listener.getState() == SocketState::Closed);
+        CHECK(fcntl(fd, F_GETFD) != -1);
+    }
+
+    SECTION("Move assignment closes the previous descriptor") {
+        Socket other(AddressFamily::IPv4, SocketType::UDP);
+        const int otherFd = other.getNativeHandle();
+        other = std::move(listener);
+        CHECK(other.getNativeHandle() == fd);
+        CHECK(other.mProtocol == SocketType::TCP);
+        CHECK(fcntl(otherFd, F_GETFD) == -1);
+    }
+
+    SECTION("Sockets can be stored by value") {
+        std::vector<Socket> sockets;
+        sockets.push_back(std::move(listener));
+        for ( int i = 0; i < 8; i++ ) {
+            sockets.emplace_back(AddressFamily::IPv4, SocketType::UDP);
+        }
+        CHECK(sockets.front().getNativeHandle() == fd);
+        CHECK(sockets.front().getState() == SocketState::Listening);
+    }
+
+    SECTION("Release and adopt") {
+        int released = listener.release();
+        CHECK(released == fd);
+        CHECK(listener.getNativeHandle() == -1);
+        CHECK(listener.getState() == SocketState::Closed);
+        CHECK(fcntl(fd, F_GETFD) != -1);
+
+        Socket adopted = Socket::adopt(released);
+        CHECK(adopted.getNativeHandle() == fd);
+        CHECK(adopted.mProtocol == SocketType::TCP);
+        CHECK(adopted.mAddressFamily == AddressFamily::IPv4);
+        CHECK(adopted.getState() == SocketState::Listening);
+        CHECK(adopted.mEndpoint->getPort() == 7781);
+        CHECK_FALSE(adopted.isNonBlocking());
+
+        Socket client(AddressFamily::IPv4, SocketType::TCP);
+        client.connect(Endpoint("127.0.0.1", 7781));
+        auto server = adopted.accept();
+        server->enableNonBlocking(true);
+
+        Socket connection = Socket::adopt(server->release());
+        CHECK(connection.getState() == SocketState::Connected);
+        CHECK(connection.isNonBlocking());
+        CHECK(connection.mEndpoint->toString().starts_with("127.0.0.1:"));
+        REQUIRE(client.send(std::string_view("ping")) == 4);
+        connection.enableNonBlocking(false);
+        std::string received;
+        CHECK(connection.recv(received) == 4);
+        CHECK(received == "ping");
+    }
+
+    SECTION("Adopting a non-socket descriptor fails") {
+        int pipeFds[2];
+        REQUIRE(pipe(pipeFds) == 0);
+        CHECK_THROWS_AS(Socket::adopt(pipeFds[0]), SocketException);
+        CHECK(fcntl(pipeFds[0], F_GETFD) != -1);
+        close(pipeFds[0]);
+        close(pipeFds[1]);
+    }
+}
+
+namespace {
+
+bool waitReadable(const Socket& socket) {
+    pollfd descriptor{ socket.getNativeHandle(), POLLIN, 0 };
+    return ::poll(&descriptor, 1, 1000) == 1;
+}
+
+} // namespace
+
+TEST_CASE("Socket Non-Throwing API", "[Socket]") {
+    Socket listener(AddressFamily::IPv4, SocketType::TCP);
+    listener.enableAddressReuse(true);
+    listener.bind(Endpoint("127.0.0.1", 7782));
+    listener.listen(4);
+    listener.enableNonBlocking(true);
+
+    IOResult<Socket> none = listener.try_accept();
+    CHECK_FALSE(none);
+    CHECK(none.wouldBlock());
+    CHECK_THROWS_AS(none.value(), SocketException);
+
+    Socket client(AddressFamily::IPv4, SocketType::TCP);
+    client.connect(Endpoint("127.0.0.1", 7782));
+
+    REQUIRE(waitReadable(listener));
+    IOResult<Socket> accepted = listener.try_accept();
+    REQUIRE(accepted.ok());
+    Socket server = std::move(accepted).value();
+    CHECK(server.getState() == SocketState::Connected);
+    CHECK(server.isNonBlocking());
+
+    std::byte buffer[16];
+    IOResult<size_t> empty = server.try_recv(buffer);
+    CHECK(empty.wouldBlock());
+    CHECK(empty.error() == std::errc::resource_unavailable_try_again);
+    CHECK(empty.value_or(42) == 42);
+
+    IOResult<size_t> sent = client.try_send(std::string_view("ping"));
+    REQUIRE(sent.ok());
+    CHECK(*sent == 4);
+    REQUIRE(waitReadable(server));
+
+    IOResult<size_t> received = server.try_recv(buffer);
+    REQUIRE(received);
+    CHECK(received.value() == 4);
+    CHECK(std::string(reinterpret_cast<const char*>(buffer), 4) == "ping");
+
+    close(client.release());
+    REQUIRE(waitReadable(server));
+    IOResult<size_t> closed = server.try_recv(buffer);
+    REQUIRE(closed.ok());
+    CHECK(*closed == 0);
+
+    // the peer is gone, sending fails with an error instead of SIGPIPE
+    IOResult<size_t> broken = server.try_send(std::string_view("pong"));
+    for ( int attempt = 0; attempt < 100 && broken.ok(); attempt++ ) {
+        waitReadable(server);
+        broken = server.try_send(std::string_view("pong"));
+    }
+    REQUIRE_FALSE(broken.ok());
+    CHECK((broken.error() == std::errc::broken_pipe || broken.error() == std::errc::connection_reset));
+
+    Socket udp(AddressFamily::IPv4, SocketType::UDP);
+    IOResult<Socket> invalid = udp.try_accept();
+    CHECK_FALSE(invalid.ok());
+    CHECK(invalid.error() == std::errc::invalid_argument);
+}
+
+TEST_CASE("Socket Unix Domain", "[Socket]") {
+    SECTION("Stream over an abstract address") {
+        const Endpoint endpoint = Endpoint::unixAbstract("socketsparrow-test-stream");
+        Socket listener(AddressFamily::Unix, SocketType::Stream);
+        listener.bind(endpoint);
+        listener.listen(4);
+
+        Socket client(AddressFamily::Unix, SocketType::Stream);
+        client.connect(endpoint);
+        auto server = listener.accept();
+        CHECK(server->getState() == SocketState::Connected);
+        CHECK(server->mEndpoint->toString() == "unnamed");
+
+        REQUIRE(client.send(std::string_view("local")) == 5);
+        std::string received;
+        CHECK(server->recv(received) == 5);
+        CHECK(received == "local");
+
+        PeerCredentials credentials = server->peerCredentials();
+        CHECK(credentials.pid == getpid());
+        CHECK(credentials.uid == geteuid());
+        CHECK(credentials.gid == getegid());
+    }
+
+    SECTION("SeqPacket over a filesystem path") {
+        char directory[] = "/tmp/socketsparrow-XXXXXX";
+        REQUIRE(mkdtemp(directory) != nullptr);
+        const std::string path = std::string(directory) + "/seqpacket.sock";
+        const Endpoint endpoint = Endpoint::unixPath(path);
+
+        Socket listener(AddressFamily::Unix, SocketType::SeqPacket);
+        listener.bind(endpoint);
+        listener.listen(4);
+        listener.enableNonBlocking(true);
+
+        Socket client(AddressFamily::Unix, SocketType::SeqPacket);
+        client.connect(endpoint);
+
+        std::vector<AcceptedConnection> connections(2);
+        REQUIRE(listener.acceptMany(connections) == 1);
+        Socket server(std::move(connections[0]));
+        CHECK(server.mProtocol == SocketType::SeqPacket);
+
+        // message boundaries are kept
+        REQUIRE(client.send(std::string_view("first")) == 5);
+        REQUIRE(client.send(std::string_view("second")) == 6);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::byte buffer[64];
+        CHECK(server.recv(buffer) == 5);
+        CHECK(server.recv(buffer) == 6);
+
+        Socket adopted = Socket::adopt(listener.release());
+        CHECK(adopted.mAddressFamily == AddressFamily::Unix);
+        CHECK(adopted.mProtocol == SocketType::SeqPacket);
+        CHECK(adopted.getState() == SocketState::Listening);
+        CHECK(adopted.mEndpoint->getPath() == path);
+
+        unlink(path.c_str());
+        rmdir(directory);
+    }
+
+    SECTION("Datagrams") {
+        const Endpoint endpoint = Endpoint::unixAbstract("socketsparrow-test-dgram");
+        Socket server(AddressFamily::Unix, SocketType::Datagram);
+        server.bind(endpoint);
+        Socket client(AddressFamily::Unix, SocketType::Datagram);
+
+        REQUIRE(client.send_to(std::string_view("datagram"), endpoint) == 8);
+        UDPPacket packet = server.recv_from();
+        CHECK(std::string(packet.data.begin(), packet.data.end()) == "datagram");
+        CHECK_FALSE(packet.endpoint.isSpecified());
+    }
+
+    SECTION("Socket pairs") {
+        auto [left, right] = Socket::pair();
+        CHECK(left.getState() == SocketState::Connected);
+        CHECK(left.mAddressFamily == AddressFamily::Unix);
+        CHECK((fcntl(left.getNativeHandle(), F_GETFD) & FD_CLOEXEC) != 0);
+
+        REQUIRE(left.send(std::string_view("ping")) == 4);
+        std::string received;
+        CHECK(right.recv(received) == 4);
+        CHECK(received == "ping");
+        CHECK(right.peerCredentials().pid == getpid());
+
+        auto [first, second] = Socket::pair(SocketType::SeqPacket);
+        REQUIRE(first.send(std::string_view("a")) == 1);
+        REQUIRE(first.send(std::string_view("bc")) == 2);
+        std::byte buffer[8];
+        CHECK(second.recv(buffer) == 1);
+        CHECK(second.recv(buffer) == 2);
+    }
+
+    SECTION("Datagram Sockets cannot connect or listen") {
+        Socket datagram(AddressFamily::Unix, SocketType::Datagram);
+        CHECK_THROWS_AS(datagram.listen(1), SocketException);
+
+        Socket tcp(AddressFamily::IPv4, SocketType::TCP);
+        CHECK_THROWS_AS(tcp.peerCredentials(), SocketException);
+    }
+}
+
+TEST_CASE("Socket Descriptor Passing", "[Socket]") {
+    auto [left, right] = Socket::pair(SocketType::SeqPacket);
+
+    int pipeFds[2];
+    REQUIRE(pipe(pipeFds) == 0);
+    CHECK(left.sendFds(pipeFds, std::as_bytes(std::span("pipe", 4))) == 4);
+    close(pipeFds[0]);
+
+    std::byte buffer[16];
+    std::vector<int> fds;
+    CHECK(right.recvFds(buffer, fds) == 4);
+    REQUIRE(fds.size() == 2);
+    CHECK((fcntl(fds[0], F_GETFD) & FD_CLOEXEC) != 0);
+
+    // the passed read end still belongs to the pipe
+    REQUIRE(write(pipeFds[1], "x", 1) == 1);
+    char byte = 0;
+    CHECK(read(fds[0], &byte, 1) == 1);
+    CHECK(byte == 'x');
+
+    SECTION("Empty payloads send a placeholder byte") {
+        CHECK(left.sendFds(std::span(fds.data(), 1)) == 1);
+        std::vector<int> more;
+        CHECK(right.recvFds(buffer, more) == 1);
+        CHECK(more.size() == 1);
+        close(more[0]);
+    }
+
+    SECTION("Only Unix Domain Sockets pass descriptors") {
+        Socket udp(AddressFamily::IPv4, SocketType::UDP);
+        CHECK_THROWS_AS(udp.sendFds(fds), SocketException);
+        CHECK_THROWS_AS(udp.recvFds(buffer, fds), SocketException);
+        CHECK_THROWS_AS(right.recvFds(std::span<std::byte>(), fds), SocketException);
+    }
+
+    for ( int fd : fds ) {
+        close(fd);
+    }
+    close(pipeFds[1]);
+}
+
+TEST_CASE("Socket Segmentation Offload", "[Socket]") {
+    Socket receiver(SocketSparrow::AddressFamily::IPv4, SocketSparrow::SocketType::UDP);
+    Socket sender(SocketSparrow::AddressFamily::IPv4, SocketSparrow::SocketType::UDP);
+    receiver.enableAddressReuse(true);
+    receiver.bind(Endpoint("127.0.0.1", 7787));
+    Endpoint destination("127.0.0.1", 7787);
+
+    // four full segments and a short one, every segment filled with its index
+    std::vector<char> payload(4 * 1000 + 10);
+    for ( size_t i = 0; i < payload.size(); i++ ) {
+        payload[i] = static_cast<char>('a' + i / 1000);
+    }
+
+    // collect the datagrams, however the kernel grouped them
+    auto receiveSegments = [&receiver](size_t bytes) {
+        std::vector<std::string> segments;
+        UDPPacket packet;
+        for ( size_t received = 0; received < bytes; ) {
+            received += receiver.recv_from(packet);
+            for ( size_t i = 0; i < packet.segmentCount(); i++ ) {
+                std::span<const char> segment = packet.segment(i);
+                segments.emplace_back(segment.begin(), segment.end());
+            }
+        }
+        return segments;
+    };
+
+    SECTION("Without GRO every datagram arrives on its own") {
+        CHECK(sender.send_to(std::as_bytes(std::span(payload)), destination, 1000) == static_cast<ssize_t>(payload.size()));
+
+        std::vector<std::string> segments = receiveSegments(payload.size());
+        REQUIRE(segments.size() == 5);
+        for ( size_t i = 0; i < 4; i++ ) {
+            CHECK(segments[i] == std::string(1000, static_cast<char>('a' + i)));
+        }
+        CHECK(segments[4] == std::string(10, 'e'));
+    }
+
+    SECTION("With GRO the datagrams may arrive coalesced") {
+        receiver.enableGro();
+        UDPPacket packet(payload, destination);
+        packet.segmentSize = 1000;
+        CHECK(packet.segmentCount() == 5);
+        CHECK(packet.segment(4).size() == 10);
+        CHECK_THROWS_MATCHES(
+            packet.segment(5),
+            SocketException,
+            Catch::Matchers::Message("UDPPacket segment index out of range")
+        );
+        CHECK_THROWS_AS(UDPPacket(0).segment(0), SocketException);
+        CHECK(sender.send_to(packet) == static_cast<ssize_t>(payload.size()));
+
+        std::vector<std::string> segments = receiveSegments(payload.size());
+        REQUIRE(segments.size() == 5);
+        CHECK(segments[3] == std::string(1000, 'd'));
+        CHECK(segments[4] == std::string(10, 'e'));
+    }
+
+    SECTION("A default segment size applies to every send") {
+        sender.setSegmentSize(2000);
+        sender.send_to(std::as_bytes(std::span(payload)), destination);
+        std::vector<std::string> segments = receiveSegments(payload.size());
+        CHECK(segments.size() == 3);
+        CHECK(segments[2].size() == 10);
+    }
+
+    Socket tcp(SocketSparrow::AddressFamily::IPv4, SocketSparrow::SocketType::TCP);
+    CHECK_THROWS_AS(tcp.enableGro(), SocketException);
+    CHECK_THROWS_AS(tcp.setSegmentSize(1000), SocketException);
+}
@@ -9,7 +9,8 @@ TEST_CASE("Test Utils", "[Utils]") {
         CHECK(getAddressFamily("AF_INET") == AddressFamily::IPv4);
         CHECK(getAddressFamily("AF_INET6") == AddressFamily::IPv6);
         CHECK(getAddressFamily("AF_UNSPEC") == AddressFamily::Unknown);
-        CHECK(getAddressFamily("AF_UNIX") == AddressFamily::Unknown);
+        CHECK(getAddressFamily("AF_UNIX") == AddressFamily::Unix);
+        CHECK(getAddressFamily("AF_LOCAL") == AddressFamily::Unix);
         CHECK(getAddressFamily("AF_APPLETALK") == AddressFamily::Unknown);
         CHECK(getAddressFamily("AF_PACKET") == AddressFamily::Unknown);
         CHECK(getNativeAddressFamily(AddressFamily::IPv4) == AF_INET);
@@ -18,9 +19,11 @@ TEST_CASE("Test Utils", "[Utils]") {
         CHECK(getAddressFamily(AF_INET) == AddressFamily::IPv4);
         CHECK(getAddressFamily(AF_INET6) == AddressFamily::IPv6);
         CHECK(getAddressFamily(AF_UNSPEC) == AddressFamily::Unknown);
+        CHECK(getAddressFamily(AF_UNIX) == AddressFamily::Unix);
 
         CHECK(getAddressFamilyString(AddressFamily::IPv4) == "AF_INET");
         CHECK(getAddressFamilyString(AddressFamily::IPv6) == "AF_INET6");
+        CHECK(getAddressFamilyString(AddressFamily::Unix) == "AF_UNIX");
         CHECK(getAddressFamilyString(AddressFamily::Unknown) == "AF_UNSPEC");
         CHECK(getAddressFamilyString(static_cast<AddressFamily>(331)) == "AF_UNSPEC");
 
@@ -33,10 +36,12 @@ TEST_CASE("Test Utils", "[Utils]") {
         CHECK(getSocketType("SOCK_STREAM") == SocketType::TCP);
         CHECK(getSocketType("UDP") == SocketType::UDP);
         CHECK(getSocketType("SOCK_DGRAM") == SocketType::UDP);
+        CHECK(getSocketType("SOCK_SEQPACKET") == SocketType::SeqPacket);
         CHECK(getSocketType("SOCK_RAW") == SocketType::Unknown);
         CHECK(getSocketType("Unknown") == SocketType::Unknown);
         CHECK(getSocketType(SOCK_STREAM) == SocketType::TCP);
         CHECK(getSocketType(SOCK_DGRAM) == SocketType::UDP);
+        CHECK(getSocketType(SOCK_SEQPACKET) == SocketType::SeqPacket);
         CHECK(getSocketType(SOCK_RAW) == SocketType::Unknown);
         CHECK(getNativeSocketType(SocketType::TCP) == SOCK_STREAM);
         CHECK(getNativeSocketType(SocketType::Stream) == SOCK_STREAM);
@@ -48,6 +53,7 @@ TEST_CASE("Test Utils", "[Utils]") {
         CHECK(getSocketTypeString(SocketType::Stream) == "TCP");
         CHECK(getSocketTypeString(SocketType::UDP) == "UDP");
         CHECK(getSocketTypeString(SocketType::Datagram) == "UDP");
+        CHECK(getSocketTypeString(SocketType::SeqPacket) == "SeqPacket");
         CHECK(getSocketTypeString(SocketType::Unknown) == "SOCK_RAW");
         CHECK(getSocketTypeString(static_cast<SocketType>(331)) == "SOCK_RAW");
 